@@ -37,9 +37,14 @@
 //#define ONLY_CONNECT_EVENT_REQUIRED         // Disables reorientation, redraw and SensorChange events
 //#define BD_USE_SIMPLE_SERIAL                // Do not use the Serial object. Saves up to 1250 bytes program memory and 185 bytes RAM, if Serial is not used otherwise
 //#define BD_USE_USB_SERIAL                   // Activate it, if you want to force using Serial instead of Serial1 for direct USB cable connection* to your smartphone / tablet.
+#define BD_USE_TASK_SCHEDULER               // Blink task is run by checkAndHandleEvents()
 #include "BlueDisplay.hpp"
 
+#define BLINK_PERIOD_MILLIS 300
+
 bool doBlink = true;
+bool sLEDIsOn = false;
+void doBlinkTask(void);
 
 /*
  * The Start Stop button
@@ -82,6 +87,8 @@ void setup() {
      */
     BlueDisplay1.initCommunication(&Serial, &initDisplay, &drawGui); // introduces up to 1.5 seconds delay
 
+    registerPeriodicTask(&doBlinkTask, BLINK_PERIOD_MILLIS);
+
 #if defined(BD_USE_SERIAL1) || defined(ESP32) // BD_USE_SERIAL1 may be defined in BlueSerial.h
 // Serial(0) is available for Serial.print output.
 #  if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
@@ -104,27 +111,23 @@ void setup() {
 }
 
 void loop() {
-
     /*
-     * This debug output can also be recognized at the Arduino Serial Monitor
+     * Handles the events and runs doBlinkTask() if it is due
      */
-//    BlueDisplay1.debug("\r\nDoBlink=", (uint8_t) doBlink);
-    if (doBlink) {
-        // LED on
-        digitalWrite(LED_BUILTIN, HIGH);
-        BlueDisplay1.fillCircle(DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2, 20, COLOR16_RED);
-        delayMillisWithCheckAndHandleEvents(300);
-    }
+    checkAndHandleEvents();
+}
 
-    if (doBlink) {
-        // LED off
-        digitalWrite(LED_BUILTIN, LOW);
+/*
+ * Periodic task, which toggles the LED and the circle
+ */
+void doBlinkTask(void) {
+    sLEDIsOn = !sLEDIsOn;
+    digitalWrite(LED_BUILTIN, sLEDIsOn);
+    if (sLEDIsOn) {
+        BlueDisplay1.fillCircle(DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2, 20, COLOR16_RED);
+    } else {
         BlueDisplay1.fillCircle(DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2, 20, COLOR16_BLUE);
-        delayMillisWithCheckAndHandleEvents(300);
     }
-
-    // To get blink enable event
-    checkAndHandleEvents();
 }
 
 /*
@@ -159,6 +162,11 @@ void drawGui(void) {
  */
 void doBlinkStartStop(BDButton *aTheTouchedButton __attribute__((unused)), int16_t aValue) {
     doBlink = aValue;
+    if (doBlink) {
+        registerPeriodicTask(&doBlinkTask, BLINK_PERIOD_MILLIS);
+    } else {
+        removeTask(&doBlinkTask);
+    }
     /*
      * This debug output can also be recognized at the Arduino Serial Monitor
      */
@@ -80,8 +80,11 @@ BDButton TouchButton4days;
 BDButton TouchButton2days;
 BDButton TouchButton1day;
 BDButton TouchButton12Hour;
+#if defined(USE_CO2_AGGREGATION_TIERS)
+BDButton TouchButton8days;
+BDButton TouchButton32days;
+#endif
 BDButton TouchButtonBrightness;
-BDButton TouchButtonStoreToEEPROM;
 BDButton TouchButtonShowTimeToNextStorage; // overlay for time text, not drawn, only activated
 
 void initDisplay(void);
@@ -125,22 +128,105 @@ uint16_t sChartHoursToDisplay __attribute__((section(".noinit")));  // is initia
 uint8_t *sCO2ArrayDisplayStart = sCO2Array; // Start of displayed values determined by doDays()
 uint16_t sCO2MinimumOfCurrentReadings; // the minimum of all values received during one period
 
+/*
+ * Aggregation tiers for the 8 and 32 days charts
+ * The 5 minute values of sCO2Array are aggregated to hourly and daily minimum, average and maximum values,
+ * each time writeToCO2Array() is called. The newest bucket of a tier contains the values of the current clock hour or day,
+ * so buckets are aligned to the X labels. Hours or days without any value, e.g. while powered off, give empty (0) buckets.
+ * The tiers are not in .noinit, they are rebuilt from the EEPROM log (or sCO2Array) at boot and after receiving the time.
+ * For rebuilding, the stored values are assumed to be contiguous and the newest one to be stored now.
+ * They require 672 bytes RAM, which are not available on an ATmega328.
+ */
+#if !defined(USE_CO2_AGGREGATION_TIERS) && !defined(DO_NOT_USE_CO2_AGGREGATION_TIERS) && (!defined(__AVR__) || RAMEND > 0x8FF)
+#define USE_CO2_AGGREGATION_TIERS
+#endif
+#if defined(USE_CO2_AGGREGATION_TIERS)
+#define NUMBER_OF_DAYS_IN_HOURLY_TIER   8
+#define NUMBER_OF_DAYS_IN_DAILY_TIER    32
+#define CO2_HOURLY_TIER_SIZE            (NUMBER_OF_DAYS_IN_HOURLY_TIER * HOURS_IN_ONE_DAY)  // 192 -> chart expansion 3
+#define CO2_DAILY_TIER_SIZE             NUMBER_OF_DAYS_IN_DAILY_TIER                        // 32 -> chart expansion 18
+
+#define CO2_TIER_MINIMUM    0 // Index of rows of a tier array
+#define CO2_TIER_AVERAGE    1
+#define CO2_TIER_MAXIMUM    2
+#define CO2_TIER_NUMBER_OF_ROWS 3
+uint8_t sCO2HourlyTier[CO2_TIER_NUMBER_OF_ROWS][CO2_HOURLY_TIER_SIZE];
+uint8_t sCO2DailyTier[CO2_TIER_NUMBER_OF_ROWS][CO2_DAILY_TIER_SIZE];
+
+struct CO2TierAccumulatorStruct {
+    uint32_t BucketNumber;      // Timestamp of the newest bucket divided by seconds per bucket, i.e. hours or days since 1970
+    uint32_t Sum;               // Sum of the values of the newest bucket
+    uint16_t NumberOfValues;    // Number of values in the newest bucket
+};
+CO2TierAccumulatorStruct sCO2HourlyAccumulator;
+CO2TierAccumulatorStruct sCO2DailyAccumulator;
+
+#define CO2_CHART_SOURCE_RAW    0 // Values for sCO2ChartSource
+#define CO2_CHART_SOURCE_HOURLY 1
+#define CO2_CHART_SOURCE_DAILY  2
+uint8_t sCO2ChartSource = CO2_CHART_SOURCE_RAW; // Array used for chart determined by doDays()
+#define CHART_MIN_MAX_COLOR     COLOR16_ORANGE
+
+time_t sCO2TierRebuildTimestamp; // Timestamp of the next value for addRebuildValueToCO2Tiers()
+bool sCO2TiersAreRebuiltWithHostTime = false;
+void initializeCO2Tiers();
+void addToCO2Tiers(uint8_t aCO2Value);
+void addRebuildValueToCO2Tiers(uint8_t aCO2Value);
+#endif
+
 /*
  * CO2 storage in EEPROM
+ * Each value written to sCO2Array is appended to a circular log, so no bulk store is required.
+ * The log consists of blocks of 32 bytes. The first byte is a sequence number, the other 31 bytes contain 62 nibbles of codes.
+ * The block with the oldest data is overwritten if the log is full, so all EEPROM cells are written equally often.
+ * Codes:
+ * 0x0          Absolute value follows as 2 nibbles, high nibble first. Always used for the first value in a block.
+ * 0x1 to 0xD   Delta of -6 to +6 to the previous value, 0x7 is the same value.
+ * 0xE          Repeat previous value, the next nibble n gives n + 2 repetitions.
+ *              If n is 0xF (not yet written), it is one repetition.
+ * 0xF          Erased, end of data in this block.
+ * CO2 changes seldom more than 30 ppm in 5 minutes, so a value requires mostly 1 nibble
+ * and stable periods e.g. at night require 2 nibbles for up to 16 values.
+ * For 1024 bytes EEPROM, the log holds at least 1860 values (6.4 days) if no delta exceeds +/-6.
+ * The log is created (and an old EEPROM content is erased) at the first boot with a new CO2_LOG_FORMAT_VERSION.
  */
 #if defined(E2END) // 1023 for Atmega328
-#  if CO2_ARRAY_SIZE < E2END
-// If CO2_ARRAY_SIZE is smaller than E2END, than EEPROM Array can overwrite more than sCO2Array (and loop forever due to lazy programming ;-)
-#define EEPROM_CO2_ARRAY_SIZE   CO2_ARRAY_SIZE
-#else
 #  if defined(EEPROM_REQUIRED_FOR_APPLICATION_BYTES)
-#define EEPROM_CO2_ARRAY_SIZE   ((E2END + 1) - EEPROM_REQUIRED_FOR_APPLICATION_BYTES)
+#define EEPROM_CO2_LOG_SIZE     ((E2END + 1) - 1 - EEPROM_REQUIRED_FOR_APPLICATION_BYTES) // - 1 for format version
 #  else
-#define EEPROM_CO2_ARRAY_SIZE   (E2END + 1)
+#define EEPROM_CO2_LOG_SIZE     (E2END)
 #  endif
-#endif
-EEMEM uint8_t sCO2ArrayInEEPROM[EEPROM_CO2_ARRAY_SIZE];
-void doStoreInEEPROM(BDButton *aTheTouchedButton, int16_t aValue);
+#define CO2_LOG_BLOCK_SIZE          32
+#define CO2_LOG_NIBBLES_PER_BLOCK   ((CO2_LOG_BLOCK_SIZE - 1) * 2)              // 62
+#define CO2_LOG_NUMBER_OF_BLOCKS    (EEPROM_CO2_LOG_SIZE / CO2_LOG_BLOCK_SIZE)  // 31 for 1024 bytes EEPROM
+#define CO2_LOG_ERASED_BYTE         0xFF // Sequence number 0xFF marks an erased block
+#define CO2_LOG_FORMAT_VERSION      1
+
+#define CO2_LOG_CODE_ABSOLUTE       0x0
+#define CO2_LOG_CODE_DELTA_ZERO     0x7
+#define CO2_LOG_MAX_DELTA           6
+#define CO2_LOG_CODE_REPEAT         0xE
+#define CO2_LOG_CODE_ERASED         0xF
+#define CO2_LOG_MAX_REPEAT_NIBBLE   0xE // 16 repetitions
+#define CO2_LOG_NO_INDEX            0xFF
+
+EEMEM uint8_t sCO2LogFormatVersionInEEPROM;
+EEMEM uint8_t sCO2LogInEEPROM[CO2_LOG_NUMBER_OF_BLOCKS][CO2_LOG_BLOCK_SIZE];
+
+struct CO2LogStateStruct {
+    uint8_t BlockIndex;             // Newest block, which is currently written
+    uint8_t NextNibbleIndex;        // Index of the next free nibble in the block
+    uint8_t LastCodeNibbleIndex;    // Index of the last code if it is CO2_LOG_CODE_DELTA_ZERO or CO2_LOG_CODE_REPEAT, else CO2_LOG_NO_INDEX
+    uint8_t LastValue;
+    bool isEmpty;
+} sCO2LogState;
+
+void initCO2Log();
+void appendToCO2Log(uint8_t aCO2Value);
+uint16_t readCO2Log(void (*aValueHandler)(uint8_t aCO2Value));
+uint8_t *sCO2LogDestinationPointer; // for storeCO2LogValueInArray()
+uint16_t sCO2LogValuesToSkip;
+void storeCO2LogValueInArray(uint8_t aCO2Value);
 #endif
 
 void initializeCO2Array();
@@ -190,6 +276,9 @@ void InitCo2LoggerAndChart() {
      * Here the initDisplay() is delayed and called by the loop().
      */
     BlueDisplay1.initCommunication(&Serial, &signalInitDisplay); // introduces up to 1.5 seconds delay
+#if defined(E2END)
+    initCO2Log();
+#endif
     initializeCO2Array();
     sCO2MinimumOfCurrentReadings = __UINT16_MAX__;
 
@@ -300,24 +389,22 @@ void initializeCO2Array() {
 #endif
 
 #if defined(E2END)
-        uint16_t tSourceOffset = CO2_ARRAY_SIZE - sizeof(sCO2ArrayInEEPROM); // store only the most recent values
-        // Fill the start of array with zero
-        for (uint16_t i = 0; i < tSourceOffset; ++i) {
-            sCO2Array[i] = 0;
-        }
         /*
-         * Now copy EEPROM content to remainder of array
+         * Copy the most recent values of the EEPROM log to the end of the array and fill the start of array with zero
          */
-        if (eeprom_read_byte(&sCO2ArrayInEEPROM[sizeof(sCO2ArrayInEEPROM) - 1]) == 0xFF) {
-            /*
-             * Found an unused EEPROM (at first running this program on this CPU) -> clear it to zero
-             */
-//            Serial.println(F("Clear EEPROM to 0")); // this can hardly be observed
-            for (unsigned int i = 0; i < CO2_ARRAY_SIZE; ++i) {
-                eeprom_update_byte((uint8_t*) &sCO2ArrayInEEPROM[i], 0x00);
-            }
+        uint16_t tNumberOfLogValues = readCO2Log(nullptr);
+        uint16_t tDestinationOffset = 0;
+        sCO2LogValuesToSkip = 0;
+        if (tNumberOfLogValues > CO2_ARRAY_SIZE) {
+            sCO2LogValuesToSkip = tNumberOfLogValues - CO2_ARRAY_SIZE;
+        } else {
+            tDestinationOffset = CO2_ARRAY_SIZE - tNumberOfLogValues;
+        }
+        for (uint16_t i = 0; i < tDestinationOffset; ++i) {
+            sCO2Array[i] = 0;
         }
-        eeprom_read_block(&sCO2Array[tSourceOffset], sCO2ArrayInEEPROM, sizeof(sCO2ArrayInEEPROM));
+        sCO2LogDestinationPointer = &sCO2Array[tDestinationOffset];
+        readCO2Log(&storeCO2LogValueInArray);
 
         tCO2ArrayChecksum = 0;
         for (uint16_t i = 0; i < CO2_ARRAY_SIZE; ++i) {
@@ -341,6 +428,9 @@ void initializeCO2Array() {
 #endif
         sCO2ArrayValuesChecksum = tCO2ArrayChecksum;
     }
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    initializeCO2Tiers();
+#endif
 }
 
 /*
@@ -359,6 +449,12 @@ void writeToCO2Array(uint8_t aCO2Value) {
     }
     sCO2Array[CO2_ARRAY_SIZE - 1] = aCO2Value;
     sCO2ArrayValuesChecksum += aCO2Value; // adjust checksum with new element
+#if defined(E2END)
+    appendToCO2Log(aCO2Value);
+#endif
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    addToCO2Tiers(aCO2Value);
+#endif
 #if defined(LOCAL_DEBUG)
     Serial.print(F("Write "));
     Serial.print(aCO2Value);
@@ -370,6 +466,375 @@ void writeToCO2Array(uint8_t aCO2Value) {
 #endif
 }
 
+#if defined(USE_CO2_AGGREGATION_TIERS)
+/*
+ * Adds value to the newest bucket of the tier.
+ * If aTimestamp is not in the clock hour or day of the newest bucket, all rows are shifted to front
+ * by the number of elapsed buckets and a new bucket is started.
+ * @param aTierArray - Array of CO2_TIER_NUMBER_OF_ROWS rows with aTierSize values
+ */
+void addToCO2Tier(uint8_t *aTierArray, uint16_t aTierSize, CO2TierAccumulatorStruct *aAccumulator, uint32_t aSecondsPerBucket,
+        time_t aTimestamp, uint8_t aCO2Value) {
+    uint32_t tBucketNumber = aTimestamp / aSecondsPerBucket;
+    if (aAccumulator->NumberOfValues > 0 && tBucketNumber != aAccumulator->BucketNumber) {
+        uint32_t tElapsedBuckets = tBucketNumber - aAccumulator->BucketNumber;
+        if (tBucketNumber < aAccumulator->BucketNumber) {
+            tElapsedBuckets = 1; // Clock was set back
+        } else if (tElapsedBuckets > aTierSize) {
+            tElapsedBuckets = aTierSize;
+        }
+        for (uint_fast8_t tRow = 0; tRow < CO2_TIER_NUMBER_OF_ROWS; ++tRow) {
+            uint8_t *tRowStart = &aTierArray[tRow * aTierSize];
+            for (uint16_t i = 0; i < aTierSize - tElapsedBuckets; ++i) {
+                tRowStart[i] = tRowStart[i + tElapsedBuckets];
+            }
+            // Buckets without values
+            for (uint16_t i = aTierSize - tElapsedBuckets; i < aTierSize; ++i) {
+                tRowStart[i] = 0;
+            }
+        }
+        aAccumulator->Sum = 0;
+        aAccumulator->NumberOfValues = 0;
+    }
+    aAccumulator->BucketNumber = tBucketNumber;
+
+    uint8_t *tMinimum = &aTierArray[(CO2_TIER_MINIMUM * aTierSize) + aTierSize - 1];
+    uint8_t *tMaximum = &aTierArray[(CO2_TIER_MAXIMUM * aTierSize) + aTierSize - 1];
+    if (aAccumulator->NumberOfValues == 0 || aCO2Value < *tMinimum) {
+        *tMinimum = aCO2Value;
+    }
+    if (aAccumulator->NumberOfValues == 0 || aCO2Value > *tMaximum) {
+        *tMaximum = aCO2Value;
+    }
+    aAccumulator->Sum += aCO2Value;
+    aAccumulator->NumberOfValues++;
+    aTierArray[(CO2_TIER_AVERAGE * aTierSize) + aTierSize - 1] = (aAccumulator->Sum + (aAccumulator->NumberOfValues / 2))
+            / aAccumulator->NumberOfValues;
+}
+
+void addToCO2TiersWithTimestamp(uint8_t aCO2Value, time_t aTimestamp) {
+    addToCO2Tier(&sCO2HourlyTier[0][0], CO2_HOURLY_TIER_SIZE, &sCO2HourlyAccumulator, SECONDS_IN_ONE_HOUR, aTimestamp, aCO2Value);
+    addToCO2Tier(&sCO2DailyTier[0][0], CO2_DAILY_TIER_SIZE, &sCO2DailyAccumulator, SECONDS_IN_ONE_DAY, aTimestamp, aCO2Value);
+}
+
+/*
+ * aCO2Value is (CO2[ppm] - 400) / 5
+ */
+void addToCO2Tiers(uint8_t aCO2Value) {
+    addToCO2TiersWithTimestamp(aCO2Value, now());
+}
+
+/*
+ * Value handler for readCO2Log() at rebuild of tiers
+ */
+void addRebuildValueToCO2Tiers(uint8_t aCO2Value) {
+    addToCO2TiersWithTimestamp(aCO2Value, sCO2TierRebuildTimestamp);
+    sCO2TierRebuildTimestamp += STORAGE_INTERVAL_SECONDS;
+}
+
+/*
+ * Rebuild tiers from all values available, which are more than in sCO2Array if we have the EEPROM log
+ */
+void initializeCO2Tiers() {
+    memset(sCO2HourlyTier, 0, sizeof(sCO2HourlyTier));
+    memset(sCO2DailyTier, 0, sizeof(sCO2DailyTier));
+    sCO2HourlyAccumulator.NumberOfValues = 0;
+    sCO2DailyAccumulator.NumberOfValues = 0;
+#  if defined(E2END)
+    uint16_t tNumberOfValues = readCO2Log(nullptr);
+#  else
+    uint16_t tNumberOfValues = CO2_ARRAY_SIZE;
+#  endif
+    if (tNumberOfValues == 0) {
+        return;
+    }
+    sCO2TierRebuildTimestamp = now() - ((time_t) (tNumberOfValues - 1) * STORAGE_INTERVAL_SECONDS);
+#  if defined(E2END)
+    readCO2Log(&addRebuildValueToCO2Tiers);
+#  else
+    for (uint16_t i = 0; i < CO2_ARRAY_SIZE; ++i) {
+        addRebuildValueToCO2Tiers(sCO2Array[i]);
+    }
+#  endif
+}
+#endif
+
+#if defined(E2END)
+/*
+ * Helper for the nibbles of the EEPROM log, nibble 0 is the high nibble of the byte after the sequence number
+ */
+uint8_t readCO2LogNibble(uint8_t aBlockIndex, uint8_t aNibbleIndex) {
+    uint8_t tByte = eeprom_read_byte(&sCO2LogInEEPROM[aBlockIndex][1 + (aNibbleIndex / 2)]);
+    if (aNibbleIndex & 0x01) {
+        return tByte & 0x0F;
+    }
+    return tByte >> 4;
+}
+
+void writeCO2LogNibble(uint8_t aBlockIndex, uint8_t aNibbleIndex, uint8_t aNibble) {
+    uint8_t *tEEPROMAddress = &sCO2LogInEEPROM[aBlockIndex][1 + (aNibbleIndex / 2)];
+    uint8_t tByte = eeprom_read_byte(tEEPROMAddress);
+    if (aNibbleIndex & 0x01) {
+        tByte = (tByte & 0xF0) | aNibble;
+    } else {
+        tByte = (tByte & 0x0F) | (aNibble << 4);
+    }
+    eeprom_update_byte(tEEPROMAddress, tByte);
+}
+
+uint8_t getCO2LogSequence(uint8_t aBlockIndex) {
+    return eeprom_read_byte(&sCO2LogInEEPROM[aBlockIndex][0]);
+}
+
+/*
+ * Sequence numbers are 0 to 0xFE, since 0xFF marks an erased block
+ */
+uint8_t getNextCO2LogSequence(uint8_t aSequence) {
+    aSequence++;
+    if (aSequence == CO2_LOG_ERASED_BYTE) {
+        aSequence = 0;
+    }
+    return aSequence;
+}
+
+uint8_t getNextCO2LogBlockIndex(uint8_t aBlockIndex) {
+    aBlockIndex++;
+    if (aBlockIndex >= CO2_LOG_NUMBER_OF_BLOCKS) {
+        aBlockIndex = 0;
+    }
+    return aBlockIndex;
+}
+
+/*
+ * Decodes one block and calls aValueHandler for each value, if aValueHandler is not nullptr
+ * @param aLogState - if not nullptr, the position and last value are stored here, which is required to append to the newest block
+ * @return number of values in block
+ */
+uint16_t decodeCO2LogBlock(uint8_t aBlockIndex, void (*aValueHandler)(uint8_t aCO2Value), CO2LogStateStruct *aLogState) {
+    uint16_t tNumberOfValues = 0;
+    uint8_t tValue = 0;
+    uint8_t tNibbleIndex = 0;
+    uint8_t tLastCodeNibbleIndex = CO2_LOG_NO_INDEX;
+    while (tNibbleIndex < CO2_LOG_NIBBLES_PER_BLOCK) {
+        uint8_t tCode = readCO2LogNibble(aBlockIndex, tNibbleIndex);
+        if (tCode == CO2_LOG_CODE_ERASED) {
+            break;
+        }
+        uint8_t tRepetitions = 1;
+        tLastCodeNibbleIndex = CO2_LOG_NO_INDEX;
+        if (tCode == CO2_LOG_CODE_ABSOLUTE) {
+            // The code is written after the value, so the 2 nibbles of the value are always valid here
+            tValue = (readCO2LogNibble(aBlockIndex, tNibbleIndex + 1) << 4) | readCO2LogNibble(aBlockIndex, tNibbleIndex + 2);
+            tNibbleIndex += 2;
+        } else if (tCode == CO2_LOG_CODE_REPEAT) {
+            tLastCodeNibbleIndex = tNibbleIndex;
+            uint8_t tRepeatNibble = readCO2LogNibble(aBlockIndex, tNibbleIndex + 1); // Repeat code is never written to the last nibble
+            if (tRepeatNibble != CO2_LOG_CODE_ERASED) {
+                tRepetitions = tRepeatNibble + 2;
+                tNibbleIndex++;
+            }
+        } else {
+            if (tCode == CO2_LOG_CODE_DELTA_ZERO) {
+                tLastCodeNibbleIndex = tNibbleIndex;
+            }
+            tValue += tCode - CO2_LOG_CODE_DELTA_ZERO;
+        }
+        tNibbleIndex++;
+        tNumberOfValues += tRepetitions;
+        if (aValueHandler != nullptr) {
+            while (tRepetitions-- > 0) {
+                aValueHandler(tValue);
+            }
+        }
+    }
+    if (aLogState != nullptr) {
+        aLogState->BlockIndex = aBlockIndex;
+        aLogState->NextNibbleIndex = tNibbleIndex;
+        aLogState->LastCodeNibbleIndex = tLastCodeNibbleIndex;
+        aLogState->LastValue = tValue;
+    }
+    return tNumberOfValues;
+}
+
+/*
+ * Searches the newest block and restores the state for appending to it
+ * Erases the EEPROM if it does not contain a log of the current format
+ */
+void initCO2Log() {
+    if (eeprom_read_byte(&sCO2LogFormatVersionInEEPROM) != CO2_LOG_FORMAT_VERSION) {
+        /*
+         * Found an unused EEPROM (at first running this program on this CPU) or old format -> erase it. Takes around 3 seconds.
+         */
+        for (uint8_t i = 0; i < CO2_LOG_NUMBER_OF_BLOCKS; ++i) {
+            for (uint8_t j = 0; j < CO2_LOG_BLOCK_SIZE; ++j) {
+                eeprom_update_byte(&sCO2LogInEEPROM[i][j], CO2_LOG_ERASED_BYTE);
+            }
+        }
+        eeprom_update_byte(&sCO2LogFormatVersionInEEPROM, CO2_LOG_FORMAT_VERSION);
+    }
+
+    /*
+     * The newest block is the valid block, whose successor in the ring has not the next sequence number.
+     * Do not assume, that any block is valid, since a reset while erasing a block for a new start leaves it erased.
+     * The valid blocks are always consecutive, so there is only one such block.
+     */
+    sCO2LogState.isEmpty = true;
+    uint8_t tNewestBlockIndex = 0;
+    for (uint8_t i = 0; i < CO2_LOG_NUMBER_OF_BLOCKS; ++i) {
+        uint8_t tSequence = getCO2LogSequence(i);
+        if (tSequence != CO2_LOG_ERASED_BYTE
+                && getCO2LogSequence(getNextCO2LogBlockIndex(i)) != getNextCO2LogSequence(tSequence)) {
+            sCO2LogState.isEmpty = false;
+            tNewestBlockIndex = i;
+            break;
+        }
+    }
+    if (!sCO2LogState.isEmpty) {
+        decodeCO2LogBlock(tNewestBlockIndex, nullptr, &sCO2LogState);
+
+        /*
+         * If a repeat code was written but not its repeat nibble, convert it back to the equivalent delta zero code
+         */
+        if (sCO2LogState.LastCodeNibbleIndex == sCO2LogState.NextNibbleIndex - 1
+                && readCO2LogNibble(tNewestBlockIndex, sCO2LogState.LastCodeNibbleIndex) == CO2_LOG_CODE_REPEAT) {
+            writeCO2LogNibble(tNewestBlockIndex, sCO2LogState.LastCodeNibbleIndex, CO2_LOG_CODE_DELTA_ZERO);
+        }
+        /*
+         * Erase the value nibbles of an absolute value, whose code was not written
+         */
+        for (uint8_t i = sCO2LogState.NextNibbleIndex; i < CO2_LOG_NIBBLES_PER_BLOCK; ++i) {
+            if (readCO2LogNibble(tNewestBlockIndex, i) != CO2_LOG_CODE_ERASED) {
+                writeCO2LogNibble(tNewestBlockIndex, i, CO2_LOG_CODE_ERASED);
+            }
+        }
+    }
+}
+
+/*
+ * Erases the next block and writes aCO2Value as first value
+ * The sequence number is erased first and written last, so the block is invalid until its first value is completely written.
+ * A reset in between loses only aCO2Value, since initCO2Log() then finds the previous block as the newest one.
+ */
+void startNewCO2LogBlock(uint8_t aCO2Value) {
+    uint8_t tSequence = 0;
+    uint8_t tBlockIndex = 0;
+    if (!sCO2LogState.isEmpty) {
+        tSequence = getNextCO2LogSequence(getCO2LogSequence(sCO2LogState.BlockIndex));
+        tBlockIndex = getNextCO2LogBlockIndex(sCO2LogState.BlockIndex);
+    }
+    for (uint8_t i = 0; i < CO2_LOG_BLOCK_SIZE; ++i) {
+        eeprom_update_byte(&sCO2LogInEEPROM[tBlockIndex][i], CO2_LOG_ERASED_BYTE);
+    }
+    writeCO2LogNibble(tBlockIndex, 1, aCO2Value >> 4);
+    writeCO2LogNibble(tBlockIndex, 2, aCO2Value & 0x0F);
+    writeCO2LogNibble(tBlockIndex, 0, CO2_LOG_CODE_ABSOLUTE);
+    eeprom_update_byte(&sCO2LogInEEPROM[tBlockIndex][0], tSequence);
+
+    sCO2LogState.isEmpty = false;
+    sCO2LogState.BlockIndex = tBlockIndex;
+    sCO2LogState.NextNibbleIndex = 3;
+    sCO2LogState.LastCodeNibbleIndex = CO2_LOG_NO_INDEX;
+    sCO2LogState.LastValue = aCO2Value;
+}
+
+/*
+ * Writes mostly only one nibble, i.e. one EEPROM byte.
+ * Each single nibble write results in a valid log, so a reset at any time loses at most the current value.
+ */
+void appendToCO2Log(uint8_t aCO2Value) {
+    if (sCO2LogState.isEmpty) {
+        startNewCO2LogBlock(aCO2Value);
+        return;
+    }
+    uint8_t tBlockIndex = sCO2LogState.BlockIndex;
+    uint8_t tNibbleIndex = sCO2LogState.NextNibbleIndex;
+    uint8_t tFreeNibbles = CO2_LOG_NIBBLES_PER_BLOCK - tNibbleIndex;
+    int16_t tDelta = (int16_t) aCO2Value - sCO2LogState.LastValue;
+
+    if (tDelta == 0 && sCO2LogState.LastCodeNibbleIndex != CO2_LOG_NO_INDEX) {
+        uint8_t tLastCodeNibbleIndex = sCO2LogState.LastCodeNibbleIndex;
+        if (readCO2LogNibble(tBlockIndex, tLastCodeNibbleIndex) == CO2_LOG_CODE_REPEAT) {
+            uint8_t tRepeatNibble = readCO2LogNibble(tBlockIndex, tLastCodeNibbleIndex + 1);
+            if (tRepeatNibble < CO2_LOG_MAX_REPEAT_NIBBLE) {
+                writeCO2LogNibble(tBlockIndex, tLastCodeNibbleIndex + 1, tRepeatNibble + 1);
+                return;
+            }
+        } else if (tFreeNibbles > 0) {
+            /*
+             * Convert delta zero to repeat. Repeat with erased repeat nibble is one repetition, so the value is not yet contained.
+             * Writing 0 for 2 repetitions adds the value.
+             */
+            writeCO2LogNibble(tBlockIndex, tLastCodeNibbleIndex, CO2_LOG_CODE_REPEAT);
+            writeCO2LogNibble(tBlockIndex, tNibbleIndex, 0);
+            sCO2LogState.NextNibbleIndex++;
+            return;
+        }
+    }
+
+    if (tDelta >= -CO2_LOG_MAX_DELTA && tDelta <= CO2_LOG_MAX_DELTA) {
+        if (tFreeNibbles < 1) {
+            startNewCO2LogBlock(aCO2Value);
+            return;
+        }
+        writeCO2LogNibble(tBlockIndex, tNibbleIndex, tDelta + CO2_LOG_CODE_DELTA_ZERO);
+        sCO2LogState.LastCodeNibbleIndex = (tDelta == 0) ? tNibbleIndex : CO2_LOG_NO_INDEX;
+        sCO2LogState.NextNibbleIndex++;
+    } else {
+        if (tFreeNibbles < 3) {
+            startNewCO2LogBlock(aCO2Value);
+            return;
+        }
+        // Write code last
+        writeCO2LogNibble(tBlockIndex, tNibbleIndex + 1, aCO2Value >> 4);
+        writeCO2LogNibble(tBlockIndex, tNibbleIndex + 2, aCO2Value & 0x0F);
+        writeCO2LogNibble(tBlockIndex, tNibbleIndex, CO2_LOG_CODE_ABSOLUTE);
+        sCO2LogState.LastCodeNibbleIndex = CO2_LOG_NO_INDEX;
+        sCO2LogState.NextNibbleIndex += 3;
+    }
+    sCO2LogState.LastValue = aCO2Value;
+}
+
+/*
+ * Streams all values of the log from oldest to newest to aValueHandler
+ * @param aValueHandler - if nullptr, values are only counted
+ * @return number of values in log
+ */
+uint16_t readCO2Log(void (*aValueHandler)(uint8_t aCO2Value)) {
+    if (sCO2LogState.isEmpty) {
+        return 0;
+    }
+    /*
+     * The oldest block is the first valid block after the newest one
+     */
+    uint8_t tBlockIndex = sCO2LogState.BlockIndex;
+    do {
+        tBlockIndex = getNextCO2LogBlockIndex(tBlockIndex);
+    } while (getCO2LogSequence(tBlockIndex) == CO2_LOG_ERASED_BYTE);
+
+    uint16_t tNumberOfValues = 0;
+    while (true) {
+        if (getCO2LogSequence(tBlockIndex) != CO2_LOG_ERASED_BYTE) {
+            tNumberOfValues += decodeCO2LogBlock(tBlockIndex, aValueHandler, nullptr);
+        }
+        if (tBlockIndex == sCO2LogState.BlockIndex) {
+            return tNumberOfValues;
+        }
+        tBlockIndex = getNextCO2LogBlockIndex(tBlockIndex);
+    }
+}
+
+/*
+ * Value handler for readCO2Log(), which skips the first sCO2LogValuesToSkip values
+ */
+void storeCO2LogValueInArray(uint8_t aCO2Value) {
+    if (sCO2LogValuesToSkip > 0) {
+        sCO2LogValuesToSkip--;
+    } else {
+        *sCO2LogDestinationPointer++ = aCO2Value;
+    }
+}
+#endif
+
 /**************************************
  * BlueDisplay GUI related functions
  **************************************/
@@ -428,16 +893,24 @@ void initDisplay(void) {
 
     int tButtonYSpacing = tDisplayHeightEighth + BASE_TEXT_SIZE_HALF;
 
-    tBDButtonPGMParameterStruct.aWidthX = BUTTON_WIDTH;
-    tBDButtonPGMParameterStruct.aTextSize = BASE_TEXT_SIZE;
-#if defined(E2END)
-    tBDButtonPGMParameterStruct.aButtonColor = COLOR16_YELLOW;
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    /*
+     * Buttons for charts of the hourly and daily tier
+     */
     tBDButtonPGMParameterStruct.aPositionY += tButtonYSpacing;
-    tBDButtonPGMParameterStruct.aOnTouchHandler = &doStoreInEEPROM;
-    tBDButtonPGMParameterStruct.aPGMText = F("Store in\nEEPROM");
-    TouchButtonStoreToEEPROM.init(&tBDButtonPGMParameterStruct);
+    tBDButtonPGMParameterStruct.aValue = NUMBER_OF_DAYS_IN_HOURLY_TIER * HOURS_IN_ONE_DAY; // 192
+    tBDButtonPGMParameterStruct.aPGMText = F("8");
+    TouchButton8days.init(&tBDButtonPGMParameterStruct);
+
+    tBDButtonPGMParameterStruct.aPositionX += (BASE_TEXT_SIZE * 4) + BASE_TEXT_SIZE_HALF;
+    tBDButtonPGMParameterStruct.aValue = NUMBER_OF_DAYS_IN_DAILY_TIER * HOURS_IN_ONE_DAY; // 768
+    tBDButtonPGMParameterStruct.aPGMText = F("32");
+    TouchButton32days.init(&tBDButtonPGMParameterStruct);
+    tBDButtonPGMParameterStruct.aPositionX = BUTTONS_START_X;
 #endif
 
+    tBDButtonPGMParameterStruct.aWidthX = BUTTON_WIDTH;
+    tBDButtonPGMParameterStruct.aTextSize = BASE_TEXT_SIZE;
     tBDButtonPGMParameterStruct.aButtonColor = COLOR16_LIGHT_GREY;
     tBDButtonPGMParameterStruct.aPositionY += tButtonYSpacing;
     tBDButtonPGMParameterStruct.aOnTouchHandler = &doSignalChangeBrightness;
@@ -466,12 +939,13 @@ void drawDisplay() {
     TouchButton2days.drawButton();
     TouchButton1day.drawButton();
     TouchButton12Hour.drawButton();
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    TouchButton8days.drawButton();
+    TouchButton32days.drawButton();
+#endif
     BlueDisplay1.drawText(BUTTONS_START_X + BASE_TEXT_SIZE_2, (BlueDisplay1.getRequestedDisplayHeight() / 4) - BASE_TEXT_SIZE,
             F("Day(s)"), BASE_TEXT_SIZE_1_5, DAY_BUTTONS_COLOR, sBackgroundColor);
 
-#if defined(E2END)
-    TouchButtonStoreToEEPROM.drawButton();
-#endif
     TouchButtonBrightness.drawButton();
     TouchButtonShowTimeToNextStorage.activate(); // Just listen for touches
 }
@@ -484,6 +958,28 @@ void setChartHoursToDisplay(int16_t aChartHoursToDisplay) {
     uint8_t tXLabelDistance = 2; // draw label at every 2. grid line
     int8_t tXLabelScaleFactor;
     int8_t tDataFactor;
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    sCO2ChartSource = CO2_CHART_SOURCE_RAW;
+    if (aChartHoursToDisplay == (NUMBER_OF_DAYS_IN_DAILY_TIER * HOURS_IN_ONE_DAY)) {
+        // Daily values expanded by 18
+        sCO2ChartSource = CO2_CHART_SOURCE_DAILY;
+        sCO2ArrayDisplayStart = sCO2DailyTier[CO2_TIER_AVERAGE];
+        tDataFactor = CHART_WIDTH / CO2_DAILY_TIER_SIZE;
+        /*
+         * 32 days -> with 8 grids at X axis => 1 grid line each 4 days, label each 8 days => X scale compressed by 8
+         */
+        tXLabelScaleFactor = CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_8;
+    } else if (aChartHoursToDisplay == (NUMBER_OF_DAYS_IN_HOURLY_TIER * HOURS_IN_ONE_DAY)) {
+        // Hourly values expanded by 3
+        sCO2ChartSource = CO2_CHART_SOURCE_HOURLY;
+        sCO2ArrayDisplayStart = sCO2HourlyTier[CO2_TIER_AVERAGE];
+        tDataFactor = CHART_X_AXIS_SCALE_FACTOR_EXPANSION_3;
+        /*
+         * 8 days -> with 8 grids at X axis => 1 grid line each day, label each 2 days => X scale compressed by 2
+         */
+        tXLabelScaleFactor = CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_2;
+    } else
+#endif
     if (aChartHoursToDisplay == (4 * HOURS_IN_ONE_DAY)) { //
         // Data compressed by 2
         sCO2ArrayDisplayStart = &sCO2Array[0];
@@ -534,7 +1030,7 @@ void doDays(BDButton *aTheTouchedButton, int16_t aChartHoursToDisplay) {
 
 /*
  * Current time is at pixel position CHART_START_X + CHART_WIDTH
- * Touched time is at current time - (pixel_difference * X_data_scale * 5 min)
+ * Touched time is at current time - (pixel_difference * X_data_scale * 5 min (or 1 hour or 1 day for tiers))
  */
 void doShowTimeAtTouchPosition(struct TouchEvent *const aTouchPosition) {
     static struct XYPosition sLastPosition = { 0, 0 };
@@ -543,17 +1039,31 @@ void doShowTimeAtTouchPosition(struct TouchEvent *const aTouchPosition) {
         uint16_t tPixelDifference = CO2Chart.reduceLongWithIntegerScaleFactor((CHART_START_X + CHART_WIDTH) - tPositionX,
                 CO2Chart.getXDataScaleFactor());
         time_float_union tTimeOfTouchPosition;
+        uint32_t tSecondsPerValue = STORAGE_INTERVAL_SECONDS;
+#if defined(USE_CO2_AGGREGATION_TIERS)
+        if (sCO2ChartSource == CO2_CHART_SOURCE_HOURLY) {
+            tSecondsPerValue = SECONDS_IN_ONE_HOUR;
+        } else if (sCO2ChartSource == CO2_CHART_SOURCE_DAILY) {
+            tSecondsPerValue = SECONDS_IN_ONE_DAY;
+        }
+#endif
 
 #if defined(USE_C_TIME)
         tTimeOfTouchPosition.TimeValue = (BlueDisplay1.getHostUnixTimestamp()
-                - (BlueDisplay1.getHostUnixTimestamp() % STORAGE_INTERVAL_SECONDS)) - (tPixelDifference * STORAGE_INTERVAL_SECONDS);
+                - (BlueDisplay1.getHostUnixTimestamp() % tSecondsPerValue)) - (tPixelDifference * tSecondsPerValue);
 #else
-        tTimeOfTouchPosition.TimeValue = (now() - (now() % STORAGE_INTERVAL_SECONDS))
-                - (tPixelDifference * STORAGE_INTERVAL_SECONDS);
+        tTimeOfTouchPosition.TimeValue = (now() - (now() % tSecondsPerValue)) - (tPixelDifference * tSecondsPerValue);
 #endif
 
         char tTimeString[6];
-        convertUnixTimestampToHourAndMinuteString(tTimeString, tTimeOfTouchPosition);
+#if defined(USE_CO2_AGGREGATION_TIERS)
+        if (sCO2ChartSource == CO2_CHART_SOURCE_DAILY) {
+            convertUnixTimestampToDateString(tTimeString, tTimeOfTouchPosition); // 5 characters for 31.12
+        } else
+#endif
+        {
+            convertUnixTimestampToHourAndMinuteString(tTimeString, tTimeOfTouchPosition);
+        }
         BlueDisplay1.drawText(BUTTONS_START_X, TIME_MARKER_START_Y, tTimeString, BASE_TEXT_SIZE, CHART_DATA_COLOR,
                 sBackgroundColor);
         // Clear last indicator
@@ -660,7 +1170,27 @@ void drawCO2Chart() {
 
     CO2Chart.drawYAxisAndLabels(); // this will restore the overwritten 400 label
     CO2Chart.drawGrid();
-    CO2Chart.drawChartDataWithYOffset(sCO2ArrayDisplayStart, CO2_ARRAY_SIZE, CHART_MODE_LINE);
+#if defined(USE_CO2_AGGREGATION_TIERS)
+    if (sCO2ChartSource != CO2_CHART_SOURCE_RAW) {
+        /*
+         * Draw minimum and maximum of tier behind the average
+         */
+        uint8_t *tTierArray = &sCO2HourlyTier[0][0];
+        uint16_t tTierSize = CO2_HOURLY_TIER_SIZE;
+        if (sCO2ChartSource == CO2_CHART_SOURCE_DAILY) {
+            tTierArray = &sCO2DailyTier[0][0];
+            tTierSize = CO2_DAILY_TIER_SIZE;
+        }
+        CO2Chart.setDataColor(CHART_MIN_MAX_COLOR);
+        CO2Chart.drawChartDataWithYOffset(&tTierArray[CO2_TIER_MINIMUM * tTierSize], tTierSize, CHART_MODE_LINE);
+        CO2Chart.drawChartDataWithYOffset(&tTierArray[CO2_TIER_MAXIMUM * tTierSize], tTierSize, CHART_MODE_LINE);
+        CO2Chart.setDataColor(CHART_DATA_COLOR);
+        CO2Chart.drawChartDataWithYOffset(sCO2ArrayDisplayStart, tTierSize, CHART_MODE_LINE);
+    } else
+#endif
+    {
+        CO2Chart.drawChartDataWithYOffset(sCO2ArrayDisplayStart, CO2_ARRAY_SIZE, CHART_MODE_LINE);
+    }
 //        CO2Chart.drawChartDataWithYOffset(sCO2ArrayDisplayStart, CO2_ARRAY_SIZE, CHART_MODE_PIXEL);
 }
 
@@ -731,15 +1261,6 @@ void doSignalChangeBrightness(BDButton *aTheTouchedButton, int16_t aValue) {
     sDoRefreshOrChangeBrightness = true;
 }
 
-#if defined(E2END)
-void doStoreInEEPROM(BDButton *aTheTouchedButton, int16_t aValue) {
-    (void) aTheTouchedButton;
-    (void) aValue;
-// store only the most recent values
-    eeprom_update_block(&sCO2Array[CO2_ARRAY_SIZE - sizeof(sCO2ArrayInEEPROM)], sCO2ArrayInEEPROM, sizeof(sCO2ArrayInEEPROM));
-}
-#endif
-
 void doShowTimeToNextStorage(BDButton *aTheTouchedButton, int16_t aValue) {
     (void) aTheTouchedButton;
     (void) aValue;
@@ -842,6 +1363,13 @@ void getTimeEventCallbackForLogger(uint8_t aSubcommand, uint8_t aByteInfo, uint1
 
     setTime(aLongInfo.uint32Value);
     time_t tTimestamp = now(); // use this timestamp for display etc.
+#  if defined(USE_CO2_AGGREGATION_TIERS)
+    if (!sCO2TiersAreRebuiltWithHostTime) {
+        // The tiers were built at boot with millis() based time, so they are not aligned to clock hours and days
+        sCO2TiersAreRebuiltWithHostTime = true;
+        initializeCO2Tiers();
+    }
+#  endif
 
     /*
      * Now set sNextStorageMillis, so it is synchronized with clock
@@ -127,6 +127,9 @@ LiquidCrystal myLCD(7, 8, 3, 4, 5, 6);
 #else
 #define LCD_I2C_ADDRESS 0x27    // Default LCD address is 0x27 for a 20 chars and 4 line / 2004 display
 #define USE_SOFT_I2C_MASTER // Requires SoftI2CMaster.h + SoftI2CMasterConfig.h. Saves 2110 bytes program memory and 200 bytes RAM compared with Arduino Wire
+#  if !defined(__AVR__) || RAMEND > 0x8FF
+#define USE_LCD_SHADOW_BUFFER // Send only changed characters. Requires 148 bytes RAM, which we do not have on an Uno.
+#  endif
 #include "LiquidCrystal_I2C.hpp"  // This defines USE_SOFT_I2C_MASTER, if SoftI2CMasterConfig.h is available. Use only the modified version delivered with this program!
 LiquidCrystal_I2C myLCD(LCD_I2C_ADDRESS, 20, 4);
 #endif
@@ -378,20 +381,27 @@ void loop() {
 #endif
     checkDebugAndSmallDigitsPin();
 
-    if (millis() - sMillisOfLastRequestedCO2Data >= DISPLAY_PERIOD_MILLIS) {
+    if (millis() - sMillisOfLastRequestedCO2Data >= DISPLAY_PERIOD_MILLIS && myMHZ19.isCommandQueueEmpty()) {
         sMillisOfLastRequestedCO2Data = millis(); // set for next check
         // The sensor makes a measurement every 2 seconds
-
-        if (myMHZ19.readCO2UnmaskedAndTemperatureFloat()) {
-            printErrorCode();
-        } else {
+        myMHZ19.queueCommand(MHZ19::CO2_AND_TEMPERATURE);
 #if !defined(MHZ19_USE_MINIMAL_RAM)
-            myMHZ19.readCO2MaskedTemperatureIntAndABCCounter();
-            myMHZ19.readCO2Alternate();
-            myMHZ19.readCO2Raw();
+        myMHZ19.queueCommand(MHZ19::CO2MASKED_AND_TEMP);
+        myMHZ19.queueCommand(MHZ19::GETCO2);
+        myMHZ19.queueCommand(MHZ19::CO2RAW);
 #endif
+    }
+
+    /*
+     * Responses are read without waiting. Data is printed, if all responses of this period are received.
+     */
+    if (myMHZ19.checkForResponse() != MHZ19_NO_COMMAND) {
+        if (myMHZ19.errorCode != MHZ19::RESULT_OK) {
+            myMHZ19.clearCommandQueue(); // skip the remaining commands of this period
+            printErrorCode();
+        } else if (myMHZ19.isCommandQueueEmpty()) {
 #if defined(PRINT_PERIODIC_DATA_ALWAYS_ON_SERIAL)
-        printData();
+            printData();
 #else
 
 #  if !defined(MHZ19_USE_MINIMAL_RAM)
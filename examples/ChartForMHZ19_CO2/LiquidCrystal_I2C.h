@@ -50,6 +50,22 @@
 #define LCD_BACKLIGHT 0x08
 #define LCD_NOBACKLIGHT 0x00
 
+/*
+ * Define USE_LCD_SHADOW_BUFFER to keep the content of DDRAM and CGRAM in RAM and send only changed characters.
+ * setCursor() is deferred until the next changed character, so unchanged text costs no I2C transfer at all
+ * and a run of changed characters requires only one setCursor().
+ * Custom characters, e.g. the ones of LCDBigNumbers, are only sent if their pattern changed.
+ * Requires LCD_SHADOW_BUFFER_COLUMNS * LCD_SHADOW_BUFFER_ROWS + 64 + 4 bytes RAM.
+ * Only left to right mode without autoscroll is buffered, other modes write through until the next clear().
+ */
+//#define USE_LCD_SHADOW_BUFFER
+#if !defined(LCD_SHADOW_BUFFER_COLUMNS)
+#define LCD_SHADOW_BUFFER_COLUMNS   20
+#endif
+#if !defined(LCD_SHADOW_BUFFER_ROWS)
+#define LCD_SHADOW_BUFFER_ROWS       4
+#endif
+
 #define En 0b00000100  // Enable bit
 #define Rw 0b00000010  // Read/Write bit
 #define Rs 0b00000001  // Register select bit
@@ -124,6 +140,17 @@ private:
   uint8_t _cols;
   uint8_t _rows;
   uint8_t _backlightval;
+#if defined(USE_LCD_SHADOW_BUFFER)
+  uint8_t *getShadowBufferPointer();
+  void synchronizeAddress();
+  uint8_t _shadowDDRAM[LCD_SHADOW_BUFFER_ROWS][LCD_SHADOW_BUFFER_COLUMNS];
+  uint8_t _shadowCGRAM[64];
+  uint8_t _shadowCGRAMValidMask;    // One bit for each custom character, which has a known pattern
+  uint8_t _shadowAddress;           // DDRAM or CGRAM address of next write, like the address counter of the LCD
+  bool _shadowAddressIsCGRAM;
+  bool _shadowAddressIsSynchronized; // false if LCD address counter must be set before next write
+  bool _shadowIsValid;              // false until first clear() or after entry mode change
+#endif
 };
 
 #endif
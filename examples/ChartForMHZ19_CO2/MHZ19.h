@@ -138,6 +138,28 @@ public:
     uint8_t computeChecksum(uint8_t *aArray);
     bool processCommand(MHZ19_command_t aCommand, bool aDoNotWaitForResponse = false);
     bool readResponse();
+    bool checkReceivedResponse();
+    void storeResponseValues();
+
+    /*
+     * Non blocking interface
+     * Commands are queued and sent by checkForResponse() one after the other, as soon as the previous response is received.
+     * checkForResponse() must be called in loop() and reads only the bytes already received.
+     * Only commands without parameter can be queued.
+     */
+#define MHZ19_COMMAND_QUEUE_SIZE    4
+#define MHZ19_NO_COMMAND            0 // Returned by checkForResponse() if no command was completed
+    uint8_t CommandQueue[MHZ19_COMMAND_QUEUE_SIZE]; // The first command is the one currently processed
+    uint8_t CommandQueueLength;
+    uint8_t ReceiveIndex;           // Number of response bytes received for the first command in queue
+    bool CommandIsSent;             // The first command in queue is sent and we wait for the response
+    uint32_t MillisOfCommandSent;   // For timeout
+
+    bool queueCommand(MHZ19_command_t aCommand);
+    void clearCommandQueue();
+    bool isCommandQueueEmpty();
+    void sendFirstQueuedCommand();
+    uint8_t checkForResponse();
     bool readCO2UnmaskedAndTemperatureFloat();
     bool readVersion();
     bool readABC(); // Reads SETABC_ON_OFF-Status using command 125 / 0x7D
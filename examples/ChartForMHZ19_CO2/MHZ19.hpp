@@ -105,9 +105,9 @@ bool MHZ19::processCommand(MHZ19_command_t aCommand, bool aDoNotWaitForResponse)
     CommandToSend[CHECKSUM_INDEX] = computeChecksum(CommandToSend);
 
     SerialToMHZ19->write(CommandToSend, MHZ19_DATA_LEN); // Start sending
-    SerialToMHZ19->flush(); // wait to be sent
 
     if (!aDoNotWaitForResponse) {
+        SerialToMHZ19->flush(); // wait to be sent
         delay(12);
         return readResponse();
     }
@@ -134,7 +134,14 @@ bool MHZ19::readResponse() {
 #endif
         return true;
     }
+    return checkReceivedResponse();
+}
 
+/**
+ * Checks checksum and command of the response in ReceivedResponse and sets errorCode
+ * @return true if error happened
+ */
+bool MHZ19::checkReceivedResponse() {
 #if !defined(MHZ19_USE_MINIMAL_RAM)
     if (this->SerialDebugOutputIsEnabled) {
         SerialForDebug->print(F(" Received cmd=0x"));
@@ -186,6 +193,147 @@ bool MHZ19::readResponse() {
     return false;
 }
 
+/*
+ * Stores the values of the response in ReceivedResponse in the fields for the received command
+ * Used by the blocking read functions and by checkForResponse()
+ */
+void MHZ19::storeResponseValues() {
+    switch (ReceivedResponse[COMMAND_RECEIVE_INDEX]) {
+    case CO2_AND_TEMPERATURE: // 0x85
+        this->TemperatureFloat = (ReceivedResponse[2] << 8 | ReceivedResponse[3]) / 100.0;
+        this->CO2Unmasked = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+#if !defined(MHZ19_USE_MINIMAL_RAM)
+        this->MinimumLightADC = ReceivedResponse[6] << 8 | ReceivedResponse[7]; // Observed 1013 to 1044
+#endif
+        break;
+    case GETFIRMWARE_VERSION:
+        for (uint_fast8_t i = 0; i < 4; i++) {
+            this->VersionString[i] = char(this->ReceivedResponse[i + 2]);
+        }
+#if !defined(MHZ19_USE_MINIMAL_RAM)
+        this->VersionMajor = this->ReceivedResponse[3] - '0';
+        this->VersionMinor = (this->ReceivedResponse[4] - '0') * 10;
+        this->VersionMinor += this->ReceivedResponse[5] - '0';
+        this->Version = (100 * this->VersionMajor) + this->VersionMinor;
+#endif
+        break;
+    case GETABC: // 0x7D
+        this->AutoBaselineCorrectionEnabled = this->ReceivedResponse[7]; // (1 - enabled, 0 - disabled)
+        break;
+#if !defined(MHZ19_USE_MINIMAL_RAM)
+    case CO2MASKED_AND_TEMP: // 0x86
+        this->CO2 = ReceivedResponse[2] << 8 | ReceivedResponse[3];
+        this->Temperature = ReceivedResponse[4] - TEMPERATURE_ADJUST_CONSTANT;
+        this->ABCCounter = ReceivedResponse[6];
+        break;
+    case CO2RAW: // 0x84
+        this->CO2RawADC = ReceivedResponse[2] << 8 | ReceivedResponse[3];
+        this->CO2RawTemperatureCompensatedBaseADC = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+        this->Unknown2 = ReceivedResponse[6] << 8 | ReceivedResponse[7]; // Observed 0x0B57 to 0x0BEB
+
+        if (this->Version >= 520) {
+            this->CO2RawADCDelta = this->CO2RawTemperatureCompensatedBaseADC - this->CO2RawADC;
+        } else {
+            this->CO2RawADCDelta = this->CO2RawADC - this->CO2RawTemperatureCompensatedBaseADC;
+        }
+        break;
+    case GETRANGE:
+        this->SensorRange = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+        break;
+    case GETCO2:
+        this->CO2Alternate = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+        break;
+    case PERIOD:
+//        this->Period = ReceivedResponse[4] << 8 | ReceivedResponse[5]; // suggested by datasheet
+        this->Period = ReceivedResponse[2] << 8 | ReceivedResponse[3]; // result in seconds, suggested by real data :-)
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+/*
+ * @return true if queue is full
+ */
+bool MHZ19::queueCommand(MHZ19_command_t aCommand) {
+    if (CommandQueueLength >= MHZ19_COMMAND_QUEUE_SIZE) {
+        return true;
+    }
+    CommandQueue[CommandQueueLength++] = aCommand;
+    return false;
+}
+
+/*
+ * A response of a command already sent is ignored, since the next command flushes the receive buffer
+ */
+void MHZ19::clearCommandQueue() {
+    CommandQueueLength = 0;
+    CommandIsSent = false;
+}
+
+bool MHZ19::isCommandQueueEmpty() {
+    return CommandQueueLength == 0;
+}
+
+/*
+ * Does not wait for the end of transmission, which is only relevant for HardwareSerial
+ */
+void MHZ19::sendFirstQueuedCommand() {
+    processCommand((MHZ19_command_t) CommandQueue[0], true);
+    ReceiveIndex = 0;
+    CommandIsSent = true;
+    MillisOfCommandSent = millis();
+}
+
+/**
+ * Non blocking replacement for processCommand() and the read functions. To be called in loop().
+ * Sends the first queued command, reads the bytes of the response received so far,
+ * and if the response is complete, stores the values, removes the command from queue and sends the next one.
+ * @return The command, which was completed (errorCode is RESULT_OK) or failed (errorCode is RESULT_TIMEOUT etc.)
+ *         MHZ19_NO_COMMAND, if response is not yet complete or queue is empty
+ */
+uint8_t MHZ19::checkForResponse() {
+    if (CommandQueueLength == 0) {
+        return MHZ19_NO_COMMAND;
+    }
+    if (!CommandIsSent) {
+        sendFirstQueuedCommand();
+        return MHZ19_NO_COMMAND;
+    }
+
+    while (SerialToMHZ19->available() && ReceiveIndex < MHZ19_DATA_LEN) {
+        uint8_t tByte = SerialToMHZ19->read();
+        if (ReceiveIndex == 0 && tByte != 0xFF) {
+            continue; // Wait for start byte
+        }
+        ReceivedResponse[ReceiveIndex++] = tByte;
+    }
+
+    if (ReceiveIndex < MHZ19_DATA_LEN) {
+        if (millis() - MillisOfCommandSent < MHZ19_RESPONSE_TIMEOUT_MILLIS) {
+            return MHZ19_NO_COMMAND;
+        }
+        this->errorCode = RESULT_TIMEOUT;
+    } else if (!checkReceivedResponse()) {
+        storeResponseValues();
+    }
+
+    /*
+     * Remove command from queue and send the next one immediately
+     */
+    uint8_t tCommand = CommandQueue[0];
+    CommandQueueLength--;
+    for (uint_fast8_t i = 0; i < CommandQueueLength; ++i) {
+        CommandQueue[i] = CommandQueue[i + 1];
+    }
+    CommandIsSent = false;
+    if (CommandQueueLength > 0) {
+        sendFirstQueuedCommand();
+    }
+    return tCommand;
+}
+
 void MHZ19::printErrorCode(Print *aSerial) {
     if (this->errorCode == 2) {
         aSerial->print(F("Timeout"));
@@ -245,11 +393,7 @@ bool MHZ19::readCO2UnmaskedAndTemperatureFloat() {
     if (processCommand(CO2_AND_TEMPERATURE)) { // 0x85
         return true;
     }
-    this->TemperatureFloat = (ReceivedResponse[2] << 8 | ReceivedResponse[3]) / 100.0;
-    this->CO2Unmasked = ReceivedResponse[4] << 8 | ReceivedResponse[5];
-#if !defined(MHZ19_USE_MINIMAL_RAM)
-    this->MinimumLightADC = ReceivedResponse[6] << 8 | ReceivedResponse[7]; // Observed 1013 to 1044
-#endif
+    storeResponseValues();
     return false;
 }
 
@@ -266,15 +410,7 @@ bool MHZ19::readVersion() {
     if (processCommand(GETFIRMWARE_VERSION)) {
         return true;
     }
-    for (uint_fast8_t i = 0; i < 4; i++) {
-        this->VersionString[i] = char(this->ReceivedResponse[i + 2]);
-    }
-#if !defined(MHZ19_USE_MINIMAL_RAM)
-    this->VersionMajor = this->ReceivedResponse[3] - '0';
-    this->VersionMinor = (this->ReceivedResponse[4] - '0') * 10;
-    this->VersionMinor += this->ReceivedResponse[5] - '0';
-    this->Version = (100 * this->VersionMajor) + this->VersionMinor;
-#endif
+    storeResponseValues();
     return false;
 }
 
@@ -286,7 +422,7 @@ bool MHZ19::readABC() {
     if (processCommand(GETABC)) { // 0x7D
         return true;
     }
-    this->AutoBaselineCorrectionEnabled = this->ReceivedResponse[7]; // (1 - enabled, 0 - disabled)
+    storeResponseValues();
     return false;
 }
 
@@ -321,9 +457,7 @@ bool MHZ19::readCO2MaskedTemperatureIntAndABCCounter() {
     if (processCommand(CO2MASKED_AND_TEMP)) { // 0x86
         return true;
     }
-    this->CO2 = ReceivedResponse[2] << 8 | ReceivedResponse[3];
-    this->Temperature = ReceivedResponse[4] - TEMPERATURE_ADJUST_CONSTANT;
-    this->ABCCounter = ReceivedResponse[6];
+    storeResponseValues();
     return false;
 }
 
@@ -336,15 +470,7 @@ bool MHZ19::readCO2Raw() {
     if (processCommand(CO2RAW)) { // 0x84
         return true;
     }
-    this->CO2RawADC = ReceivedResponse[2] << 8 | ReceivedResponse[3];
-    this->CO2RawTemperatureCompensatedBaseADC = ReceivedResponse[4] << 8 | ReceivedResponse[5];
-    this->Unknown2 = ReceivedResponse[6] << 8 | ReceivedResponse[7]; // Observed 0x0B57 to 0x0BEB
-
-    if (this->Version >= 520) {
-        this->CO2RawADCDelta = this->CO2RawTemperatureCompensatedBaseADC - this->CO2RawADC;
-    } else {
-        this->CO2RawADCDelta = this->CO2RawADC - this->CO2RawTemperatureCompensatedBaseADC;
-    }
+    storeResponseValues();
     return false;
 }
 
@@ -357,7 +483,7 @@ bool MHZ19::readRange() {
     if (processCommand(GETRANGE)) {
         return true;
     }
-    this->SensorRange = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+    storeResponseValues();
     return false;
 }
 
@@ -369,7 +495,7 @@ bool MHZ19::readCO2Alternate() {
     if (processCommand(GETCO2)) {
         return true;
     }
-    this->CO2Alternate = ReceivedResponse[4] << 8 | ReceivedResponse[5];
+    storeResponseValues();
     return false;
 }
 
@@ -381,9 +507,7 @@ bool MHZ19::readPeriod() {
     if (processCommand(PERIOD)) {
         return true;
     }
-
-//    this->Period = ReceivedResponse[4] << 8 | ReceivedResponse[5]; // suggested by datasheet
-    this->Period = ReceivedResponse[2] << 8 | ReceivedResponse[3]; // result in seconds, suggested by real data :-)
+    storeResponseValues();
     return false;
 }
 
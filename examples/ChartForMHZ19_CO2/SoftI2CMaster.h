@@ -1,7 +1,7 @@
 /* Arduino SoftI2C library.
  * SoftI2CMaster.h
  *
- * Version 2.1.9
+ * Version 2.1.10
  *
  * Copyright (C) 2013-2023, Bernhard Nebel and Peter Fleury
  *
@@ -61,6 +61,8 @@
  */
 
 /* Changelog:
+ * Version 2.1.10
+ * - ArminJo: Added i2c_write_burst() and i2c_read_burst()
  *  * Version 2.1.8
  * - ArminJo: Included MACRO USE_SOFT_I2C_MASTER_H_AS_PLAIN_INCLUDE
  * Version 2.1.7
@@ -145,6 +147,14 @@ uint8_t __attribute__ ((noinline)) i2c_read(bool last) __attribute__ ((used));
 //
 void i2c_write_byte(uint8_t addr, uint8_t byte);
 
+//
+// Writes / reads number_of_bytes bytes in one transfer without register number, i.e. start, address, all bytes, stop.
+// Saves the start, address and stop overhead of i2c_write_byte() for each byte, e.g. for port expanders.
+// Return: true if the slave acknowledged the address and all written bytes. Write stops at the first NAK.
+//
+bool i2c_write_burst(uint8_t addr, const uint8_t *byte_buffer, uint8_t number_of_bytes_to_write);
+bool i2c_read_burst(uint8_t addr, uint8_t *byte_buffer, uint8_t number_of_bytes_to_read);
+
 //
 // Reads number_of_bytes_to_read bytes starting at register_number to byte_buffer.
 //
@@ -1103,6 +1113,27 @@ void i2c_write_byte(uint8_t addr, uint8_t byte) {
     i2c_stop();
 }
 
+bool i2c_write_burst(uint8_t addr, const uint8_t *byte_buffer, uint8_t number_of_bytes_to_write) {
+    bool tAck = i2c_start(addr);
+    for (uint8_t i = 0; tAck && i < number_of_bytes_to_write; i++) {
+        tAck = i2c_write(byte_buffer[i]);
+    }
+    i2c_stop();
+    return tAck;
+}
+
+bool i2c_read_burst(uint8_t addr, uint8_t *byte_buffer, uint8_t number_of_bytes_to_read) {
+    if (!i2c_start(addr | I2C_READ)) {
+        i2c_stop();
+        return false;
+    }
+    for (uint8_t i = 0; i < number_of_bytes_to_read; i++) {
+        byte_buffer[i] = i2c_read(i == number_of_bytes_to_read - 1); // NAK for last byte
+    }
+    i2c_stop();
+    return true;
+}
+
 void i2c_read_buffer_from_register(uint8_t addr, uint8_t register_number, uint8_t *byte_buffer, uint8_t number_of_bytes_to_read) {
     i2c_start(addr);
     i2c_write(register_number);
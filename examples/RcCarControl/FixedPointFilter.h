@@ -0,0 +1,82 @@
+/*
+ * FixedPointFilter.h
+ *
+ * Allocation free filter pipeline for integer sensor values, processed incrementally for each new sample.
+ * The pipeline consists of the optional stages median of N, 1D Kalman and exponential moving average (EMA),
+ * which are applied in this order. Median removes single spikes, Kalman and EMA smooth the remaining noise.
+ *
+ * Each input has its own FilterPipelineStruct, which is configured by initFilterPipeline().
+ * RAM is 21 bytes + 2 * FILTER_MEDIAN_MAX_SIZE per pipeline on AVR.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _FIXED_POINT_FILTER_H
+#define _FIXED_POINT_FILTER_H
+
+#include <stdint.h>
+
+#if !defined(FILTER_MEDIAN_MAX_SIZE)
+#define FILTER_MEDIAN_MAX_SIZE  5 // Maximum N for median of N
+#endif
+#define FILTER_KALMAN_ESTIMATE_SHIFT    4 // Kalman estimate has 4 fractional bits
+#define FILTER_KALMAN_GAIN_SHIFT        8 // Kalman gain is in 1/256
+
+struct MedianFilterStruct {
+    int16_t Values[FILTER_MEDIAN_MAX_SIZE]; // Ring buffer of last values
+    uint8_t Size;   // N, 0 -> stage disabled
+    uint8_t Index;  // Next index to write
+    uint8_t Count;  // Number of valid values, < Size only directly after init or reset
+};
+
+struct KalmanFilterStruct {
+    int32_t EstimateShifted;     // Estimated value << FILTER_KALMAN_ESTIMATE_SHIFT
+    uint32_t ErrorVariance;      // P, in (value units)^2
+    uint16_t ProcessNoise;       // Q, variance of the real change between 2 samples
+    uint16_t MeasurementNoise;   // R, variance of the sensor noise. 0 -> stage disabled
+};
+
+struct EMAFilterStruct {
+    int32_t ValueShifted; // Filtered value << WeightShift
+    uint8_t WeightShift;  // New value has weight 1 / 2^WeightShift, 0 -> stage disabled
+};
+
+struct FilterPipelineStruct {
+    MedianFilterStruct Median;
+    KalmanFilterStruct Kalman;
+    EMAFilterStruct EMA;
+    bool IsInitialized; // false -> next value initializes Kalman and EMA stages
+};
+
+/*
+ * @param aMedianSize - N for median of N, 0 or 1 disables median stage, must be <= FILTER_MEDIAN_MAX_SIZE
+ * @param aKalmanProcessNoise - Q, variance of the real value change between 2 samples in (value units)^2
+ * @param aKalmanMeasurementNoise - R, variance of the measurement noise in (value units)^2. 0 disables Kalman stage
+ * @param aEMAWeightShift - New value has weight 1 / 2^aEMAWeightShift. 0 disables EMA stage
+ */
+void initFilterPipeline(FilterPipelineStruct *aFilterPipeline, uint8_t aMedianSize, uint16_t aKalmanProcessNoise,
+        uint16_t aKalmanMeasurementNoise, uint8_t aEMAWeightShift);
+void resetFilterPipeline(FilterPipelineStruct *aFilterPipeline); // Clears history, keeps configuration
+int16_t processFilterPipeline(FilterPipelineStruct *aFilterPipeline, int16_t aValue); // returns filtered value
+
+int16_t processMedianFilter(MedianFilterStruct *aMedianFilter, int16_t aValue);
+int16_t processKalmanFilter(KalmanFilterStruct *aKalmanFilter, int16_t aValue);
+int16_t processEMAFilter(EMAFilterStruct *aEMAFilter, int16_t aValue);
+
+#endif // _FIXED_POINT_FILTER_H
@@ -0,0 +1,138 @@
+/*
+ * FixedPointFilter.hpp
+ *
+ * Implementation of the median of N, 1D Kalman and EMA filter pipeline.
+ * Only integer arithmetic, the Kalman stage requires one 32 bit division per sample.
+ *
+ * Usage:
+ *  FilterPipelineStruct sDistanceFilter;
+ *  setup() {
+ *      initFilterPipeline(&sDistanceFilter, 3, 0, 0, 2); // median of 3 and EMA with 1/4 weight
+ *  }
+ *  loop() {
+ *      tFilteredValue = processFilterPipeline(&sDistanceFilter, tValue);
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _FIXED_POINT_FILTER_HPP
+#define _FIXED_POINT_FILTER_HPP
+
+#include "FixedPointFilter.h"
+
+void initFilterPipeline(FilterPipelineStruct *aFilterPipeline, uint8_t aMedianSize, uint16_t aKalmanProcessNoise,
+        uint16_t aKalmanMeasurementNoise, uint8_t aEMAWeightShift) {
+    if (aMedianSize > FILTER_MEDIAN_MAX_SIZE) {
+        aMedianSize = FILTER_MEDIAN_MAX_SIZE;
+    }
+    if (aMedianSize == 1) {
+        aMedianSize = 0; // median of 1 is the value itself
+    }
+    aFilterPipeline->Median.Size = aMedianSize;
+    aFilterPipeline->Kalman.ProcessNoise = aKalmanProcessNoise;
+    aFilterPipeline->Kalman.MeasurementNoise = aKalmanMeasurementNoise;
+    aFilterPipeline->EMA.WeightShift = aEMAWeightShift;
+    resetFilterPipeline(aFilterPipeline);
+}
+
+void resetFilterPipeline(FilterPipelineStruct *aFilterPipeline) {
+    aFilterPipeline->Median.Index = 0;
+    aFilterPipeline->Median.Count = 0;
+    aFilterPipeline->IsInitialized = false;
+}
+
+/*
+ * Insertion sort of a copy of the ring buffer, which is fast for the small N used here.
+ * Directly after reset, the median of the values received so far is returned.
+ */
+int16_t processMedianFilter(MedianFilterStruct *aMedianFilter, int16_t aValue) {
+    aMedianFilter->Values[aMedianFilter->Index] = aValue;
+    aMedianFilter->Index++;
+    if (aMedianFilter->Index >= aMedianFilter->Size) {
+        aMedianFilter->Index = 0;
+    }
+    if (aMedianFilter->Count < aMedianFilter->Size) {
+        aMedianFilter->Count++;
+    }
+
+    int16_t tSortedValues[FILTER_MEDIAN_MAX_SIZE];
+    uint_fast8_t tCount = aMedianFilter->Count;
+    for (uint_fast8_t i = 0; i < tCount; ++i) {
+        int16_t tValue = aMedianFilter->Values[i];
+        uint_fast8_t j = i;
+        while (j > 0 && tSortedValues[j - 1] > tValue) {
+            tSortedValues[j] = tSortedValues[j - 1];
+            j--;
+        }
+        tSortedValues[j] = tValue;
+    }
+    return tSortedValues[tCount / 2];
+}
+
+/*
+ * 1D Kalman filter with constant value model.
+ * P = P + Q; K = P / (P + R); X = X + K * (Z - X); P = (1 - K) * P
+ * The gain converges to a constant, which is determined by the ratio of Q and R.
+ * Q / R = 1/4 gives K = 0.39 and Q / R = 1/16 gives K = 0.23.
+ * Q and R should be >= 16 to keep the rounding error of the integer variances small.
+ */
+int16_t processKalmanFilter(KalmanFilterStruct *aKalmanFilter, int16_t aValue) {
+    uint32_t tPredictedErrorVariance = aKalmanFilter->ErrorVariance + aKalmanFilter->ProcessNoise;
+    uint16_t tGain = (tPredictedErrorVariance << FILTER_KALMAN_GAIN_SHIFT)
+            / (tPredictedErrorVariance + aKalmanFilter->MeasurementNoise); // 0 to 256
+    int32_t tInnovationShifted = ((int32_t) aValue << FILTER_KALMAN_ESTIMATE_SHIFT) - aKalmanFilter->EstimateShifted;
+    aKalmanFilter->EstimateShifted += (tInnovationShifted * tGain) / (1 << FILTER_KALMAN_GAIN_SHIFT);
+    aKalmanFilter->ErrorVariance = tPredictedErrorVariance - ((tPredictedErrorVariance * tGain) >> FILTER_KALMAN_GAIN_SHIFT);
+    return (aKalmanFilter->EstimateShifted + (1 << (FILTER_KALMAN_ESTIMATE_SHIFT - 1))) >> FILTER_KALMAN_ESTIMATE_SHIFT;
+}
+
+/*
+ * Filtered = Filtered + (New - Filtered) / 2^WeightShift
+ */
+int16_t processEMAFilter(EMAFilterStruct *aEMAFilter, int16_t aValue) {
+    aEMAFilter->ValueShifted += aValue - (aEMAFilter->ValueShifted >> aEMAFilter->WeightShift);
+    return (aEMAFilter->ValueShifted + (1 << (aEMAFilter->WeightShift - 1))) >> aEMAFilter->WeightShift;
+}
+
+/*
+ * Applies median, Kalman and EMA stage, if enabled.
+ * The first value after init or reset initializes the Kalman and EMA stages, to avoid a slow ramp up from 0.
+ */
+int16_t processFilterPipeline(FilterPipelineStruct *aFilterPipeline, int16_t aValue) {
+    if (aFilterPipeline->Median.Size > 0) {
+        aValue = processMedianFilter(&aFilterPipeline->Median, aValue);
+    }
+    if (!aFilterPipeline->IsInitialized) {
+        aFilterPipeline->IsInitialized = true;
+        aFilterPipeline->Kalman.EstimateShifted = (int32_t) aValue << FILTER_KALMAN_ESTIMATE_SHIFT;
+        aFilterPipeline->Kalman.ErrorVariance = aFilterPipeline->Kalman.MeasurementNoise;
+        aFilterPipeline->EMA.ValueShifted = (int32_t) aValue << aFilterPipeline->EMA.WeightShift;
+        return aValue;
+    }
+    if (aFilterPipeline->Kalman.MeasurementNoise > 0) {
+        aValue = processKalmanFilter(&aFilterPipeline->Kalman, aValue);
+    }
+    if (aFilterPipeline->EMA.WeightShift > 0) {
+        aValue = processEMAFilter(&aFilterPipeline->EMA, aValue);
+    }
+    return aValue;
+}
+
+#endif // _FIXED_POINT_FILTER_HPP
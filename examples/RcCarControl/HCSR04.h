@@ -60,9 +60,10 @@ uint8_t getUSDistanceAsCentimeterWithCentimeterTimeoutPeriodicallyAndPrintIfChan
         unsigned int aMillisBetweenMeasurements, Print *aSerial);
 void testUSSensor(uint16_t aSecondsToTest);
 
-#if (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5))
+#if (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5)) \
+        && !defined(USE_HCSR04_SCANNER)
 /*
- * Non blocking version
+ * Non blocking version for one sensor. Not available with USE_HCSR04_SCANNER, which uses the same interrupt handlers.
  */
 void startUSDistanceAsCentimeterWithCentimeterTimeoutNonBlocking(unsigned int aTimeoutCentimeter);
 bool isUSDistanceMeasureFinished();
@@ -70,6 +71,60 @@ extern unsigned int sUSDistanceCentimeter;
 extern volatile unsigned long sUSPulseMicros;
 #endif
 
+#if defined(USE_HCSR04_SCANNER)
+/*
+ * Non blocking scanner for multiple sensors in 2 pin mode.
+ * The sensors are triggered one after another, to avoid crosstalk. The echo pulse is measured in the pin change ISR.
+ * Requires the USE_PIN_CHANGE_INTERRUPT_* macros for the ports of all echo pins.
+ */
+#  if !defined(HCSR04_SCANNER_MAX_NUMBER_OF_SENSORS)
+#define HCSR04_SCANNER_MAX_NUMBER_OF_SENSORS            4
+#  endif
+#  if !defined(HCSR04_SCANNER_DEFAULT_MILLIS_BETWEEN_TRIGGERS)
+#define HCSR04_SCANNER_DEFAULT_MILLIS_BETWEEN_TRIGGERS  20 // The echo of 3.43 meter has vanished. 3 sensors give one value each per 60 ms.
+#  endif
+#  if !defined(HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT)
+#define HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT      2 // Single timeouts are ignored, the filtered value is kept
+#  endif
+#define HCSR04_SCANNER_MICROS_UNTIL_ECHO_START        1000 // Echo starts 400/600 microseconds after end of trigger (old/new modules)
+#  if !defined(HCSR04_SCANNER_FILTER_SHIFT)
+#define HCSR04_SCANNER_FILTER_SHIFT                      2 // Exponential moving average with 1/4 weight for the new value. 0 -> raw values.
+#  endif
+#define HCSR04_SCANNER_NO_NEW_VALUE                   0xFF // Return value of handleUSDistanceScanner() and addUSDistanceScannerSensor()
+
+struct HCSR04SensorStruct {
+    uint8_t TriggerOutPin;
+    volatile uint8_t *EchoInPortInputRegister;
+    uint8_t EchoInPinMask;
+    volatile uint8_t *EchoInPCMSKRegister;
+    uint8_t EchoInPCMSKMask;
+    unsigned int FilteredCentimeterShifted; // Filtered distance << HCSR04_SCANNER_FILTER_SHIFT
+    unsigned int DistanceCentimeter;        // Filtered (or raw) distance or DISTANCE_TIMEOUT_RESULT
+    uint8_t NumberOfConsecutiveTimeouts;
+};
+
+struct HCSR04ScannerStruct {
+    uint8_t NumberOfSensors;
+    uint8_t ActiveSensorIndex; // Sensor currently measured or HCSR04_SCANNER_NO_NEW_VALUE
+    uint8_t NextSensorIndex;
+    uint8_t MillisBetweenTriggers;
+    unsigned int TimeoutMicros;
+    unsigned long LastTriggerMillis;
+    unsigned long MicrosAtTrigger;
+    volatile unsigned long MicrosAtStartOfPulse; // 0 if pulse has not yet started. Written by ISR.
+    volatile unsigned long PulseMicros;          // Written by ISR. Long, since no echo pulses of 200 ms must not wrap to valid values.
+    volatile bool PulseIsValid;                  // Written by ISR.
+    HCSR04SensorStruct Sensors[HCSR04_SCANNER_MAX_NUMBER_OF_SENSORS];
+};
+extern HCSR04ScannerStruct sUSDistanceScanner;
+
+uint8_t addUSDistanceScannerSensor(uint8_t aTriggerOutPin, uint8_t aEchoInPin); // returns sensor index
+void initUSDistanceScanner(unsigned int aTimeoutCentimeter, uint8_t aMillisBetweenTriggers =
+        HCSR04_SCANNER_DEFAULT_MILLIS_BETWEEN_TRIGGERS);
+uint8_t handleUSDistanceScanner(); // Call it in loop. Returns index of sensor with new value or HCSR04_SCANNER_NO_NEW_VALUE
+unsigned int getUSDistanceScannerCentimeter(uint8_t aSensorIndex);
+#endif // defined(USE_HCSR04_SCANNER)
+
 #define HCSR04_MODE_UNITITIALIZED   0
 #define HCSR04_MODE_USE_1_PIN       1
 #define HCSR04_MODE_USE_2_PINS      2
@@ -36,7 +36,13 @@
 #include "BlueDisplayUtils.hpp" // for printVCCAndTemperaturePeriodically()
 #endif
 
+#if defined(__AVR__)
+#define USE_PIN_CHANGE_INTERRUPT_D8_TO_D13 // ECHO_PIN is 8
+#define USE_HCSR04_SCANNER // Measure distance without blocking the event loop for up to 6 ms
+#define HCSR04_SCANNER_FILTER_SHIFT  0 // The median filter of sUSDistanceFilter requires raw values, it has its own moving average
+#endif
 #include "HCSR04.hpp"
+#include "FixedPointFilter.hpp"
 #include "Servo.h"
 
 /****************************************************************************
@@ -65,8 +71,7 @@ const int ECHO_PIN = 8;
 #define FOLLOWER_DISTANCE_DELTA_CENTIMETER           (FOLLOWER_DISTANCE_MAXIMUM_CENTIMETER - FOLLOWER_DISTANCE_MINIMUM_CENTIMETER)
 const int FOLLOWER_MAX_SPEED = 150; // empirical value
 
-#define FILTER_WEIGHT 4 // must be 2^n
-#define FILTER_WEIGHT_EXPONENT 2 // must be n of 2^n
+FilterPipelineStruct sUSDistanceFilter; // Median of 3 removes single wrong readings
 
 BDButton TouchButtonFollowerOnOff;
 BDSlider SliderShowUSDistance;
@@ -100,6 +105,17 @@ int sSensorChangeCallCountForZeroAdjustment;
 float sYZeroValueAdded; // The accumulator for the values of the first 8 calls.
 float sYZeroValue = 0;
 
+/*
+ * Sensor values are filtered in 1/100 m/s^2 units by median of 3 and Kalman filter.
+ * Noise of the accelerometer is around 0.1 m/s^2 => R = 10^2. Q = R / 4 gives a Kalman gain of 0.39.
+ * The smoothed values change less often, which saves slider redraws and therefore Bluetooth bandwidth.
+ */
+#define SENSOR_FILTER_MEDIAN_SIZE           3
+#define SENSOR_FILTER_PROCESS_NOISE        25
+#define SENSOR_FILTER_MEASUREMENT_NOISE   100
+FilterPipelineStruct sVerticalSensorFilter;
+FilterPipelineStruct sHorizontalSensorFilter;
+
 /*
  * Slider
  */
@@ -220,7 +236,7 @@ void initDisplay(void) {
     BlueDisplay1.setFlagsAndSize(BD_FLAG_FIRST_RESET_ALL | BD_FLAG_SCREEN_ORIENTATION_LOCK_CURRENT, sCurrentDisplayWidth, sCurrentDisplayHeight);
 
     sSensorChangeCallCountForZeroAdjustment = 0;
-    registerSensorChangeCallback(FLAG_SENSOR_TYPE_ACCELEROMETER, FLAG_SENSOR_DELAY_UI, FLAG_SENSOR_SIMPLE_FILTER, &doSensorChange);
+    registerSensorChangeCallback(FLAG_SENSOR_TYPE_ACCELEROMETER, FLAG_SENSOR_DELAY_UI, FLAG_SENSOR_NO_FILTER, &doSensorChange);
 
     SliderSpeed.init(0, sCurrentDisplayHeight / 32, sSliderWidth * 3, sSliderHeightLaser, sSliderHeightLaser,
             sSliderHeightLaser / 2, SLIDER_BACKGROUND_COLOR, SLIDER_BAR_COLOR, FLAG_SLIDER_VERTICAL_SHOW_NOTHING, &doLaserPosition);
@@ -295,7 +311,17 @@ void BDsetup() {
     pinMode(LEFT_PIN, OUTPUT);
     pinMode(LASER_POWER_PIN, OUTPUT);
 
+#if defined(USE_HCSR04_SCANNER)
+    addUSDistanceScannerSensor(TRIGGER_PIN, ECHO_PIN);
+    initUSDistanceScanner(100); // timeout at 1m, 50 measurements per second
+#else
     initUSDistancePins(TRIGGER_PIN, ECHO_PIN);
+#endif
+    initFilterPipeline(&sUSDistanceFilter, 3, 0, 0, 2); // median of 3 and moving average with 1/4 weight
+    initFilterPipeline(&sVerticalSensorFilter, SENSOR_FILTER_MEDIAN_SIZE, SENSOR_FILTER_PROCESS_NOISE,
+            SENSOR_FILTER_MEASUREMENT_NOISE, 0);
+    initFilterPipeline(&sHorizontalSensorFilter, SENSOR_FILTER_MEDIAN_SIZE, SENSOR_FILTER_PROCESS_NOISE,
+            SENSOR_FILTER_MEASUREMENT_NOISE, 0);
 
     digitalWrite(LASER_POWER_PIN, LaserOn);
     ServoLaser.write(90);
@@ -367,28 +393,43 @@ void BDloop() {
     /*
      * Measure distance
      */
+#if defined(USE_HCSR04_SCANNER)
+    if (handleUSDistanceScanner() != HCSR04_SCANNER_NO_NEW_VALUE) {
+        unsigned int tCentimeterNew = getUSDistanceScannerCentimeter(0);
+        if (tCentimeterNew == DISTANCE_TIMEOUT_RESULT) {
+            // Stop on timeout
+            resetOutputs();
+            // set value to "in range"
+            sDistanceCmFiltered = FOLLOWER_DISTANCE_MINIMUM_CENTIMETER + (FOLLOWER_DISTANCE_DELTA_CENTIMETER / 2);
+            resetFilterPipeline(&sUSDistanceFilter);
+        } else {
+            sDistanceCmFiltered = processFilterPipeline(&sUSDistanceFilter, tCentimeterNew);
+            if (sLastCentimeter != sDistanceCmFiltered) {
+                SliderShowUSDistance.setValueAndDrawBar(sDistanceCmFiltered);
+                sLastCentimeter = sDistanceCmFiltered;
+            }
+        }
+    }
+#else
     unsigned int tCentimeterNew = getUSDistanceAsCentimeter(US_DISTANCE_TIMEOUT_MICROS_FOR_1_METER); // timeout at 1m
     if (tCentimeterNew == 0) {
         // Stop on timeout
         resetOutputs();
-        // set filtered value to "in range"
-        sDistanceCmFiltered = (FOLLOWER_DISTANCE_MINIMUM_CENTIMETER + (FOLLOWER_DISTANCE_DELTA_CENTIMETER / 2))
-                << FILTER_WEIGHT_EXPONENT;
+        // set value to "in range"
+        sDistanceCmFiltered = FOLLOWER_DISTANCE_MINIMUM_CENTIMETER + (FOLLOWER_DISTANCE_DELTA_CENTIMETER / 2);
+        resetFilterPipeline(&sUSDistanceFilter);
     } else {
         /*
          * Filter distance value and show
          */
-        // tCurrentZeroCrossingCount = 3/4 * old
-        sDistanceCmFiltered *= (FILTER_WEIGHT - 1);
-        // + 1/4 * new
-        sDistanceCmFiltered += tCentimeterNew;
-        sDistanceCmFiltered = sDistanceCmFiltered >> FILTER_WEIGHT_EXPONENT;
+        sDistanceCmFiltered = processFilterPipeline(&sUSDistanceFilter, tCentimeterNew);
 
         if (sLastCentimeter != sDistanceCmFiltered) {
             SliderShowUSDistance.setValueAndDrawBar(sDistanceCmFiltered);
             sLastCentimeter = sDistanceCmFiltered;
         }
     }
+#endif
 
     if (sRCCarStarted) {
         /*
@@ -503,14 +544,14 @@ uint8_t speedOverflowAndDeadBandHandling(unsigned int aSpeed) {
 
 /*
  * Forward / backward speed
- * Values are in (m/s^2)
+ * Values are in (1/100 m/s^2) and zero compensated
  * positive -> backward / bottom down
  * negative -> forward  / top down
  */
-void processVerticalSensorValue(float tSensorValue) {
+void processVerticalSensorValue(int16_t aSensorValue) {
 
 // Scale value
-    int tSpeedValue = -((tSensorValue - sYZeroValue) * ((255 * 2) / 10));
+    int tSpeedValue = -(((long) aSensorValue * ((255 * 2) / 10)) / 100);
 
 // forward backward handling
     if (sLastSpeedSliderValue != tSpeedValue) {
@@ -544,13 +585,14 @@ void processVerticalSensorValue(float tSensorValue) {
 
 /*
  * Left / right coil
+ * Values are in (1/100 m/s^2)
  * positive -> left down
  * negative -> right down
  */
-void processHorizontalSensorValue(float tSensorValue) {
+void processHorizontalSensorValue(int16_t aSensorValue) {
 
 // scale value for full scale
-    int tLeftRightValue = tSensorValue * ((sHorizontalSliderLength * 3) / 10);
+    int tLeftRightValue = ((long) aSensorValue * ((sHorizontalSliderLength * 3) / 10)) / 100;
 
 // left right handling
     if (sLastHorizontalSliderValue != tLeftRightValue) {
@@ -594,11 +636,18 @@ void doSensorChange(uint8_t aSensorType, struct SensorCallback *aSensorCallbackI
         // compute zero value. Only Y values makes sense.
         sYZeroValue = sYZeroValueAdded / CALLS_FOR_ZERO_ADJUSTMENT;
         BlueDisplay1.playTone(24); // feedback for zero value acquired
+        resetFilterPipeline(&sVerticalSensorFilter);
+        resetFilterPipeline(&sHorizontalSensorFilter);
+        sSensorChangeCallCountForZeroAdjustment++; // start regular operation with next call
 
     } else {
+        // Filter always, to have a valid history if car is started again
+        int16_t tVerticalValue = processFilterPipeline(&sVerticalSensorFilter,
+                (aSensorCallbackInfo->ValueY - sYZeroValue) * 100);
+        int16_t tHorizontalValue = processFilterPipeline(&sHorizontalSensorFilter, aSensorCallbackInfo->ValueX * 100);
         if (sRCCarStarted && !sFollowerMode) {
-            processVerticalSensorValue(aSensorCallbackInfo->ValueY);
-            processHorizontalSensorValue(aSensorCallbackInfo->ValueX);
+            processVerticalSensorValue(tVerticalValue);
+            processHorizontalSensorValue(tHorizontalValue);
         }
     }
 }
@@ -1,7 +1,7 @@
 /*
  * ServoEasing.h
  *
- *  Copyright (C) 2019-2025  Armin Joachimsmeyer
+ *  Copyright (C) 2019-2026  Armin Joachimsmeyer
  *
  *  This file is part of ServoEasing https://github.com/ArminJo/ServoEasing.
  *
@@ -22,9 +22,9 @@
 #ifndef _SERVO_EASING_H
 #define _SERVO_EASING_H
 
-#define VERSION_SERVO_EASING "3.6.0"
+#define VERSION_SERVO_EASING "3.7.0"
 #define VERSION_SERVO_EASING_MAJOR 3
-#define VERSION_SERVO_EASING_MINOR 6
+#define VERSION_SERVO_EASING_MINOR 7
 #define VERSION_SERVO_EASING_PATCH 0
 // The change log is at the bottom of the file
 
@@ -160,6 +160,21 @@ extern void handleServoTimerInterrupt();
 #define I2C_CLOCK_FREQUENCY 800000 // 1 MHz from datasheet does not work for my Arduino Nano, maybe because of parasitic breadboard capacities
 #    endif
 #  endif
+/*
+ * Define `USE_PCA9685_BATCHED_WRITES` to write the new values of all servos connected to a PCA9685 at the end of updateAllServos().
+ * Adjacent channels with changed values are then written with one I2C transmission using the auto increment of the PCA9685,
+ * instead of one transmission per servo. This saves the device address and register bytes and the start and stop conditions
+ * for each channel and reduces the bus time, which is spent in the servo interrupt, for N adjacent servos by up to N times.
+ * Only channels with changed values are written, since update() writes only changed values.
+ */
+//#define USE_PCA9685_BATCHED_WRITES
+#  if !defined(PCA9685_MAX_CHANNELS_PER_BURST)
+#    if defined(USE_SOFT_I2C_MASTER)
+#define PCA9685_MAX_CHANNELS_PER_BURST  16
+#    else
+#define PCA9685_MAX_CHANNELS_PER_BURST  7 // (32 byte Wire buffer - 1 register byte) / 4 bytes per channel
+#    endif
+#  endif
 #endif // defined(USE_PCA9685_SERVO_EXPANDER)
 
 /*****************************************************************************************
@@ -206,6 +221,24 @@ extern void handleServoTimerInterrupt();
 //#define DISABLE_COMPLEX_FUNCTIONS
 #endif
 
+/*
+ * Define `USE_FIXED_POINT_EASING` to compute the included non linear easings with integer arithmetic and interpolated tables in PROGMEM
+ * instead of the float sin(), sqrt() and pow() functions. This makes update() much faster on CPUs without floating point unit like AVR,
+ * so more servos can be updated within the 20 ms refresh interval. Use printFixedPointEasingBenchmark() to see the gain and the deviation.
+ * USER and PRECISION easings still use float arithmetic.
+ * EASING_TABLE_INTERVALS_SHIFT selects the precision of the SINE, BACK and ELASTIC tables.
+ * 5 -> 33 table entries, 6 -> 65 entries, 7 -> 129 entries. Each entry requires 2 bytes program memory.
+ * The maximum deviation for ELASTIC is 2.9 %, 0.9 % and 0.3 % of the movement, for SINE and BACK it is below 0.2 %.
+ */
+#if !defined(USE_FIXED_POINT_EASING)
+//#define USE_FIXED_POINT_EASING
+#endif
+#if !defined(EASING_TABLE_INTERVALS_SHIFT)
+#define EASING_TABLE_INTERVALS_SHIFT    6 // 64 intervals
+#endif
+#define EASING_FIXED_POINT_SHIFT        14
+#define EASING_FIXED_POINT_ONE          (1 << EASING_FIXED_POINT_SHIFT) // 16384 is 1.0 for fixed point easing functions
+
 /*
  * If you need only the linear movement you may define `PROVIDE_ONLY_LINEAR_MOVEMENT`. This saves additional 1540 bytes program memory.
  */
@@ -254,6 +287,8 @@ extern void handleServoTimerInterrupt();
 #define DEFAULT_PCA9685_UNITS_FOR_90_DEGREE  (111 + ((491 - 111) / 2)) // 301 = 1472 us
 #define DEFAULT_PCA9685_UNITS_FOR_135_DEGREE (491 - ((491 - 111) / 4)) // 369
 #define DEFAULT_PCA9685_UNITS_FOR_180_DEGREE  491 // 491.52 = 2400 us
+// The start of the pulses is distributed over the 20 ms period
+#define PCA9685_START_UNITS_FOR_CHANNEL(aChannel) ((aChannel) * ((4096 - (DEFAULT_PCA9685_UNITS_FOR_180_DEGREE + 100)) / 15)) // aChannel * 233
 
 /*
  * Definitions for continuous rotating servo - Values are taken from the Parallax Continuous Rotation Servo manual
@@ -475,6 +510,9 @@ public:
     void I2CWriteByte(uint8_t aAddress, uint8_t aData);
     void setPWM(uint16_t aPWMOffValueAsUnits);
     void setPWM(uint16_t aPWMOnStartValueAsUnits, uint16_t aPWMPulseDurationAsUnits);
+#  if defined(USE_PCA9685_BATCHED_WRITES)
+    static void PCA9685WritePendingChannels();
+#  endif
     // main mapping functions for us to PCA9685 Units (20000/4096 = 4.88 us) and back
     int MicrosecondsToPCA9685Units(int aMicroseconds);
     int PCA9685UnitsToMicroseconds(int aPCA9685Units);
@@ -515,6 +553,11 @@ public:
     uint_fast8_t getEasingType();
 
     float callEasingFunction(float aPercentageOfCompletion);            // used in update()
+#  if defined(USE_FIXED_POINT_EASING)
+    static bool isFixedPointEasingType(uint_fast8_t aEasingType);
+    static int16_t callFixedPointEasingFunction(uint_fast8_t aEasingType, uint16_t aFactorOfTimeCompletion);
+    static int16_t computeFixedPointMovementCompletion(uint_fast8_t aEasingType, uint16_t aFactorOfTimeCompletion); // used in update()
+#  endif
 
 #  if defined(ENABLE_EASE_USER)
     void registerUserEaseInFunction(float (*aUserEaseInFunction)(float aPercentageOfCompletion, void *aUserDataPointer),
@@ -616,6 +659,20 @@ public:
     static float ElasticEaseIn(float aPercentageOfCompletion);
     // Non symmetric function
     static float EaseOutBounce(float aPercentageOfCompletion);
+#  if defined(USE_FIXED_POINT_EASING)
+    /*
+     * Fixed point versions. Input and output is EASING_FIXED_POINT_ONE for 1.0
+     */
+    static int16_t QuadraticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t CubicEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t QuarticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t SineEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t CircularEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t BackEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t ElasticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t EaseOutBounceFixedPoint(uint16_t aFactorOfTimeCompletion);
+    static int16_t interpolateEasingTable(const int16_t *aTablePGM, uint16_t aFactorOfTimeCompletion);
+#  endif
     // Special non static function
     float LinearWithQuadraticBounce(float aPercentageOfCompletion);
 
@@ -670,6 +727,10 @@ public:
 #  if !defined(USE_SOFT_I2C_MASTER)
     TwoWire *mI2CClass;
 #  endif
+#  if defined(USE_PCA9685_BATCHED_WRITES)
+    uint16_t mPCA9685PulseDurationAsUnits; // Value to be written by PCA9685WritePendingChannels()
+    bool mPCA9685WriteIsPending;
+#  endif
 #endif
     uint8_t mServoPin; ///< pin number / port number of PCA9685 [0-15] or NO_SERVO_ATTACHED_PIN_NUMBER - at least required for Lightweight Servo Library
 
@@ -717,6 +778,9 @@ public:
      * Using an dynamic array may be possible, but in this case we must first malloc(), then memcpy() and then free(), which leads to heap fragmentation.
      */
     static uint_fast8_t sServoArrayMaxIndex; ///< maximum index of an attached servo in sServoArray[]
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_PCA9685_BATCHED_WRITES)
+    static bool sPCA9685WritesAreBatched; ///< true during updateAllServos(), setPWM() then only stores the value
+#endif
     static ServoEasing *ServoEasingArray[MAX_EASING_SERVOS];
     static float ServoEasingNextPositionArray[MAX_EASING_SERVOS];
     /*
@@ -781,6 +845,10 @@ void disableServoEasingInterrupt();
 
 int clipDegreeSpecial(uint_fast8_t aDegreeToClip);
 
+#if defined(USE_FIXED_POINT_EASING) && !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
+void printFixedPointEasingBenchmark(Print *aSerial);
+#endif
+
 //extern float (*sEaseFunctionArray[])(float aPercentageOfCompletion);
 
 // Static convenience function
@@ -796,6 +864,11 @@ bool checkI2CConnection(uint8_t aI2CAddress, Stream *aSerial); // Print class ha
 #endif
 
 /*
+ *
+ * Version 3.7.0 - 10/2026
+ * - Added USE_PCA9685_BATCHED_WRITES to write all changed PCA9685 channels at the end of updateAllServos().
+ * - Added USE_FIXED_POINT_EASING to compute the included easings with integer arithmetic and interpolated PROGMEM tables.
+ * - Added function printFixedPointEasingBenchmark().
  *
  * Version 3.6.0 - 02/2026
  * - Renamed macro REFRESH_INTERVAL_MILLIS to SERVO_REFRESH_INTERVAL_MICROS.
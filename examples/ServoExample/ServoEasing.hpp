@@ -38,6 +38,8 @@
  * - DISABLE_COMPLEX_FUNCTIONS          Disables the SINE, CIRCULAR, BACK, ELASTIC, BOUNCE and PRECISION easings.
  * - MAX_EASING_SERVOS                  Saves 4 byte RAM per servo.
  * - DISABLE_MICROS_AS_DEGREE_PARAMETER Disables passing also microsecond values as (target angle) parameter. Saves 128 bytes program memory.
+ * - USE_PCA9685_BATCHED_WRITES         Write all changed PCA9685 channels at the end of updateAllServos() with one I2C transmission for adjacent channels.
+ * - USE_FIXED_POINT_EASING             Compute the included non linear easings with integer arithmetic and tables instead of float.
  * - PRINT_FOR_SERIAL_PLOTTER           Generate serial output for Arduino Plotter (Ctrl-Shift-L).
  */
 
@@ -152,6 +154,9 @@ volatile bool ServoEasing::sInterruptsAreActive = false; // true if interrupts a
  * Cannot use "static servo_t servos[MAX_SERVOS];" from Servo library since it is static :-(
  */
 uint_fast8_t ServoEasing::sServoArrayMaxIndex = 0; // maximum index of an attached servo in ServoEasing::ServoEasingArray[]
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_PCA9685_BATCHED_WRITES)
+bool ServoEasing::sPCA9685WritesAreBatched = false;
+#endif
 ServoEasing *ServoEasing::ServoEasingArray[MAX_EASING_SERVOS];
 /**
  * Used exclusively for *ForAllServos() functions. Is updated by write() or startEaseToD() function, to keep it synchronized.
@@ -208,6 +213,9 @@ ServoEasing::ServoEasing(uint8_t aPCA9685I2CAddress, TwoWire *aI2CClass) // @sup
 #if !defined(USE_SOFT_I2C_MASTER)
     mI2CClass = aI2CClass;
 #endif
+#if defined(USE_PCA9685_BATCHED_WRITES)
+    mPCA9685WriteIsPending = false;
+#endif
 
     // On an ESP8266 it was NOT initialized to 0 :-(.
     mTrimMicrosecondsOrUnits = 0;
@@ -370,6 +378,14 @@ void ServoEasing::setPWM(uint16_t aPWMOffValueAsUnits) {
  * Resolution of 4.88 us per unit.
  */
 void ServoEasing::setPWM(uint16_t aPWMOnStartValueAsUnits, uint16_t aPWMPulseDurationAsUnits) {
+#if defined(USE_PCA9685_BATCHED_WRITES)
+    if (sPCA9685WritesAreBatched) {
+        // Written later by PCA9685WritePendingChannels(), start value is always PCA9685_START_UNITS_FOR_CHANNEL(mServoPin)
+        mPCA9685PulseDurationAsUnits = aPWMPulseDurationAsUnits;
+        mPCA9685WriteIsPending = true;
+        return;
+    }
+#endif
 #if defined(USE_SOFT_I2C_MASTER)
     i2c_start(mPCA9685I2CAddress << 1);
     i2c_write((PCA9685_FIRST_PWM_REGISTER) + 4 * mServoPin);
@@ -399,6 +415,83 @@ void ServoEasing::setPWM(uint16_t aPWMOnStartValueAsUnits, uint16_t aPWMPulseDur
 #endif
 }
 
+#if defined(USE_PCA9685_BATCHED_WRITES)
+/**
+ * Is called at the end of updateAllServos() and writes the values stored by setPWM().
+ * For each expander, adjacent channels with pending values are written with one I2C transmission,
+ * since the PCA9685 is initialized with auto increment of the register address.
+ * 4 bytes per channel: ON_L, ON_H, OFF_L, OFF_H.
+ */
+void ServoEasing::PCA9685WritePendingChannels() {
+    for (uint_fast8_t tServoIndex = 0; tServoIndex <= sServoArrayMaxIndex; ++tServoIndex) {
+        ServoEasing *tServo = ServoEasingArray[tServoIndex];
+        if (tServo == nullptr || !tServo->mPCA9685WriteIsPending) {
+            continue;
+        }
+        /*
+         * Collect all pending servos of the expander of this servo, sorted by channel.
+         * The servos before tServoIndex have no pending values any more.
+         */
+        ServoEasing *tPendingServosOfExpander[PCA9685_MAX_CHANNELS] = { nullptr };
+        for (uint_fast8_t i = tServoIndex; i <= sServoArrayMaxIndex; ++i) {
+            ServoEasing *tOtherServo = ServoEasingArray[i];
+            if (tOtherServo != nullptr && tOtherServo->mPCA9685WriteIsPending
+                    && tOtherServo->mPCA9685I2CAddress == tServo->mPCA9685I2CAddress
+#  if !defined(USE_SOFT_I2C_MASTER)
+                    && tOtherServo->mI2CClass == tServo->mI2CClass
+#  endif
+                    ) {
+                tPendingServosOfExpander[tOtherServo->mServoPin] = tOtherServo;
+            }
+        }
+
+        uint_fast8_t tChannel = 0;
+        while (tChannel < PCA9685_MAX_CHANNELS) {
+            if (tPendingServosOfExpander[tChannel] == nullptr) {
+                tChannel++;
+                continue;
+            }
+            /*
+             * Start of a block of adjacent channels
+             */
+#  if defined(USE_SOFT_I2C_MASTER)
+            i2c_start(tServo->mPCA9685I2CAddress << 1);
+            i2c_write(PCA9685_FIRST_PWM_REGISTER + 4 * tChannel);
+#  else
+            tServo->mI2CClass->beginTransmission(tServo->mPCA9685I2CAddress);
+            tServo->mI2CClass->write(PCA9685_FIRST_PWM_REGISTER + 4 * tChannel);
+#  endif
+            uint_fast8_t tNumberOfChannelsInBurst = 0;
+            do {
+                ServoEasing *tChannelServo = tPendingServosOfExpander[tChannel];
+                uint16_t tOnValue = PCA9685_START_UNITS_FOR_CHANNEL(tChannel);
+                uint16_t tOffValue = tOnValue + tChannelServo->mPCA9685PulseDurationAsUnits;
+#  if defined(USE_SOFT_I2C_MASTER)
+                i2c_write(tOnValue);
+                i2c_write(tOnValue >> 8);
+                i2c_write(tOffValue);
+                i2c_write(tOffValue >> 8);
+#  else
+                tServo->mI2CClass->write(tOnValue);
+                tServo->mI2CClass->write(tOnValue >> 8);
+                tServo->mI2CClass->write(tOffValue);
+                tServo->mI2CClass->write(tOffValue >> 8);
+#  endif
+                tChannelServo->mPCA9685WriteIsPending = false;
+                tChannel++;
+                tNumberOfChannelsInBurst++;
+            } while (tChannel < PCA9685_MAX_CHANNELS && tPendingServosOfExpander[tChannel] != nullptr
+                    && tNumberOfChannelsInBurst < PCA9685_MAX_CHANNELS_PER_BURST);
+#  if defined(USE_SOFT_I2C_MASTER)
+            i2c_stop();
+#  else
+            tServo->mI2CClass->endTransmission();
+#  endif
+        }
+    }
+}
+#endif // defined(USE_PCA9685_BATCHED_WRITES)
+
 int ServoEasing::MicrosecondsToPCA9685Units(int aMicroseconds) {
     /*
      * 4096 units per 20 milliseconds => aMicroseconds / 4.8828
@@ -438,6 +531,9 @@ ServoEasing::ServoEasing() // @suppress("Class members should be properly initia
 #if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_SERVO_LIB)
     mServoIsConnectedToExpander = false;
 #endif
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_PCA9685_BATCHED_WRITES)
+    mPCA9685WriteIsPending = false; // Servos not connected to an expander are never pending
+#endif
 #if !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
     mEasingType = EASE_LINEAR;
 #  if defined(ENABLE_EASE_USER)
@@ -735,6 +831,16 @@ void ServoEasing::detach() {
         }
 
 #if defined(USE_PCA9685_SERVO_EXPANDER)
+#  if defined(USE_PCA9685_BATCHED_WRITES)
+        /*
+         * A detached servo is no longer written by PCA9685WritePendingChannels().
+         * So drop a pending value, which would otherwise be written after the next attach,
+         * and write the off signal below immediately, even if detach() is called during updateAllServos().
+         */
+        mPCA9685WriteIsPending = false;
+        bool tWritesAreBatched = sPCA9685WritesAreBatched;
+        sPCA9685WritesAreBatched = false;
+#  endif
 #  if defined(USE_SERVO_LIB)
         if (mServoIsConnectedToExpander) {
             setPWM(0); // set signal fully off
@@ -748,6 +854,9 @@ void ServoEasing::detach() {
 #  else
         setPWM(0); // set signal fully off
 #  endif // defined(USE_SERVO_LIB)
+#  if defined(USE_PCA9685_BATCHED_WRITES)
+        sPCA9685WritesAreBatched = tWritesAreBatched;
+#  endif
 
 #else
 #  if defined(USE_LIGHTWEIGHT_SERVO_LIBRARY)
@@ -967,11 +1076,11 @@ void ServoEasing::_writeMicrosecondsOrUnits(int aTargetMicrosecondsOrUnits) {
 #  if defined(LOCAL_TRACE)
     // For each pin show PWM on value used below
     Serial.print(F(" s="));
-    Serial.print(mServoPin * (4096 - (DEFAULT_PCA9685_UNITS_FOR_180_DEGREE + 100)) / 15); // mServoPin * 233
+    Serial.print(PCA9685_START_UNITS_FOR_CHANNEL(mServoPin));
 #  endif
 #  if defined(USE_SERVO_LIB)
     if (mServoIsConnectedToExpander) {
-        setPWM(mServoPin * ((4096 - (DEFAULT_PCA9685_UNITS_FOR_180_DEGREE + 100)) / 15), aTargetMicrosecondsOrUnits); // First parameter is: mServoPin * 233
+        setPWM(PCA9685_START_UNITS_FOR_CHANNEL(mServoPin), aTargetMicrosecondsOrUnits);
     } else {
 #    if defined(USE_LIGHTWEIGHT_SERVO_LIBRARY)
         writeMicrosecondsLightweightServo(aTargetMicrosecondsOrUnits, (mServoPin == LIGHTWEIGHT_SERVO_CHANNEL_A_PIN));
@@ -984,7 +1093,7 @@ void ServoEasing::_writeMicrosecondsOrUnits(int aTargetMicrosecondsOrUnits) {
      * Distribute the servo start time over the 20 ms period.
      * Unexpectedly this even saves 20 bytes Flash for an ATmega328P
      */
-    setPWM(mServoPin * ((4096 - (DEFAULT_PCA9685_UNITS_FOR_180_DEGREE + 100)) / 15), aTargetMicrosecondsOrUnits); // mServoPin * 233
+    setPWM(PCA9685_START_UNITS_FOR_CHANNEL(mServoPin), aTargetMicrosecondsOrUnits);
 #  endif
 
 #else
@@ -1600,6 +1709,17 @@ bool ServoEasing::update() {
          */
         tNewMicrosecondsOrUnits = mStartMicrosecondsOrUnits
                 + ((mDeltaMicrosecondsOrUnits * (int32_t) tMillisSinceStart) / (int32_t) mMillisForCompleteMove);
+#  if defined(USE_FIXED_POINT_EASING)
+    } else if (isFixedPointEasingType(mEasingType)) {
+        /*
+         * Use integer arithmetic and interpolated tables for the included easing functions.
+         * tMillisSinceStart < mMillisForCompleteMove <= 0xFFFF, so shift by 14 fits in 32 bit.
+         */
+        uint16_t tFactorOfTimeCompletion = ((uint32_t) tMillisSinceStart << EASING_FIXED_POINT_SHIFT) / mMillisForCompleteMove;
+        int32_t tFactorOfMovementCompletion = computeFixedPointMovementCompletion(mEasingType, tFactorOfTimeCompletion);
+        tNewMicrosecondsOrUnits = mStartMicrosecondsOrUnits
+                + (((mDeltaMicrosecondsOrUnits * tFactorOfMovementCompletion) + (EASING_FIXED_POINT_ONE / 2)) >> EASING_FIXED_POINT_SHIFT);
+#  endif
     } else {
         /*
          * Non linear movement -> use floats
@@ -1752,6 +1872,97 @@ float ServoEasing::callEasingFunction(float aFactorOfTimeCompletion) {
     }
 }
 
+#  if defined(USE_FIXED_POINT_EASING)
+/**
+ * @return false for USER and PRECISION easing, which require float arithmetic
+ */
+bool ServoEasing::isFixedPointEasingType(uint_fast8_t aEasingType) {
+    aEasingType &= EASE_TYPE_MASK;
+#    if defined(ENABLE_EASE_USER)
+    if (aEasingType == EASE_USER_DIRECT) {
+        return false;
+    }
+#    endif
+#    if defined(ENABLE_EASE_PRECISION)
+    if (aEasingType == EASE_PRECISION_IN) {
+        return false;
+    }
+#    endif
+    return true;
+}
+
+/**
+ * Fixed point version of the call style handling in update(). See comment "The different easing functions" in ServoEasing.h.
+ * @param aFactorOfTimeCompletion - 0 to EASING_FIXED_POINT_ONE
+ * @return FactorOfMovementCompletion, EASING_FIXED_POINT_ONE is 1.0
+ */
+int16_t ServoEasing::computeFixedPointMovementCompletion(uint_fast8_t aEasingType, uint16_t aFactorOfTimeCompletion) {
+    uint_fast8_t tCallStyle = aEasingType & CALL_STYLE_MASK;
+
+    if (tCallStyle == CALL_STYLE_DIRECT) { // CALL_STYLE_IN
+        return callFixedPointEasingFunction(aEasingType, aFactorOfTimeCompletion);
+
+    } else if (tCallStyle == CALL_STYLE_OUT) {
+        return EASING_FIXED_POINT_ONE - callFixedPointEasingFunction(aEasingType, EASING_FIXED_POINT_ONE - aFactorOfTimeCompletion);
+
+    } else if (aFactorOfTimeCompletion <= (EASING_FIXED_POINT_ONE / 2)) {
+        if (tCallStyle == CALL_STYLE_IN_OUT) {
+            return callFixedPointEasingFunction(aEasingType, 2 * aFactorOfTimeCompletion) / 2;
+        }
+        // CALL_STYLE_BOUNCING_OUT_IN
+        return EASING_FIXED_POINT_ONE - callFixedPointEasingFunction(aEasingType, EASING_FIXED_POINT_ONE - (2 * aFactorOfTimeCompletion));
+
+    } else {
+        if (tCallStyle == CALL_STYLE_IN_OUT) {
+            // 2 * (ONE - x) instead of (2 * ONE) - (2 * x), since 2 * EASING_FIXED_POINT_ONE overflows a 16 bit int
+            return EASING_FIXED_POINT_ONE
+                    - (callFixedPointEasingFunction(aEasingType, 2 * (EASING_FIXED_POINT_ONE - aFactorOfTimeCompletion)) / 2);
+        }
+        // CALL_STYLE_BOUNCING_OUT_IN
+        return EASING_FIXED_POINT_ONE - callFixedPointEasingFunction(aEasingType, (2 * aFactorOfTimeCompletion) - EASING_FIXED_POINT_ONE);
+    }
+}
+
+int16_t ServoEasing::callFixedPointEasingFunction(uint_fast8_t aEasingType, uint16_t aFactorOfTimeCompletion) {
+    switch (aEasingType & EASE_TYPE_MASK) {
+#    if defined(ENABLE_EASE_QUADRATIC)
+    case EASE_QUADRATIC_IN:
+        return QuadraticEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_CUBIC)
+    case EASE_CUBIC_IN:
+        return CubicEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_QUARTIC)
+    case EASE_QUARTIC_IN:
+        return QuarticEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_SINE)
+    case EASE_SINE_IN:
+        return SineEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_CIRCULAR)
+    case EASE_CIRCULAR_IN:
+        return CircularEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_BACK)
+    case EASE_BACK_IN:
+        return BackEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_ELASTIC)
+    case EASE_ELASTIC_IN:
+        return ElasticEaseInFixedPoint(aFactorOfTimeCompletion);
+#    endif
+#    if defined(ENABLE_EASE_BOUNCE)
+    case EASE_BOUNCE_OUT:
+        return EaseOutBounceFixedPoint(aFactorOfTimeCompletion);
+#    endif
+    default:
+        return 0;
+    }
+}
+#  endif // defined(USE_FIXED_POINT_EASING)
+
 #endif //PROVIDE_ONLY_LINEAR_MOVEMENT
 
 /**
@@ -2631,12 +2842,19 @@ bool updateAllServos() {
 //    Serial.print(F("ua "));
 #endif
 
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_PCA9685_BATCHED_WRITES)
+    ServoEasing::sPCA9685WritesAreBatched = true;
+#endif
     bool tAllServosStopped = true;
     for (uint_fast8_t tServoIndex = 0; tServoIndex <= ServoEasing::sServoArrayMaxIndex; ++tServoIndex) {
         if (ServoEasing::ServoEasingArray[tServoIndex] != nullptr) {
             tAllServosStopped = ServoEasing::ServoEasingArray[tServoIndex]->update() && tAllServosStopped;
         }
     }
+#if defined(USE_PCA9685_SERVO_EXPANDER) && defined(USE_PCA9685_BATCHED_WRITES)
+    ServoEasing::sPCA9685WritesAreBatched = false;
+    ServoEasing::PCA9685WritePendingChannels();
+#endif
 #if defined(PRINT_FOR_SERIAL_PLOTTER)
     Serial.println(); // End of one complete data set
 #endif
@@ -2903,6 +3121,302 @@ float ServoEasing::EaseOutBounce(float aFactorOfTimeCompletion) {
     }
     return tFactorOfMovementCompletion;
 }
+
+#  if defined(USE_FIXED_POINT_EASING)
+/*********************************************************
+ * Fixed point versions of the included easing functions
+ * Input is from 0 to EASING_FIXED_POINT_ONE for 0 % to 100% completion of time
+ * Output is EASING_FIXED_POINT_ONE for 100% completion of movement
+ * SINE, BACK and ELASTIC use a table with (1 << EASING_TABLE_INTERVALS_SHIFT) + 1 values
+ * of the float function, which is linear interpolated. The tables are generated by:
+ * for (i = 0; i <= (1 << EASING_TABLE_INTERVALS_SHIFT); i++) round(EaseIn(i / (1 << EASING_TABLE_INTERVALS_SHIFT)) * EASING_FIXED_POINT_ONE)
+ ********************************************************/
+#    if EASING_TABLE_INTERVALS_SHIFT == 5
+const int16_t SineEaseInTable[] PROGMEM = {
+        0, 20, 79, 177, 315, 491, 705, 958, 1247, 1573, 1935, 2331,
+        2761, 3224, 3719, 4244, 4799, 5381, 5990, 6624, 7282, 7961, 8661, 9379,
+        10114, 10864, 11628, 12403, 13188, 13980, 14778, 15580, 16384
+};
+const int16_t BackEaseInTable[] PROGMEM = {
+        0, -50, -196, -432, -752, -1144, -1599, -2102, -2640, -3198, -3757, -4301,
+        -4812, -5271, -5658, -5956, -6144, -6206, -6123, -5880, -5461, -4852, -4042, -3019,
+        -1777, -308, 1392, 3325, 5490, 7884, 10503, 13340, 16384
+};
+const int16_t ElasticEaseInTable[] PROGMEM = {
+        0, 12, 24, 29, 21, -2, -37, -71, -84, -58, 14, 116,
+        211, 242, 156, -60, -362, -629, -696, -419, 238, 1121, 1869, 2000,
+        1108, -874, -3453, -5540, -5728, -2882, 3084, 10597, 16384
+};
+#    elif EASING_TABLE_INTERVALS_SHIFT == 6
+const int16_t SineEaseInTable[] PROGMEM = {
+        0, 5, 20, 44, 79, 123, 177, 241, 315, 398, 491, 593,
+        705, 827, 958, 1098, 1247, 1406, 1573, 1749, 1935, 2128, 2331, 2542,
+        2761, 2989, 3224, 3468, 3719, 3978, 4244, 4518, 4799, 5087, 5381, 5682,
+        5990, 6304, 6624, 6950, 7282, 7619, 7961, 8308, 8661, 9018, 9379, 9745,
+        10114, 10487, 10864, 11245, 11628, 12014, 12403, 12794, 13188, 13583, 13980, 14378,
+        14778, 15179, 15580, 15982, 16384
+};
+const int16_t BackEaseInTable[] PROGMEM = {
+        0, -12, -50, -111, -196, -303, -432, -582, -752, -940, -1144, -1365,
+        -1599, -1845, -2102, -2368, -2640, -2918, -3198, -3478, -3757, -4032, -4301, -4562,
+        -4812, -5049, -5271, -5475, -5658, -5819, -5956, -6065, -6144, -6192, -6206, -6183,
+        -6123, -6022, -5880, -5693, -5461, -5181, -4852, -4473, -4042, -3558, -3019, -2426,
+        -1777, -1071, -308, 513, 1392, 2329, 3325, 4378, 5490, 6659, 7884, 9166,
+        10503, 11895, 13340, 14837, 16384
+};
+const int16_t ElasticEaseInTable[] PROGMEM = {
+        0, 6, 12, 18, 24, 27, 29, 27, 21, 11, -2, -19,
+        -37, -55, -71, -81, -84, -76, -58, -27, 14, 63, 116, 168,
+        211, 238, 242, 216, 156, 63, -60, -207, -362, -510, -629, -698,
+        -696, -607, -419, -134, 238, 669, 1121, 1541, 1869, 2042, 2000, 1698,
+        1108, 237, -874, -2144, -3453, -4644, -5540, -5958, -5728, -4723, -2882, -234,
+        3084, 6817, 10597, 13960, 16384
+};
+#    elif EASING_TABLE_INTERVALS_SHIFT == 7
+const int16_t SineEaseInTable[] PROGMEM = {
+        0, 1, 5, 11, 20, 31, 44, 60, 79, 100, 123, 149,
+        177, 208, 241, 277, 315, 355, 398, 443, 491, 541, 593, 648,
+        705, 765, 827, 891, 958, 1027, 1098, 1171, 1247, 1325, 1406, 1488,
+        1573, 1660, 1749, 1841, 1935, 2030, 2128, 2229, 2331, 2435, 2542, 2651,
+        2761, 2874, 2989, 3105, 3224, 3345, 3468, 3592, 3719, 3847, 3978, 4110,
+        4244, 4380, 4518, 4657, 4799, 4942, 5087, 5233, 5381, 5531, 5682, 5835,
+        5990, 6146, 6304, 6463, 6624, 6786, 6950, 7115, 7282, 7449, 7619, 7789,
+        7961, 8134, 8308, 8484, 8661, 8839, 9018, 9198, 9379, 9561, 9745, 9929,
+        10114, 10300, 10487, 10676, 10864, 11054, 11245, 11436, 11628, 11821, 12014, 12208,
+        12403, 12598, 12794, 12991, 13188, 13385, 13583, 13781, 13980, 14179, 14378, 14578,
+        14778, 14978, 15179, 15379, 15580, 15781, 15982, 16183, 16384
+};
+const int16_t BackEaseInTable[] PROGMEM = {
+        0, -3, -12, -28, -50, -77, -111, -151, -196, -247, -303, -365,
+        -432, -505, -582, -665, -752, -843, -940, -1040, -1144, -1253, -1365, -1480,
+        -1599, -1721, -1845, -1972, -2102, -2234, -2368, -2503, -2640, -2778, -2918, -3057,
+        -3198, -3338, -3478, -3618, -3757, -3895, -4032, -4168, -4301, -4433, -4562, -4689,
+        -4812, -4933, -5049, -5162, -5271, -5375, -5475, -5569, -5658, -5742, -5819, -5891,
+        -5956, -6014, -6065, -6108, -6144, -6172, -6192, -6203, -6206, -6199, -6183, -6158,
+        -6123, -6078, -6022, -5956, -5880, -5792, -5693, -5583, -5461, -5327, -5181, -5023,
+        -4852, -4669, -4473, -4264, -4042, -3806, -3558, -3295, -3019, -2730, -2426, -2109,
+        -1777, -1431, -1071, -697, -308, 96, 513, 945, 1392, 1854, 2329, 2820,
+        3325, 3844, 4378, 4927, 5490, 6067, 6659, 7264, 7884, 8518, 9166, 9828,
+        10503, 11192, 11895, 12611, 13340, 14082, 14837, 15604, 16384
+};
+const int16_t ElasticEaseInTable[] PROGMEM = {
+        0, 3, 6, 9, 12, 15, 18, 21, 24, 26, 27, 29,
+        29, 28, 27, 25, 21, 17, 11, 5, -2, -10, -19, -28,
+        -37, -46, -55, -63, -71, -77, -81, -83, -84, -81, -76, -69,
+        -58, -44, -27, -8, 14, 38, 63, 90, 116, 143, 168, 191,
+        211, 227, 238, 243, 242, 233, 216, 190, 156, 114, 63, 5,
+        -60, -131, -207, -284, -362, -438, -510, -574, -629, -671, -698, -707,
+        -696, -663, -607, -526, -419, -288, -134, 42, 238, 448, 669, 895,
+        1121, 1338, 1541, 1720, 1869, 1979, 2042, 2051, 2000, 1884, 1698, 1439,
+        1108, 706, 237, -292, -874, -1496, -2144, -2803, -3453, -4074, -4644, -5141,
+        -5540, -5820, -5958, -5933, -5728, -5328, -4723, -3907, -2882, -1653, -234, 1354,
+        3084, 4919, 6817, 8728, 10597, 12362, 13960, 15323, 16384
+};
+#    else
+#error EASING_TABLE_INTERVALS_SHIFT must be 5, 6 or 7
+#    endif
+
+#define EASING_TABLE_FRACTION_SHIFT (EASING_FIXED_POINT_SHIFT - EASING_TABLE_INTERVALS_SHIFT)
+
+int16_t ServoEasing::interpolateEasingTable(const int16_t *aTablePGM, uint16_t aFactorOfTimeCompletion) {
+    uint_fast8_t tIndex = aFactorOfTimeCompletion >> EASING_TABLE_FRACTION_SHIFT;
+    int16_t tStartValue = pgm_read_word(&aTablePGM[tIndex]);
+    if (tIndex >= (1 << EASING_TABLE_INTERVALS_SHIFT)) {
+        return tStartValue; // 100 % or more
+    }
+    int16_t tDelta = (int16_t) pgm_read_word(&aTablePGM[tIndex + 1]) - tStartValue;
+    uint16_t tFraction = aFactorOfTimeCompletion & ((1 << EASING_TABLE_FRACTION_SHIFT) - 1);
+    return tStartValue + (int16_t) (((int32_t) tDelta * tFraction) >> EASING_TABLE_FRACTION_SHIFT);
+}
+
+int16_t ServoEasing::QuadraticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return ((uint32_t) aFactorOfTimeCompletion * aFactorOfTimeCompletion) >> EASING_FIXED_POINT_SHIFT;
+}
+
+int16_t ServoEasing::CubicEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return ((uint32_t) aFactorOfTimeCompletion * (uint16_t) QuadraticEaseInFixedPoint(aFactorOfTimeCompletion)) >> EASING_FIXED_POINT_SHIFT;
+}
+
+int16_t ServoEasing::QuarticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return QuadraticEaseInFixedPoint(QuadraticEaseInFixedPoint(aFactorOfTimeCompletion));
+}
+
+int16_t ServoEasing::SineEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return interpolateEasingTable(SineEaseInTable, aFactorOfTimeCompletion);
+}
+
+/**
+ * 1 - sqrt(1 - x^2) with a bitwise integer square root, since the slope at 100% is infinite and cannot be interpolated.
+ * 14 loops for a 28 bit value.
+ */
+int16_t ServoEasing::CircularEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    uint32_t tRadicand = ((uint32_t) EASING_FIXED_POINT_ONE * EASING_FIXED_POINT_ONE)
+            - ((uint32_t) aFactorOfTimeCompletion * aFactorOfTimeCompletion);
+    uint32_t tRoot = 0;
+    uint32_t tBit = 1UL << (2 * EASING_FIXED_POINT_SHIFT);
+    while (tBit > tRadicand) {
+        tBit >>= 2;
+    }
+    while (tBit != 0) {
+        if (tRadicand >= tRoot + tBit) {
+            tRadicand -= tRoot + tBit;
+            tRoot = (tRoot >> 1) + tBit;
+        } else {
+            tRoot >>= 1;
+        }
+        tBit >>= 2;
+    }
+    return EASING_FIXED_POINT_ONE - tRoot;
+}
+
+int16_t ServoEasing::BackEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return interpolateEasingTable(BackEaseInTable, aFactorOfTimeCompletion);
+}
+
+int16_t ServoEasing::ElasticEaseInFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    return interpolateEasingTable(ElasticEaseInTable, aFactorOfTimeCompletion);
+}
+
+/**
+ * Same polynomials as in EaseOutBounce(). Coefficients are multiplied by 4096, constants by EASING_FIXED_POINT_ONE.
+ * The bounces are not interpolated, since they have sharp edges.
+ */
+int16_t ServoEasing::EaseOutBounceFixedPoint(uint16_t aFactorOfTimeCompletion) {
+    int32_t tFactor = aFactorOfTimeCompletion;
+    int32_t tSquare = (tFactor * tFactor) >> EASING_FIXED_POINT_SHIFT;
+    if (aFactorOfTimeCompletion < 5958) { // 4 / 11
+        return (121 * tSquare) >> 4; // 121 / 16
+    } else if (aFactorOfTimeCompletion < 11916) { // 8 / 11
+        return (((37171 * tSquare) - (40550 * tFactor)) >> 12) + 55706; // 363 / 40, 99 / 10, 17 / 5
+    } else if (aFactorOfTimeCompletion < 14746) { // 9 / 10
+        return (((49424 * tSquare) - (80427 * tFactor)) >> 12) + 145786; // 4356 / 361, 35442 / 1805, 16061 / 1805
+    } else {
+        return (((44237 * tSquare) - (84050 * tFactor)) >> 12) + 175636; // 54 / 5, 513 / 25, 268 / 25
+    }
+}
+
+#    if defined(ARDUINO)
+/*
+ * Float version of callFixedPointEasingFunction(), used for the benchmark
+ */
+float callIncludedEasingFunction(uint_fast8_t aEasingType, float aFactorOfTimeCompletion) {
+    switch (aEasingType) {
+#      if defined(ENABLE_EASE_QUADRATIC)
+    case EASE_QUADRATIC_IN:
+        return ServoEasing::QuadraticEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_CUBIC)
+    case EASE_CUBIC_IN:
+        return ServoEasing::CubicEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_QUARTIC)
+    case EASE_QUARTIC_IN:
+        return ServoEasing::QuarticEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_SINE)
+    case EASE_SINE_IN:
+        return ServoEasing::SineEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_CIRCULAR)
+    case EASE_CIRCULAR_IN:
+        return ServoEasing::CircularEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_BACK)
+    case EASE_BACK_IN:
+        return ServoEasing::BackEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_ELASTIC)
+    case EASE_ELASTIC_IN:
+        return ServoEasing::ElasticEaseIn(aFactorOfTimeCompletion);
+#      endif
+#      if defined(ENABLE_EASE_BOUNCE)
+    case EASE_BOUNCE_OUT:
+        return ServoEasing::EaseOutBounce(aFactorOfTimeCompletion);
+#      endif
+    default:
+        return 0.0;
+    }
+}
+
+/**
+ * Prints for each included easing function the microseconds for one call of the float and the fixed point version
+ * and the maximum deviation of the fixed point version in per mille of the movement.
+ */
+void printFixedPointEasingBenchmark(Print *aSerial) {
+    static const uint8_t sEasingTypes[] = {
+#      if defined(ENABLE_EASE_QUADRATIC)
+            EASE_QUADRATIC_IN,
+#      endif
+#      if defined(ENABLE_EASE_CUBIC)
+            EASE_CUBIC_IN,
+#      endif
+#      if defined(ENABLE_EASE_QUARTIC)
+            EASE_QUARTIC_IN,
+#      endif
+#      if defined(ENABLE_EASE_SINE)
+            EASE_SINE_IN,
+#      endif
+#      if defined(ENABLE_EASE_CIRCULAR)
+            EASE_CIRCULAR_IN,
+#      endif
+#      if defined(ENABLE_EASE_BACK)
+            EASE_BACK_IN,
+#      endif
+#      if defined(ENABLE_EASE_ELASTIC)
+            EASE_ELASTIC_IN,
+#      endif
+#      if defined(ENABLE_EASE_BOUNCE)
+            EASE_BOUNCE_OUT,
+#      endif
+            };
+#define NUMBER_OF_BENCHMARK_STEPS   64
+
+    for (uint_fast8_t i = 0; i < sizeof(sEasingTypes); ++i) {
+        uint_fast8_t tEasingType = sEasingTypes[i];
+        volatile float tFloatResult; // volatile to avoid optimizing away the calls
+        volatile int16_t tFixedPointResult;
+
+        float tFactorOfTimeCompletion = 0.0;
+        uint32_t tStartMicros = micros();
+        for (uint_fast8_t j = 0; j <= NUMBER_OF_BENCHMARK_STEPS; ++j) {
+            tFloatResult = callIncludedEasingFunction(tEasingType, tFactorOfTimeCompletion);
+            tFactorOfTimeCompletion += 1.0 / NUMBER_OF_BENCHMARK_STEPS;
+        }
+        uint32_t tFloatMicros = micros() - tStartMicros;
+
+        uint16_t tFactor = 0;
+        tStartMicros = micros();
+        for (uint_fast8_t j = 0; j <= NUMBER_OF_BENCHMARK_STEPS; ++j) {
+            tFixedPointResult = ServoEasing::callFixedPointEasingFunction(tEasingType, tFactor);
+            tFactor += EASING_FIXED_POINT_ONE / NUMBER_OF_BENCHMARK_STEPS;
+        }
+        uint32_t tFixedPointMicros = micros() - tStartMicros;
+
+        /*
+         * Deviation is checked with a finer resolution than the tables
+         */
+        float tMaxDeviation = 0.0;
+        for (tFactor = 0; tFactor <= EASING_FIXED_POINT_ONE; tFactor += 16) {
+            tFloatResult = callIncludedEasingFunction(tEasingType, (float) tFactor / EASING_FIXED_POINT_ONE);
+            tFixedPointResult = ServoEasing::callFixedPointEasingFunction(tEasingType, tFactor);
+            float tDeviation = fabs(tFloatResult - ((float) tFixedPointResult / EASING_FIXED_POINT_ONE));
+            if (tMaxDeviation < tDeviation) {
+                tMaxDeviation = tDeviation;
+            }
+        }
+
+        ServoEasing::printEasingType(aSerial, tEasingType);
+        aSerial->print(F(": float="));
+        aSerial->print((float) tFloatMicros / (NUMBER_OF_BENCHMARK_STEPS + 1));
+        aSerial->print(F(" us, fixed point="));
+        aSerial->print((float) tFixedPointMicros / (NUMBER_OF_BENCHMARK_STEPS + 1));
+        aSerial->print(F(" us, max deviation="));
+        aSerial->print(tMaxDeviation * 1000, 1);
+        aSerial->println(F(" per mille"));
+    }
+}
+#    endif // defined(ARDUINO)
+#  endif // defined(USE_FIXED_POINT_EASING)
 #endif // !defined(PROVIDE_ONLY_LINEAR_MOVEMENT)
 
 /************************************
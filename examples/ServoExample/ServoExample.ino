@@ -34,6 +34,7 @@
 
 #include <Arduino.h>
 
+#define USE_FIXED_POINT_EASING // Use integer arithmetic instead of float for the easing functions, allows to update more servos in 20 ms
 #include "ServoEasing.hpp" // for smooth auto moving
 
 /*
@@ -0,0 +1,75 @@
+/*
+ * SensorRecorder.h
+ *
+ * Compact binary recording of the sensor values received by the sensor change callback.
+ * Records are stored in a RAM ring buffer and can be flushed to a serial port.
+ * The recording can be replayed off-device by the SensorReplay tool, which calls handleEvent() with the recorded values.
+ *
+ * Format of one flushed block, all values little endian:
+ *  Header:  "BDSR", uint8_t format version, uint8_t value scale, uint16_t number of records
+ *  Records: uint16_t sensor type (upper 3 bits) and millis since previous record (lower 13 bits), int16_t X, Y, Z * value scale
+ * The first record of a block contains the delay to the last record of the previous block,
+ * so consecutively flushed blocks can be concatenated to one recording.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _SENSOR_RECORDER_H
+#define _SENSOR_RECORDER_H
+
+#include <stdint.h>
+
+#if !defined(SENSOR_RECORDER_NUMBER_OF_RECORDS)
+#  if defined(__AVR__) && RAMEND <= 0x8FF
+#define SENSOR_RECORDER_NUMBER_OF_RECORDS   32 // 256 bytes RAM
+#  else
+#define SENSOR_RECORDER_NUMBER_OF_RECORDS   128
+#  endif
+#endif
+
+#define SENSOR_RECORDER_MAGIC               "BDSR"
+#define SENSOR_RECORDER_FORMAT_VERSION      1
+#define SENSOR_RECORDER_VALUE_SCALE         100 // Values are stored in 1/100 m/s^2 or 1/100 rad/s, i.e. range is +/-327
+#define SENSOR_RECORDER_HEADER_SIZE         8
+#define SENSOR_RECORDER_RECORD_SIZE         8
+
+#define SENSOR_RECORDER_TYPE_SHIFT          13
+#define SENSOR_RECORDER_DELTA_MILLIS_MASK   0x1FFF // Longer pauses are recorded as 8191 ms
+
+struct SensorRecordStruct {
+    uint16_t TypeAndDeltaMillis;
+    int16_t Values[3]; // X, Y, Z * SENSOR_RECORDER_VALUE_SCALE
+};
+
+struct SensorRecorderStruct {
+    SensorRecordStruct Records[SENSOR_RECORDER_NUMBER_OF_RECORDS];
+    uint16_t NextIndex;         // Index of next record to write
+    uint16_t NumberOfRecords;   // Number of valid records
+    uint32_t LastRecordMillis;  // 0 -> no record yet
+};
+
+#if defined(ARDUINO)
+extern SensorRecorderStruct sSensorRecorder;
+
+void recordSensorValues(uint8_t aSensorType, struct SensorCallback *aSensorCallbackInfo);
+bool isSensorRecorderFull();
+void flushSensorRecorder(Print *aSerial); // Writes all records, oldest first, and clears the buffer
+#endif
+
+#endif // _SENSOR_RECORDER_H
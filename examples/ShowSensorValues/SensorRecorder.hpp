@@ -0,0 +1,124 @@
+/*
+ * SensorRecorder.hpp
+ *
+ * Implementation of the binary sensor value recorder.
+ * Recording takes no float division, only 3 multiplications and float to int conversions.
+ *
+ * Usage:
+ *  void doSensorChange(uint8_t aSensorType, struct SensorCallback *aSensorCallbackInfo) {
+ *      recordSensorValues(aSensorType, aSensorCallbackInfo);
+ *  }
+ *  loop() {
+ *      if (isSensorRecorderFull()) {
+ *          flushSensorRecorder(&Serial);
+ *      }
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _SENSOR_RECORDER_HPP
+#define _SENSOR_RECORDER_HPP
+
+#include "SensorRecorder.h"
+
+SensorRecorderStruct sSensorRecorder;
+
+/*
+ * Clip to int16 range and round
+ */
+int16_t convertSensorValueToFixedPoint(float aValue) {
+    aValue *= SENSOR_RECORDER_VALUE_SCALE;
+    if (aValue >= 32767.0) {
+        return 32767;
+    }
+    if (aValue <= -32767.0) {
+        return -32767;
+    }
+    if (aValue < 0) {
+        return aValue - 0.5;
+    }
+    return aValue + 0.5;
+}
+
+/*
+ * If buffer is full, the oldest record is overwritten
+ */
+void recordSensorValues(uint8_t aSensorType, struct SensorCallback *aSensorCallbackInfo) {
+    uint32_t tMillis = millis();
+    uint32_t tDeltaMillis = 0;
+    if (sSensorRecorder.LastRecordMillis != 0) {
+        tDeltaMillis = tMillis - sSensorRecorder.LastRecordMillis;
+        if (tDeltaMillis > SENSOR_RECORDER_DELTA_MILLIS_MASK) {
+            tDeltaMillis = SENSOR_RECORDER_DELTA_MILLIS_MASK;
+        }
+    }
+    sSensorRecorder.LastRecordMillis = tMillis;
+
+    SensorRecordStruct *tRecord = &sSensorRecorder.Records[sSensorRecorder.NextIndex];
+    tRecord->TypeAndDeltaMillis = ((uint16_t) aSensorType << SENSOR_RECORDER_TYPE_SHIFT) | tDeltaMillis;
+    tRecord->Values[0] = convertSensorValueToFixedPoint(aSensorCallbackInfo->ValueX);
+    tRecord->Values[1] = convertSensorValueToFixedPoint(aSensorCallbackInfo->ValueY);
+    tRecord->Values[2] = convertSensorValueToFixedPoint(aSensorCallbackInfo->ValueZ);
+
+    sSensorRecorder.NextIndex++;
+    if (sSensorRecorder.NextIndex >= SENSOR_RECORDER_NUMBER_OF_RECORDS) {
+        sSensorRecorder.NextIndex = 0;
+    }
+    if (sSensorRecorder.NumberOfRecords < SENSOR_RECORDER_NUMBER_OF_RECORDS) {
+        sSensorRecorder.NumberOfRecords++;
+    }
+}
+
+bool isSensorRecorderFull() {
+    return sSensorRecorder.NumberOfRecords >= SENSOR_RECORDER_NUMBER_OF_RECORDS;
+}
+
+void writeSensorRecorderWord(Print *aSerial, uint16_t aWord) {
+    aSerial->write((uint8_t) aWord);
+    aSerial->write((uint8_t) (aWord >> 8));
+}
+
+/*
+ * Writes header and records as little endian, independent of the CPU.
+ * Keeps LastRecordMillis, so the next block continues the time line.
+ */
+void flushSensorRecorder(Print *aSerial) {
+    aSerial->print(F(SENSOR_RECORDER_MAGIC));
+    aSerial->write((uint8_t) SENSOR_RECORDER_FORMAT_VERSION);
+    aSerial->write((uint8_t) SENSOR_RECORDER_VALUE_SCALE);
+    writeSensorRecorderWord(aSerial, sSensorRecorder.NumberOfRecords);
+
+    uint16_t tIndex = sSensorRecorder.NextIndex + (SENSOR_RECORDER_NUMBER_OF_RECORDS - sSensorRecorder.NumberOfRecords);
+    for (uint16_t i = 0; i < sSensorRecorder.NumberOfRecords; ++i) {
+        if (tIndex >= SENSOR_RECORDER_NUMBER_OF_RECORDS) {
+            tIndex -= SENSOR_RECORDER_NUMBER_OF_RECORDS;
+        }
+        SensorRecordStruct *tRecord = &sSensorRecorder.Records[tIndex];
+        writeSensorRecorderWord(aSerial, tRecord->TypeAndDeltaMillis);
+        writeSensorRecorderWord(aSerial, tRecord->Values[0]);
+        writeSensorRecorderWord(aSerial, tRecord->Values[1]);
+        writeSensorRecorderWord(aSerial, tRecord->Values[2]);
+        tIndex++;
+    }
+    sSensorRecorder.NumberOfRecords = 0;
+    sSensorRecorder.NextIndex = 0;
+}
+
+#endif // _SENSOR_RECORDER_HPP
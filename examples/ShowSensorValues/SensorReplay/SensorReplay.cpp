@@ -0,0 +1,161 @@
+/*
+ * SensorReplay.cpp
+ *
+ * Linux tool to replay a recording of SensorRecorder.hpp by calling handleEvent() with the recorded sensor events.
+ * Data between the recorded blocks, like the text output of the program, is skipped.
+ * This enables to benchmark and test sensor driven code like the RcCarControl example with real motion data off-device.
+ *
+ * Without other sources, the recorded values are printed as CSV by the weak default handleEvent() below.
+ *  g++ -O2 -o SensorReplay SensorReplay.cpp
+ * To test your own code, compile it together with this file and provide handleEvent() or the sensor callback called by it.
+ *  g++ -O2 -o SensorTest SensorReplay.cpp MyTest.cpp
+ *
+ * Usage: SensorReplay <recording file> [speed factor]
+ *  Speed factor 1 (default) replays with original timing, 10 replays 10 times faster and 0 replays without any delay.
+ * Recording from serial:
+ *  stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > Sensor.rec
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../SensorRecorder.h"
+#include "../../../src/BlueDisplayProtocol.h"
+
+extern "C" void handleEvent(struct BluetoothEvent *aEvent);
+
+/*
+ * Default handler, prints milliseconds since start of replay, sensor type and values
+ */
+uint32_t sReplayMillis;
+extern "C" __attribute__((weak)) void handleEvent(struct BluetoothEvent *aEvent) {
+    struct SensorCallback *tSensorCallbackInfo = &aEvent->EventData.SensorCallbackInfo;
+    printf("%u;%d;%.2f;%.2f;%.2f\n", (unsigned int) sReplayMillis, aEvent->EventType - EVENT_FIRST_SENSOR_ACTION_CODE,
+            tSensorCallbackInfo->ValueX, tSensorCallbackInfo->ValueY, tSensorCallbackInfo->ValueZ);
+}
+
+uint16_t readWord(FILE *aFile) {
+    uint16_t tWord = getc(aFile);
+    tWord |= getc(aFile) << 8;
+    return tWord;
+}
+
+/*
+ * Scan for magic, which can be preceded by arbitrary text or data
+ * @return true if header was found
+ */
+bool findBlockHeader(FILE *aFile, uint8_t *aValueScale, uint16_t *aNumberOfRecords) {
+    const char *tMagic = SENSOR_RECORDER_MAGIC;
+    uint8_t tMatchedLength = 0;
+    int tCharacter;
+    while ((tCharacter = getc(aFile)) != EOF) {
+        if (tCharacter == tMagic[tMatchedLength]) {
+            tMatchedLength++;
+            if (tMatchedLength == strlen(SENSOR_RECORDER_MAGIC)) {
+                uint8_t tVersion = getc(aFile);
+                *aValueScale = getc(aFile);
+                *aNumberOfRecords = readWord(aFile);
+                if (tVersion == SENSOR_RECORDER_FORMAT_VERSION && *aValueScale != 0 && !feof(aFile)) {
+                    return true;
+                }
+                tMatchedLength = 0;
+            }
+        } else {
+            tMatchedLength = (tCharacter == tMagic[0]) ? 1 : 0;
+        }
+    }
+    return false;
+}
+
+void sleepMillis(uint32_t aMillis) {
+    struct timespec tSleepTime;
+    tSleepTime.tv_sec = aMillis / 1000;
+    tSleepTime.tv_nsec = (aMillis % 1000) * 1000000L;
+    nanosleep(&tSleepTime, nullptr);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <recording file> [speed factor, 0 -> no delay]\n", argv[0]);
+        return 1;
+    }
+    FILE *tFile = fopen(argv[1], "rb");
+    if (tFile == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    uint32_t tSpeedFactor = 1;
+    if (argc > 2) {
+        tSpeedFactor = strtoul(argv[2], nullptr, 10);
+    }
+
+    uint32_t tNumberOfEvents = 0;
+    bool tIsFirstRecord = true;
+    uint32_t tSleepMillisRemainder = 0; // Accumulates deltas which are too small for a sleep at high speed factors
+    struct BluetoothEvent tEvent;
+    uint8_t tValueScale;
+    uint16_t tNumberOfRecords;
+
+    struct timespec tStartTime, tEndTime;
+    clock_gettime(CLOCK_MONOTONIC, &tStartTime);
+    while (findBlockHeader(tFile, &tValueScale, &tNumberOfRecords)) {
+        for (uint16_t i = 0; i < tNumberOfRecords; ++i) {
+            uint16_t tTypeAndDeltaMillis = readWord(tFile);
+            int16_t tValueX = readWord(tFile);
+            int16_t tValueY = readWord(tFile);
+            int16_t tValueZ = readWord(tFile);
+            if (feof(tFile)) {
+                fprintf(stderr, "Recording is truncated\n");
+                break;
+            }
+            uint16_t tDeltaMillis = tTypeAndDeltaMillis & SENSOR_RECORDER_DELTA_MILLIS_MASK;
+            if (tIsFirstRecord) {
+                tIsFirstRecord = false;
+                tDeltaMillis = 0; // is undefined if ring buffer was overwritten
+            }
+            sReplayMillis += tDeltaMillis;
+            if (tSpeedFactor > 0) {
+                tSleepMillisRemainder += tDeltaMillis;
+                if (tSleepMillisRemainder >= tSpeedFactor) {
+                    sleepMillis(tSleepMillisRemainder / tSpeedFactor);
+                    tSleepMillisRemainder %= tSpeedFactor;
+                }
+            }
+
+            tEvent.EventType = EVENT_FIRST_SENSOR_ACTION_CODE + (tTypeAndDeltaMillis >> SENSOR_RECORDER_TYPE_SHIFT);
+            tEvent.EventData.SensorCallbackInfo.ValueX = (float) tValueX / tValueScale;
+            tEvent.EventData.SensorCallbackInfo.ValueY = (float) tValueY / tValueScale;
+            tEvent.EventData.SensorCallbackInfo.ValueZ = (float) tValueZ / tValueScale;
+            handleEvent(&tEvent);
+            tNumberOfEvents++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tEndTime);
+    fclose(tFile);
+
+    uint32_t tReplayMillis = (tEndTime.tv_sec - tStartTime.tv_sec) * 1000 + (tEndTime.tv_nsec - tStartTime.tv_nsec) / 1000000;
+    fprintf(stderr, "Replayed %u events of %u ms recording in %u ms\n", (unsigned int) tNumberOfEvents,
+            (unsigned int) sReplayMillis, (unsigned int) tReplayMillis);
+    return 0;
+}
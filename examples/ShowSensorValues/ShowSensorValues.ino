@@ -75,6 +75,19 @@
 #undef SHOW_GYROSCOPE_VALUES_ON_PLOTTER
 #endif
 
+/*
+ * Record the received sensor values in a RAM ring buffer. See SensorRecorder.h for the binary format.
+ * If Serial is not used by BlueDisplay and not for plotter output, the full buffer is written to Serial.
+ * Use SensorReplay/SensorReplay.cpp to replay the recording on Linux.
+ */
+//#define USE_SENSOR_RECORDER
+#if defined(USE_SENSOR_RECORDER)
+#include "SensorRecorder.hpp"
+#  if (defined(BD_USE_SERIAL1) || defined(ESP32)) && !(defined(SHOW_ACCELEROMETER_VALUES_ON_PLOTTER) || defined(SHOW_GYROSCOPE_VALUES_ON_PLOTTER))
+#define FLUSH_SENSOR_RECORDER_TO_SERIAL
+#  endif
+#endif
+
 #define DISPLAY_WIDTH  DISPLAY_HALF_VGA_WIDTH  // 320
 #define DISPLAY_HEIGHT DISPLAY_HALF_VGA_HEIGHT // 215
 
@@ -202,6 +215,11 @@ void setup() {
 
 void loop() {
     checkAndHandleEvents();
+#if defined(FLUSH_SENSOR_RECORDER_TO_SERIAL)
+    if (isSensorRecorderFull()) {
+        flushSensorRecorder(&Serial);
+    }
+#endif
 }
 
 /*
@@ -304,6 +322,9 @@ void doGyroscopeChange(struct SensorCallback *aSensorCallbackInfo) {
 }
 
 void doSensorChange(uint8_t aSensorType, struct SensorCallback *aSensorCallbackInfo) {
+#if defined(USE_SENSOR_RECORDER)
+    recordSensorValues(aSensorType, aSensorCallbackInfo);
+#endif
     if (aSensorType == FLAG_SENSOR_TYPE_ACCELEROMETER) {
         doAccelerometerChange(aSensorCallbackInfo);
     } else {
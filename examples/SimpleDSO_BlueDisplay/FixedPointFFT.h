@@ -0,0 +1,70 @@
+/*
+ * FixedPointFFT.h
+ *
+ * Fixed point radix-2 FFT of real 8 bit (display) values, with windowing and magnitude in dB.
+ * The N real values are transformed by a N/2 point complex FFT and a final split step,
+ * which halves the RAM and time required.
+ *
+ * AVR: 128 values, 16 bit values with scaling at each stage, log2 approximation for dB. Working buffers need 256 bytes stack.
+ * Others: 512 values, 32 bit values with 64 bit products and no scaling, log10f() for dB.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-Simple-DSO https://github.com/ArminJo/Arduino-Simple-DSO.
+ *
+ *  Arduino-Simple-DSO is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _FIXED_POINT_FFT_H
+#define _FIXED_POINT_FFT_H
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#define FFT_NUMBER_OF_SAMPLES   128
+#define FFT_INPUT_SHIFT         6 // 9 bit signed input -> 15 bit
+typedef int16_t fft_value_t;
+#else
+#define FFT_NUMBER_OF_SAMPLES   512
+#define FFT_INPUT_SHIFT         12
+typedef int32_t fft_value_t;
+#endif
+#define FFT_NUMBER_OF_BINS      (FFT_NUMBER_OF_SAMPLES / 2)
+
+// values for window
+#define FFT_WINDOW_RECTANGLE    0
+#define FFT_WINDOW_HANN         1
+#define FFT_WINDOW_HAMMING      2
+#define FFT_WINDOW_BLACKMAN     3
+#define FFT_NUMBER_OF_WINDOWS   4
+
+/*
+ * @param aInputValues - FFT_NUMBER_OF_SAMPLES inverted display values, i.e. (DISPLAY_VALUE_FOR_ZERO - 8BitValue)
+ * @param aOutputHalfDB - FFT_NUMBER_OF_BINS magnitudes in 0.5 dB units, clipped to 0 to 255.
+ *                        May be the same as aInputValues, since input is copied before.
+ */
+void computeFFTMagnitudeHalfDB(const uint8_t *aInputValues, uint8_t *aOutputHalfDB, uint8_t aWindow);
+
+/*
+ * @return Index of bin with maximum value, excluding DC bin 0
+ */
+uint16_t getFFTPeakBin(const uint8_t *aHalfDBValues);
+
+/*
+ * Parabolic interpolation of peak on the dB values
+ * @return Peak position in 1/256 bins
+ */
+uint32_t getFFTInterpolatedPeakBinShift8(const uint8_t *aHalfDBValues, uint16_t aPeakBin);
+
+#endif // _FIXED_POINT_FFT_H
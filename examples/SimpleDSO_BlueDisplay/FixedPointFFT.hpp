@@ -0,0 +1,266 @@
+/*
+ * FixedPointFFT.hpp
+ *
+ * Implementation of the fixed point FFT declared in FixedPointFFT.h
+ *
+ * The N real values x[n] are packed into N/2 complex values z[m] = x[2m] + i * x[2m+1].
+ * After the N/2 point complex FFT, the spectrum of the real values is computed by the split step
+ *   X[k] = E[k] + W^k * O[k] with E[k] = (Z[k] + conj(Z[N/2-k])) / 2 and O[k] = (Z[k] - conj(Z[N/2-k])) / 2i
+ *
+ * The magnitude is in units of 0.5 dB relative to an amplitude of one display value.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-Simple-DSO https://github.com/ArminJo/Arduino-Simple-DSO.
+ *
+ *  Arduino-Simple-DSO is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _FIXED_POINT_FFT_HPP
+#define _FIXED_POINT_FFT_HPP
+
+#include "FixedPointFFT.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+typedef int32_t fft_product_t;
+#define FFT_READ_SINE_TABLE(aIndex) ((int16_t) pgm_read_word(&FFTSineQuarterTable[aIndex]))
+#else
+#include <math.h> // for log10f()
+#if !defined(PROGMEM)
+#define PROGMEM
+#endif
+typedef int64_t fft_product_t;
+#define FFT_READ_SINE_TABLE(aIndex) (FFTSineQuarterTable[aIndex])
+#endif
+
+#define FFT_QUARTER_PERIOD      (FFT_NUMBER_OF_SAMPLES / 4)
+// Multiplication with Q15 twiddle or window value
+#define FFT_MULTIPLY_Q15(aValue, aQ15Value) ((fft_value_t) (((fft_product_t) (aValue) * (aQ15Value)) >> 15))
+
+/*
+ * sin(2 * PI * i / FFT_NUMBER_OF_SAMPLES) * 32767 for the first quarter period including PI / 2
+ */
+const int16_t FFTSineQuarterTable[FFT_QUARTER_PERIOD + 1] PROGMEM = {
+#if defined(__AVR__)
+        0, 1608, 3212, 4808, 6393, 7962, 9512, 11039, 12539, 14010, 15446, 16846, 18204, 19519, 20787, 22005, 23170, 24279,
+        25329, 26319, 27245, 28105, 28898, 29621, 30273, 30852, 31356, 31785, 32137, 32412, 32609, 32728, 32767
+#else
+        0, 402, 804, 1206, 1608, 2009, 2410, 2811, 3212, 3612, 4011, 4410, 4808, 5205, 5602, 5998, 6393, 6786, 7179, 7571, 7962,
+        8351, 8739, 9126, 9512, 9896, 10278, 10659, 11039, 11417, 11793, 12167, 12539, 12910, 13279, 13645, 14010, 14372, 14732,
+        15090, 15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869, 18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475,
+        20787, 21096, 21403, 21705, 22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072, 25329,
+        25582, 25832, 26077, 26319, 26556, 26790, 27019, 27245, 27466, 27683, 27896, 28105, 28310, 28510, 28706, 28898, 29085,
+        29268, 29447, 29621, 29791, 29956, 30117, 30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237, 31356, 31470, 31580,
+        31685, 31785, 31880, 31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567, 32609, 32646, 32678, 32705,
+        32728, 32745, 32757, 32765, 32767
+#endif
+        };
+
+/*
+ * @param aIndex - Angle in units of 2 * PI / FFT_NUMBER_OF_SAMPLES
+ * @return Q15 value
+ */
+int16_t getFFTSine(uint16_t aIndex) {
+    aIndex &= (FFT_NUMBER_OF_SAMPLES - 1);
+    if (aIndex <= FFT_QUARTER_PERIOD) {
+        return FFT_READ_SINE_TABLE(aIndex);
+    }
+    if (aIndex <= 2 * FFT_QUARTER_PERIOD) {
+        return FFT_READ_SINE_TABLE((2 * FFT_QUARTER_PERIOD) - aIndex);
+    }
+    if (aIndex <= 3 * FFT_QUARTER_PERIOD) {
+        return -FFT_READ_SINE_TABLE(aIndex - (2 * FFT_QUARTER_PERIOD));
+    }
+    return -FFT_READ_SINE_TABLE(FFT_NUMBER_OF_SAMPLES - aIndex);
+}
+
+int16_t getFFTCosine(uint16_t aIndex) {
+    return getFFTSine(aIndex + FFT_QUARTER_PERIOD);
+}
+
+/*
+ * Periodic window functions, computed from the sine table to save program memory
+ * @return Q15 value
+ */
+int16_t getFFTWindowValue(uint16_t aIndex, uint8_t aWindow) {
+    int16_t tCosine = getFFTCosine(aIndex);
+    if (aWindow == FFT_WINDOW_HANN) {
+        // 0.5 - 0.5 cos
+        return (32767 - (int32_t) tCosine) / 2;
+    } else if (aWindow == FFT_WINDOW_HAMMING) {
+        // 0.54 - 0.46 cos. 17694 instead of 17695 to avoid overflow.
+        return 17694 - (int16_t) (((int32_t) tCosine * 15073) >> 15);
+    } else if (aWindow == FFT_WINDOW_BLACKMAN) {
+        // 0.42 - 0.5 cos + 0.08 cos(2x)
+        return 13763 - (tCosine / 2) + (int16_t) (((int32_t) getFFTCosine(2 * aIndex) * 2621) >> 15);
+    }
+    return 32767;
+}
+
+#if defined(__AVR__)
+/*
+ * 20 * log10(aSquare) using the position of the most significant bit and the 4 following bits as linear mantissa.
+ * Error is below 0.1 dB.
+ */
+uint8_t getHalfDBFromSquare(uint32_t aSquare) {
+    if (aSquare == 0) {
+        return 0;
+    }
+    uint8_t tExponent = 31;
+    while (!(aSquare & 0x80000000)) {
+        aSquare <<= 1;
+        tExponent--;
+    }
+    uint16_t tLog2Times16 = (tExponent << 4) | ((aSquare >> 27) & 0x0F);
+    // 20 * log10(2) / 16 = 0.3763 = 385 / 1024
+    return ((uint32_t) tLog2Times16 * 385) >> 10;
+}
+#endif
+
+void computeFFTMagnitudeHalfDB(const uint8_t *aInputValues, uint8_t *aOutputHalfDB, uint8_t aWindow) {
+    fft_value_t tReal[FFT_NUMBER_OF_BINS];
+    fft_value_t tImag[FFT_NUMBER_OF_BINS];
+
+    /*
+     * Remove DC, apply window and pack even values to real and odd values to imaginary part
+     */
+    uint32_t tSum = 0;
+    for (uint16_t i = 0; i < FFT_NUMBER_OF_SAMPLES; ++i) {
+        tSum += aInputValues[i];
+    }
+    int16_t tMean = (tSum + (FFT_NUMBER_OF_SAMPLES / 2)) / FFT_NUMBER_OF_SAMPLES;
+    for (uint16_t i = 0; i < FFT_NUMBER_OF_SAMPLES; ++i) {
+        fft_value_t tValue = ((fft_value_t) aInputValues[i] - tMean) * (1 << FFT_INPUT_SHIFT);
+        if (aWindow != FFT_WINDOW_RECTANGLE) {
+            tValue = FFT_MULTIPLY_Q15(tValue, getFFTWindowValue(i, aWindow));
+        }
+        if (i & 0x01) {
+            tImag[i / 2] = tValue;
+        } else {
+            tReal[i / 2] = tValue;
+        }
+    }
+
+    /*
+     * Bit reversal
+     */
+    uint16_t j = 0;
+    for (uint16_t i = 1; i < FFT_NUMBER_OF_BINS; ++i) {
+        uint16_t tBit = FFT_NUMBER_OF_BINS / 2;
+        while (j & tBit) {
+            j ^= tBit;
+            tBit >>= 1;
+        }
+        j ^= tBit;
+        if (i < j) {
+            fft_value_t tTemp = tReal[i];
+            tReal[i] = tReal[j];
+            tReal[j] = tTemp;
+            tTemp = tImag[i];
+            tImag[i] = tImag[j];
+            tImag[j] = tTemp;
+        }
+    }
+
+    /*
+     * Radix-2 decimation in time butterflies.
+     * For AVR each stage is divided by 2, so the 16 bit values can not overflow.
+     */
+    for (uint16_t tLength = 2; tLength <= FFT_NUMBER_OF_BINS; tLength <<= 1) {
+        uint16_t tHalfLength = tLength / 2;
+        uint16_t tTwiddleStep = FFT_NUMBER_OF_SAMPLES / tLength;
+        for (uint16_t k = 0; k < tHalfLength; ++k) {
+            // twiddle factor is cos - i * sin
+            int16_t tCosine = getFFTCosine(k * tTwiddleStep);
+            int16_t tSine = getFFTSine(k * tTwiddleStep);
+            for (uint16_t i = k; i < FFT_NUMBER_OF_BINS; i += tLength) {
+                uint16_t tOther = i + tHalfLength;
+                fft_value_t tProductReal = (((fft_product_t) tCosine * tReal[tOther]) + ((fft_product_t) tSine * tImag[tOther]))
+                        >> 15;
+                fft_value_t tProductImag = (((fft_product_t) tCosine * tImag[tOther]) - ((fft_product_t) tSine * tReal[tOther]))
+                        >> 15;
+#if defined(__AVR__)
+                tReal[tOther] = ((int32_t) tReal[i] - tProductReal) >> 1;
+                tImag[tOther] = ((int32_t) tImag[i] - tProductImag) >> 1;
+                tReal[i] = ((int32_t) tReal[i] + tProductReal) >> 1;
+                tImag[i] = ((int32_t) tImag[i] + tProductImag) >> 1;
+#else
+                tReal[tOther] = tReal[i] - tProductReal;
+                tImag[tOther] = tImag[i] - tProductImag;
+                tReal[i] += tProductReal;
+                tImag[i] += tProductImag;
+#endif
+            }
+        }
+    }
+
+    /*
+     * Split step and magnitude. Only reads the complex values, so no temporary buffer is required.
+     */
+    for (uint16_t k = 0; k < FFT_NUMBER_OF_BINS; ++k) {
+        uint16_t tMirror = (FFT_NUMBER_OF_BINS - k) & (FFT_NUMBER_OF_BINS - 1);
+        fft_product_t tEvenReal = ((fft_product_t) tReal[k] + tReal[tMirror]) >> 1;
+        fft_product_t tEvenImag = ((fft_product_t) tImag[k] - tImag[tMirror]) >> 1;
+        fft_product_t tDiffReal = ((fft_product_t) tReal[k] - tReal[tMirror]) >> 1;
+        fft_product_t tDiffImag = ((fft_product_t) tImag[k] + tImag[tMirror]) >> 1;
+        int16_t tCosine = getFFTCosine(k);
+        int16_t tSine = getFFTSine(k);
+        fft_product_t tOutReal = tEvenReal + (((tCosine * tDiffImag) - (tSine * tDiffReal)) >> 15);
+        fft_product_t tOutImag = tEvenImag - (((tCosine * tDiffReal) + (tSine * tDiffImag)) >> 15);
+
+#if defined(__AVR__)
+        // Magnitude is below 2 * sqrt(2) * (255 << FFT_INPUT_SHIFT), so the square fits in 32 bit
+        uint32_t tSquare = ((uint32_t) tOutReal * (uint32_t) tOutReal) + ((uint32_t) tOutImag * (uint32_t) tOutImag);
+        aOutputHalfDB[k] = getHalfDBFromSquare(tSquare);
+#else
+        float tOutRealFloat = tOutReal * (1.0 / (1 << FFT_INPUT_SHIFT));
+        float tOutImagFloat = tOutImag * (1.0 / (1 << FFT_INPUT_SHIFT));
+        float tSquare = (tOutRealFloat * tOutRealFloat) + (tOutImagFloat * tOutImagFloat);
+        uint8_t tHalfDB = 0;
+        if (tSquare > 1.0) {
+            float tHalfDBFloat = 20.0 * log10f(tSquare);
+            tHalfDB = (tHalfDBFloat > 255.0) ? 255 : tHalfDBFloat;
+        }
+        aOutputHalfDB[k] = tHalfDB;
+#endif
+    }
+}
+
+uint16_t getFFTPeakBin(const uint8_t *aHalfDBValues) {
+    uint16_t tPeakBin = 1;
+    for (uint16_t i = 2; i < FFT_NUMBER_OF_BINS; ++i) {
+        if (aHalfDBValues[i] > aHalfDBValues[tPeakBin]) {
+            tPeakBin = i;
+        }
+    }
+    return tPeakBin;
+}
+
+uint32_t getFFTInterpolatedPeakBinShift8(const uint8_t *aHalfDBValues, uint16_t aPeakBin) {
+    uint32_t tPeakBinShift8 = (uint32_t) aPeakBin << 8;
+    if (aPeakBin == 0 || aPeakBin >= FFT_NUMBER_OF_BINS - 1) {
+        return tPeakBinShift8;
+    }
+    int16_t tLeft = aHalfDBValues[aPeakBin - 1];
+    int16_t tCenter = aHalfDBValues[aPeakBin];
+    int16_t tRight = aHalfDBValues[aPeakBin + 1];
+    int16_t tDenominator = tLeft - (2 * tCenter) + tRight; // <= 0, since center is the maximum
+    if (tDenominator == 0) {
+        return tPeakBinShift8;
+    }
+    // offset = 0.5 * (left - right) / denominator, which is between -0.5 and 0.5
+    return tPeakBinShift8 + (((int32_t) (tLeft - tRight) * 128) / tDenominator);
+}
+#endif // _FIXED_POINT_FFT_HPP
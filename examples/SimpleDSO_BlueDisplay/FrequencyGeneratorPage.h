@@ -22,6 +22,35 @@ void startFrequencyGeneratorPage(void);
 void loopFrequencyGeneratorPage(void);
 void stopFrequencyGeneratorPage(void);
 
+#if defined(__AVR__)
+/*
+ * Frequency sweep
+ */
+#define SWEEP_MAX_STEPS     64
+
+#define SWEEP_STATE_OFF         0
+#define SWEEP_STATE_DWELL       1 // Frequency is set, wait for the circuit to settle
+#define SWEEP_STATE_MEASURE     2 // Acquisition started after dwell time is running
+#define SWEEP_STATE_SHOW_CHART  3
+
+struct FrequencySweepStruct {
+    float StartFrequency;
+    float StopFrequency;
+    uint8_t NumberOfSteps;
+    bool isLogarithmic;
+    uint16_t DwellMillis;
+
+    uint8_t State;
+    uint8_t StepIndex;
+    uint32_t StepStartMillis;
+    int16_t MaxMillivoltPeakToPeak; // Reference for 0 dB
+    int16_t Amplitudes[SWEEP_MAX_STEPS]; // Millivolt peak to peak while sweeping, 1/10 dB relative to maximum afterwards
+};
+extern struct FrequencySweepStruct sFrequencySweep;
+
+void checkFrequencySweep(void);
+#endif
+
 //extern BDButton TouchButtonFrequencyPage;
 
 extern const char StringStop[] PROGMEM; // "Stop"
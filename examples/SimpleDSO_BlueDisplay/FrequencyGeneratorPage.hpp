@@ -2,9 +2,9 @@
  * FrequencyGeneratorPage.hpp
  *
  * Frequency output from 119 mHz (8.388 second) to 8 MHz square wave on Arduino using timer1.
- * Sine waveform output from 7,421 mHz to 7812.5 Hz
- * Triangle from 3.725 mHz to 1953.125 Hz
- * Sawtooth from 1.866 mHz to 3906.25 Hz
+ * Sine, triangle, sawtooth and arbitrary waveform output from 1 mHz to 7812.5 Hz
+ * The arbitrary waveform is entered as up to 16 equidistant points after selecting it.
+ * Frequency sweep with amplitude measurement by DSO and frequency response chart.
  *
  * !!!Do not run DSO acquisition and non square wave waveform generation at the same time!!!
  * Because of the interrupts at 62 kHz rate, DSO is almost not usable during non square wave waveform generation.
@@ -88,6 +88,31 @@ struct FrequencyInfoStruct sFrequencyInfo;
 #define INDEX_OF_10HZ 2
 static bool is10HzRange = true;
 
+#if defined(__AVR__)
+#define MAX_NUMBER_OF_ARBITRARY_POINTS 16
+uint8_t sArbitraryPoints[MAX_NUMBER_OF_ARBITRARY_POINTS];
+uint8_t sNumberOfArbitraryPoints;
+
+/*
+ * Frequency sweep
+ */
+#define SWEEP_BUTTON_Y              (98 + BUTTON_HEIGHT_6 + BUTTON_DEFAULT_SPACING_QUARTER) // between fixed frequency and range buttons
+#define SWEEP_BUTTON_HEIGHT         18
+
+#define SWEEP_CHART_X               (4 * TEXT_SIZE_11_WIDTH) // space for Y labels
+#define SWEEP_CHART_Y               (DISPLAY_HEIGHT - (2 * TEXT_SIZE_11_HEIGHT)) // X axis, space for X labels below
+#define SWEEP_CHART_WIDTH           256 // 4 pixel per step for SWEEP_MAX_STEPS
+#define SWEEP_CHART_HEIGHT          180
+#define SWEEP_CHART_X_GRID_SPACING  64
+#define SWEEP_CHART_Y_GRID_SPACING  36
+#define SWEEP_CHART_DB_PER_GRID     10
+#define SWEEP_CHART_MIN_DECI_DB     (-((SWEEP_CHART_HEIGHT / SWEEP_CHART_Y_GRID_SPACING) * SWEEP_CHART_DB_PER_GRID * 10)) // -50 dB
+#define SWEEP_CHART_MAX_X_SCALE_FACTOR  32
+
+struct FrequencySweepStruct sFrequencySweep = { 10, 5000, SWEEP_MAX_STEPS, true, 200, SWEEP_STATE_OFF };
+Chart FrequencySweepChart;
+#endif
+
 static const int BUTTON_INDEX_SELECTED_INITIAL = 2; // select 10Hz Button
 
 /*
@@ -99,6 +124,9 @@ BDButton ActiveTouchButtonFrequencyRange; // Used to determine which range butto
 BDButton TouchButtonFrequencyStartStop;
 BDButton TouchButtonGetFrequency;
 BDButton TouchButtonWaveform;
+#if defined(__AVR__)
+BDButton TouchButtonFrequencySweep;
+#endif
 
 #if defined(SUPPORT_LOCAL_DISPLAY)
 BDButton TouchButton1;
@@ -135,6 +163,12 @@ void printFrequencyAndPeriod();
 #if defined(__AVR__)
 void setWaveformButtonText(void);
 void initTimer1ForCTC(void);
+void requestNextArbitraryPoint(void);
+
+void doFrequencySweep(BDButton *aTheTouchedButton, int16_t aValue);
+void startFrequencySweep(void);
+void setFrequencySweepStep(void);
+void drawFrequencySweepChart(void);
 #endif
 
 /***********************
@@ -192,6 +226,9 @@ void loopFrequencyGeneratorPage(void) {
 }
 
 void stopFrequencyGeneratorPage(void) {
+#if defined(__AVR__)
+    sFrequencySweep.State = SWEEP_STATE_OFF; // abort a running sweep
+#endif
 #if defined(SUPPORT_LOCAL_DISPLAY)
     // free buttons
     for (unsigned int i = 0; i < NUMBER_OF_FIXED_FREQUENCY_BUTTONS; ++i) {
@@ -206,6 +243,7 @@ void stopFrequencyGeneratorPage(void) {
     TouchSliderFrequency.deinit();
 #  if defined(__AVR__)
     TouchButtonWaveform.deinit();
+    TouchButtonFrequencySweep.deinit();
 #  endif
 #endif
     /*
@@ -287,10 +325,19 @@ void initFrequencyGeneratorPageGui() {
     TouchButtonWaveform.init(BUTTON_WIDTH_3_POS_3, DISPLAY_HEIGHT - BUTTON_HEIGHT_4, BUTTON_WIDTH_3, BUTTON_HEIGHT_4, COLOR16_BLUE,
             "", TEXT_SIZE_18, FLAG_BUTTON_DO_BEEP_ON_TOUCH, sFrequencyInfo.Waveform, &doWaveformMode);
     setWaveformButtonText();
+
+    TouchButtonFrequencySweep.init(BUTTON_WIDTH_3_POS_3, SWEEP_BUTTON_Y, BUTTON_WIDTH_3, SWEEP_BUTTON_HEIGHT, COLOR16_BLUE,
+            F("Sweep"), TEXT_SIZE_11, FLAG_BUTTON_DO_BEEP_ON_TOUCH, 0, &doFrequencySweep);
 #endif
 }
 
 void drawFrequencyGeneratorPage(void) {
+#if defined(__AVR__)
+    if (sFrequencySweep.State == SWEEP_STATE_SHOW_CHART) {
+        drawFrequencySweepChart();
+        return;
+    }
+#endif
     // do not clear screen here since it is called periodically for GUI refresh while DSO is running
 #if !defined(ARDUINO)
     TouchButtonMainHome.drawButton();
@@ -338,6 +385,7 @@ void drawFrequencyGeneratorPage(void) {
     TouchButtonGetFrequency.drawButton();
 #if defined(__AVR__)
     TouchButtonWaveform.drawButton();
+    TouchButtonFrequencySweep.drawButton();
 #endif
 
     // show values
@@ -432,9 +480,239 @@ void doWaveformMode(BDButton *aTheTouchedButton, int16_t aValue) {
 #if defined(__AVR__)
     cycleWaveformMode();
     setWaveformButtonText();
+    if (sFrequencyInfo.Waveform == WAVEFORM_ARBITRARY) {
+        sNumberOfArbitraryPoints = 0;
+        requestNextArbitraryPoint();
+    }
 #endif
 }
 
+#if defined(__AVR__)
+/*
+ * Handler for number receive event - append point and update waveform.
+ * Cancel on the host ends the input, since nothing is sent back.
+ */
+void doSetArbitraryPoint(float aValue) {
+    if (aValue < 0) {
+        aValue = 0;
+    } else if (aValue > UINT8_MAX) {
+        aValue = UINT8_MAX;
+    }
+    sArbitraryPoints[sNumberOfArbitraryPoints++] = aValue;
+    setWaveformTableFromPoints(sArbitraryPoints, sNumberOfArbitraryPoints);
+    if (sNumberOfArbitraryPoints < MAX_NUMBER_OF_ARBITRARY_POINTS) {
+        requestNextArbitraryPoint();
+    }
+}
+
+void requestNextArbitraryPoint(void) {
+    snprintf_P(sStringBuffer, sizeof(sStringBuffer), PSTR("Point %u [0-255]"), sNumberOfArbitraryPoints + 1);
+    BlueDisplay1.getNumberWithShortPrompt(&doSetArbitraryPoint, sStringBuffer);
+}
+
+/*
+ * Frequency sweep from start to stop frequency in linear or logarithmic steps.
+ * At each step we wait the dwell time, then the peak to peak value of the next complete DSO acquisition is taken as amplitude.
+ * During the dwell time, the DSO continues acquisition, so automatic range and trigger can adapt to the new amplitude.
+ * At the end the DSO is stopped and the frequency response is shown in dB relative to the maximum amplitude.
+ *
+ * The parameters are requested one after the other, with the last values as initial values.
+ * Cancel on the host ends the input, since nothing is sent back.
+ */
+void doSetSweepDwellMillis(float aValue) {
+    if (aValue < 0) {
+        aValue = 0;
+    } else if (aValue > UINT16_MAX) {
+        aValue = UINT16_MAX;
+    }
+    sFrequencySweep.DwellMillis = aValue;
+    startFrequencySweep();
+}
+
+void doSetSweepLogarithmic(float aValue) {
+    sFrequencySweep.isLogarithmic = (aValue != 0);
+    BlueDisplay1.getNumberWithShortPrompt(&doSetSweepDwellMillis, F("Dwell [ms]"), sFrequencySweep.DwellMillis);
+}
+
+void doSetSweepNumberOfSteps(float aValue) {
+    if (aValue < 2) {
+        aValue = 2;
+    } else if (aValue > SWEEP_MAX_STEPS) {
+        aValue = SWEEP_MAX_STEPS;
+    }
+    sFrequencySweep.NumberOfSteps = aValue;
+    BlueDisplay1.getNumberWithShortPrompt(&doSetSweepLogarithmic, F("Log=1 linear=0"), sFrequencySweep.isLogarithmic);
+}
+
+void doSetSweepStopFrequency(float aValue) {
+    if (aValue < DDS_MIN_FREQUENCY) {
+        aValue = DDS_MIN_FREQUENCY;
+    }
+    sFrequencySweep.StopFrequency = aValue;
+    BlueDisplay1.getNumberWithShortPrompt(&doSetSweepNumberOfSteps, F("Steps [2-64]"), sFrequencySweep.NumberOfSteps);
+}
+
+void doSetSweepStartFrequency(float aValue) {
+    if (aValue < DDS_MIN_FREQUENCY) {
+        aValue = DDS_MIN_FREQUENCY;
+    }
+    sFrequencySweep.StartFrequency = aValue;
+    BlueDisplay1.getNumberWithShortPrompt(&doSetSweepStopFrequency, F("Stop [Hz]"), sFrequencySweep.StopFrequency);
+}
+
+/*
+ * Starts parameter input or aborts a running sweep
+ */
+void doFrequencySweep(BDButton *aTheTouchedButton, int16_t aValue) {
+    if (sFrequencySweep.State != SWEEP_STATE_OFF) {
+        sFrequencySweep.State = SWEEP_STATE_OFF;
+        return;
+    }
+    BlueDisplay1.getNumberWithShortPrompt(&doSetSweepStartFrequency, F("Start [Hz]"), sFrequencySweep.StartFrequency);
+}
+
+void startFrequencySweep(void) {
+    if (!sFrequencyInfo.isOutputEnabled) {
+        sFrequencyInfo.isOutputEnabled = true;
+        TouchButtonFrequencyStartStop.setValueAndDraw(true);
+    }
+    sFrequencySweep.StepIndex = 0;
+    setFrequencySweepStep();
+    if (!MeasurementControl.isRunning) {
+        // Start DSO without leaving the frequency page
+        MeasurementControl.isSingleShotMode = false;
+        startAcquisition();
+        MeasurementControl.isRunning = true;
+    }
+}
+
+/*
+ * @param aStepIndex - may be fractional for label computation
+ */
+float getFrequencySweepFrequency(float aStepIndex) {
+    float tFraction = aStepIndex / (sFrequencySweep.NumberOfSteps - 1);
+    if (sFrequencySweep.isLogarithmic) {
+        return sFrequencySweep.StartFrequency * pow(sFrequencySweep.StopFrequency / sFrequencySweep.StartFrequency, tFraction);
+    }
+    return sFrequencySweep.StartFrequency + ((sFrequencySweep.StopFrequency - sFrequencySweep.StartFrequency) * tFraction);
+}
+
+void setFrequencySweepStep(void) {
+    setWaveformFrequency(getFrequencySweepFrequency(sFrequencySweep.StepIndex));
+    printFrequencyAndPeriod(); // shows progress
+    sFrequencySweep.StepStartMillis = millis();
+    sFrequencySweep.State = SWEEP_STATE_DWELL;
+}
+
+/*
+ * Convert millivolt to 1/10 dB relative to maximum value, which is stored for display
+ */
+void convertFrequencySweepAmplitudesToDeciBel(void) {
+    int16_t tMaxMillivolt = 1;
+    for (uint_fast8_t i = 0; i < sFrequencySweep.NumberOfSteps; ++i) {
+        if (sFrequencySweep.Amplitudes[i] > tMaxMillivolt) {
+            tMaxMillivolt = sFrequencySweep.Amplitudes[i];
+        }
+    }
+    sFrequencySweep.MaxMillivoltPeakToPeak = tMaxMillivolt;
+
+    for (uint_fast8_t i = 0; i < sFrequencySweep.NumberOfSteps; ++i) {
+        int16_t tDeciBel = SWEEP_CHART_MIN_DECI_DB;
+        if (sFrequencySweep.Amplitudes[i] > 0) {
+            // 950 byte program memory required for pow() and log10f(), but they are already used for slider
+            tDeciBel = 200 * log10f((float) sFrequencySweep.Amplitudes[i] / tMaxMillivolt);
+            if (tDeciBel < SWEEP_CHART_MIN_DECI_DB) {
+                tDeciBel = SWEEP_CHART_MIN_DECI_DB;
+            }
+        }
+        sFrequencySweep.Amplitudes[i] = tDeciBel;
+    }
+}
+
+/*
+ * Called by main loop for each complete acquisition, before the next acquisition is started
+ */
+void checkFrequencySweep(void) {
+    if (sFrequencySweep.State == SWEEP_STATE_DWELL) {
+        if (millis() - sFrequencySweep.StepStartMillis >= sFrequencySweep.DwellMillis) {
+            // The acquisition started after this one is the first one, which lies completely after the dwell time
+            sFrequencySweep.State = SWEEP_STATE_MEASURE;
+        }
+
+    } else if (sFrequencySweep.State == SWEEP_STATE_MEASURE) {
+        int32_t tMillivolt = getFloatFromRawValue(MeasurementControl.RawValueMax - MeasurementControl.RawValueMin) * 1000;
+        if (tMillivolt > INT16_MAX) {
+            tMillivolt = INT16_MAX;
+        }
+        sFrequencySweep.Amplitudes[sFrequencySweep.StepIndex++] = tMillivolt;
+
+        if (sFrequencySweep.StepIndex < sFrequencySweep.NumberOfSteps) {
+            setFrequencySweepStep();
+        } else {
+            convertFrequencySweepAmplitudesToDeciBel();
+            sFrequencySweep.State = SWEEP_STATE_SHOW_CHART;
+            /*
+             * Stop DSO immediately, otherwise the running DSO draws over the chart.
+             * The stop handling of the main loop calls redrawDisplay(), which in turn draws the chart.
+             */
+            DataBufferControl.DataBufferDisplayStart = &DataBufferControl.DataBuffer[0];
+            MeasurementControl.StopRequested = true;
+        }
+    }
+}
+
+/*
+ * Label value is the (fractional) step index
+ */
+int getFrequencySweepLabelString(char *aLabelStringBuffer, time_float_union aXvalue) {
+    float tFrequency = getFrequencySweepFrequency(aXvalue.FloatValue);
+    uint8_t tFrequencyRangeIndex = FREQUENCY_RANGE_INDEX_HERTZ;
+    if (tFrequency < 1) {
+        tFrequencyRangeIndex = FREQUENCY_RANGE_INDEX_MILLI_HERTZ;
+        tFrequency *= 1000;
+    } else {
+        while (tFrequency >= 1000) {
+            tFrequency /= 1000;
+            tFrequencyRangeIndex++;
+        }
+    }
+    dtostrf(tFrequency, 1, (tFrequency < 10) ? 1 : 0, aLabelStringBuffer);
+    uint8_t tLength = strlen(aLabelStringBuffer);
+    if (tFrequencyRangeIndex != FREQUENCY_RANGE_INDEX_HERTZ) {
+        aLabelStringBuffer[tLength++] = FrequencyRangeChars[tFrequencyRangeIndex];
+        aLabelStringBuffer[tLength] = '\0';
+    }
+    return tLength;
+}
+
+void drawFrequencySweepChart(void) {
+    BlueDisplay1.clearDisplay(COLOR_BACKGROUND_FREQ);
+
+    dtostrf(sFrequencySweep.MaxMillivoltPeakToPeak / 1000.0, 5, 3, &sStringBuffer[20]);
+    snprintf_P(sStringBuffer, sizeof(sStringBuffer), PSTR("0dB=%sVpp"), &sStringBuffer[20]);
+    BlueDisplay1.drawText(FREQ_SLIDER_X, 2, sStringBuffer, TEXT_SIZE_22, COLOR16_RED, COLOR_BACKGROUND_FREQ);
+
+    FrequencySweepChart.initChart(SWEEP_CHART_X, SWEEP_CHART_Y, SWEEP_CHART_WIDTH, SWEEP_CHART_HEIGHT, 1, TEXT_SIZE_11, true,
+    SWEEP_CHART_X_GRID_SPACING, SWEEP_CHART_Y_GRID_SPACING);
+    FrequencySweepChart.initChartColors(COLOR16_RED, COLOR16_BLUE, CHART_DEFAULT_GRID_COLOR, COLOR16_BLACK, COLOR16_BLACK,
+    COLOR_BACKGROUND_FREQ);
+
+    // X label value is the step index, which is converted to frequency by the label string function
+    FrequencySweepChart.initXLabel(0, SWEEP_CHART_X_GRID_SPACING, CHART_X_AXIS_SCALE_FACTOR_1, 4, 0);
+    FrequencySweepChart.setLabelStringFunction(&getFrequencySweepLabelString);
+    FrequencySweepChart.computeAndSetXLabelAndXDataScaleFactor(sFrequencySweep.NumberOfSteps, SWEEP_CHART_MAX_X_SCALE_FACTOR);
+    // Expansion factor is at least 4 for SWEEP_MAX_STEPS, so chart ends at the last step
+    FrequencySweepChart.setWidthX(sFrequencySweep.NumberOfSteps * FrequencySweepChart.getXDataScaleFactor());
+
+    FrequencySweepChart.initYLabel(SWEEP_CHART_MIN_DECI_DB / 10, SWEEP_CHART_DB_PER_GRID, 0.1, 3, 0);
+
+    FrequencySweepChart.drawAxesAndGrid();
+    FrequencySweepChart.drawChartData(sFrequencySweep.Amplitudes, sFrequencySweep.NumberOfSteps, CHART_MODE_LINE);
+
+    TouchButtonBack.drawButton();
+}
+#endif
+
 #if defined(SUPPORT_LOCAL_DISPLAY)
 /**
  * gets frequency value from numberpad
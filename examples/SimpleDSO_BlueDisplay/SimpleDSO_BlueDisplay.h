@@ -23,6 +23,7 @@
 #define _SIMPLE_DSO_BLUEDISPLAY_H
 
 #include "TouchDSOCommon.h"
+#include "FixedPointFFT.h"
 
 // Internal version
 #define VERSION_DSO "3.4"
@@ -166,6 +167,7 @@ struct MeasurementControlStruct {
     uint32_t PeriodFirst; // Length of first pulse or pause
     uint32_t PeriodSecond; // Length of second pulse or pause
     uint32_t FrequencyHertz;
+    uint16_t RawValueStandardDeviation; // AC part of RMS value
 
     // Timebase
     bool AcquisitionFastMode;
@@ -182,10 +184,69 @@ struct MeasurementControlStruct {
     float HorizontalGridVoltage; // voltage per grid for offset etc.
     int8_t OffsetGridCount; // number of bottom line for offset != 0 volt.
     uint32_t TimestampLastRangeChange;
+
+    // Equivalent time sampling for timebases with XScale > 1
+    bool isEquivalentTimeMode;
+    uint8_t EquivalentTimeSweepCount; // Sweeps merged into current record
+    uint8_t EquivalentTimeSweepTarget; // A new record is started after this number of sweeps
+    uint16_t EquivalentTimeValidSlots; // Number of display columns acquired in current record. DISPLAY_WIDTH -> converged
 };
 
 extern struct MeasurementControlStruct MeasurementControl;
 
+/*
+ * Streaming measurement engine.
+ * Sums and trigger crossings are accumulated from the stored samples, so computePeriodFrequency() only converts the results.
+ * Scope:
+ * - ISR timebases (>= 496 us/div): The main loop processes the samples behind DataBufferNextInPointer
+ *   while the ISR is still filling the buffer. Only the last few samples are processed after the buffer is full.
+ * - Fast and ultra fast timebases (<= 201 us/div): The ADC loop in acquireDataFast() has only about 2 us idle time per sample,
+ *   which is not enough for the engine. So the values are processed in one pass by computePeriodFrequency(),
+ *   which is only called for info output, and not for each acquisition. This keeps the time between acquisitions short.
+ *   Min, max and the sum for the average are still computed inside the ADC loop.
+ * All values are (not inverted) 8 bit display values, i.e. (DISPLAY_VALUE_FOR_ZERO - DataBuffer[i]).
+ */
+struct StreamingMeasurementStruct {
+    uint8_t *NextPointer; // Next data buffer value to process
+    uint8_t *DeferredEndPointer; // End of values to be processed by computePeriodFrequency() for fast modes
+    uint16_t SampleIndex;
+    uint32_t IntegrateValue; // For standard deviation
+    uint32_t IntegrateSquareValue;
+
+    // Period detection
+    uint8_t TriggerStatus; // TRIGGER_STATUS_START or TRIGGER_STATUS_AFTER_HYSTERESIS
+    uint8_t CompareValue; // Hysteresis or trigger level depending on TriggerStatus
+    uint8_t TriggerValue;
+    uint8_t HysteresisValue;
+    int16_t CrossingCount; // Number of trigger conditions found. Starts with -1 if first value is not the trigger value.
+    uint16_t StartIndex; // Index of first trigger condition for free running, external or delayed trigger
+    uint16_t LastCrossingIndex;
+
+    // First pulse or pause
+    uint8_t FirstIntervalStatus;
+    uint8_t FirstIntervalCompareValue;
+    uint16_t FirstEndIndex;
+    uint16_t FirstIntervalLength;
+    uint16_t SecondIntervalLength;
+};
+extern StreamingMeasurementStruct StreamingMeasurement;
+void initStreamingMeasurement(void);
+void processStreamingMeasurement(uint8_t *aEndPointer);
+
+#define EQUIVALENT_TIME_SWEEPS_PER_PHASE 4 // Sweep target is this value * XScale
+bool isEquivalentTimeActive(void);
+void resetEquivalentTimeRecord(void);
+void mergeEquivalentTimeSweep(uint8_t aPhaseSlot);
+
+void resetDisplayAccumulation(void);
+void drawRunningDataBuffer(void);
+
+#define FFT_PIXEL_PER_BIN   (DISPLAY_WIDTH / FFT_NUMBER_OF_BINS)
+#define FFT_PIXEL_PER_DB    4
+#define FFT_CHART_TOP       FONT_SIZE_INFO_SHORT // below info line
+#define FFT_CHART_HEIGHT    (DISPLAY_HEIGHT - FFT_CHART_TOP)
+void computeAndDrawFFT(void);
+
 // values for DisplayPage
 // using enums increases code size by 120 bytes for Arduino
 #define DSO_PAGE_START      0    // Start GUI
@@ -204,6 +265,20 @@ extern struct MeasurementControlStruct MeasurementControl;
 #define INFO_MODE_NO_INFO 0
 #define INFO_MODE_SHORT_INFO 1
 #define INFO_MODE_LONG_INFO 2
+// values for DisplayMode
+#define DISPLAY_MODE_NORMAL         0
+#define DISPLAY_MODE_AVERAGE        1 // Running mean of about (1 << DISPLAY_AVERAGE_SHIFT) sweeps
+#define DISPLAY_MODE_PEAK_HOLD      2 // Maximum of all sweeps since last reset
+#define DISPLAY_MODE_PERSISTENCE    3 // Last DISPLAY_PERSISTENCE_LAYERS sweeps
+#define DISPLAY_MODE_NUMBER_OF_MODES 4
+#define DISPLAY_AVERAGE_SHIFT       3
+#define DISPLAY_PERSISTENCE_LAYERS  8 // Max 15, since chart index 0 is used for normal chart
+/*
+ * The accumulation buffer uses the last third of the data buffer, which is only filled by the last acquisition before stop.
+ * It contains display values, like the data buffer.
+ */
+#define ACCUMULATION_BUFFER (&DataBufferControl.DataBuffer[DATABUFFER_SIZE - DISPLAY_WIDTH])
+
 struct DisplayControlStruct {
     uint8_t TriggerLevelDisplayValue; // For clearing old line of manual trigger level setting
     int8_t XScale; // Factor for X Data expansion(>0)  0 = no scale, 2->display 1 value 2 times etc.
@@ -216,6 +291,16 @@ struct DisplayControlStruct {
 
     bool showHistory;
     uint16_t EraseColor;
+
+    // Number of values acquired before trigger. Only for fast modes without trigger delay and external trigger.
+    uint16_t DatabufferPreTriggerDisplaySize;
+
+    uint8_t DisplayMode; // DISPLAY_MODE_NORMAL, DISPLAY_MODE_AVERAGE, DISPLAY_MODE_PEAK_HOLD, DISPLAY_MODE_PERSISTENCE
+    bool AccumulationBufferIsValid; // false after change of mode, timebase, range or offset
+    uint8_t PersistenceLayer; // Layer which is overwritten by next sweep
+
+    bool ShowFFT; // Show spectrum instead of chart in analyze mode
+    uint8_t FFTWindow; // FFT_WINDOW_RECTANGLE, FFT_WINDOW_HANN, FFT_WINDOW_HAMMING, FFT_WINDOW_BLACKMAN
 };
 extern DisplayControlStruct DisplayControl;
 
@@ -236,12 +321,15 @@ struct DataBufferStruct {
     // Pointer for horizontal scrolling
     uint8_t *DataBufferDisplayStart;
     uint8_t DataBuffer[DATABUFFER_SIZE]; // contains also display values i.e. (DISPLAY_VALUE_FOR_ZERO - 8BitValue)
+    // One bit per display column of the equivalent time record, which is kept in DisplayBuffer
+    uint8_t EquivalentTimeSlotIsValid[DISPLAY_WIDTH / 8];
 };
 extern DataBufferStruct DataBufferControl;
 
 // Utility section
 uint16_t getInputRawFromDisplayValue(uint8_t aDisplayValue);
 float getFloatFromDisplayValue(uint8_t aDisplayValue);
+float getFloatFromRawValue(int16_t aRawValue);
 void printSingleshotMarker();
 void clearSingleshotMarker();
 extern "C" void INT0_vect();
@@ -171,6 +171,13 @@
 #define DO_NOT_NEED_SPEAK_EVENTS            // Disables SpeakingDone event handling. Saves up to 54 bytes program memory and 18 bytes RAM.
 //#define ONLY_CONNECT_EVENT_REQUIRED         // Disables reorientation, redraw and SensorChange events
 #define BD_USE_SIMPLE_SERIAL // Do not use the Serial object. Saves up to 1250 bytes program memory and 185 bytes RAM, if Serial is not used otherwise
+#define BD_USE_FRAME_GOVERNOR // Skip drawing of a chart, if the link cannot transfer it before the next acquisition is complete
+#define DSO_TARGET_FRAMES_PER_SECOND    25
+#if defined(BLUETOOTH_BAUD_RATE)
+#define DSO_LINK_BAUD_RATE  BLUETOOTH_BAUD_RATE
+#else
+#define DSO_LINK_BAUD_RATE  9600
+#endif
 #if !defined(BD_USE_SIMPLE_SERIAL)
 #error SimpleDSO works only with BD_USE_SIMPLE_SERIAL activated, since the serial interrupts kill the DSO timing!
 #endif
@@ -180,6 +187,7 @@
 #include "LocalDisplay/digitalWriteFast.h"
 #include "FrequencyGeneratorPage.hpp" // include sources
 #include "TouchDSOGui.hpp" // include sources
+#include "FixedPointFFT.hpp" // include sources
 #include "ADCUtils.hpp" // for getVCCVoltage()
 
 /**********************
@@ -273,6 +281,7 @@ extern volatile unsigned long timer0_millis;
  * Measurement control values
  *****************************/
 struct MeasurementControlStruct MeasurementControl;
+StreamingMeasurementStruct StreamingMeasurement;
 
 /*
  * Display control
@@ -515,6 +524,7 @@ void setup() {
      * If not active, the periodic call of checkAndHandleEvents() in the main loop waits for the (re)connection and then performs the same actions.
      */
     BlueDisplay1.initCommunication(&Serial, &initDisplay, &redrawDisplay); // introduces up to 1.5 seconds delay
+    initFrameGovernor(DSO_TARGET_FRAMES_PER_SECOND, DSO_LINK_BAUD_RATE);
     registerSwipeEndCallback(&doSwipeEndDSO);
     registerTouchUpCallback(&doSwitchInfoModeOnTouchUp);
     registerLongTouchDownCallback(&doLongTouchDownDSO, 900);
@@ -559,6 +569,9 @@ void __attribute__((noreturn)) loop(void) {
                     /*
                      * Data (from InterruptServiceRoutine) is ready
                      */
+                    if (!MeasurementControl.AcquisitionFastMode) {
+                        processStreamingMeasurement(DataBufferControl.DataBufferNextInPointer); // process the last values
+                    }
 
                     /*
                      * Enable Timer0 overflow interrupt again
@@ -604,6 +617,9 @@ void __attribute__((noreturn)) loop(void) {
                     MeasurementControl.ValueAverage = (MeasurementControl.IntegrateValueForAverage
                             + (DataBufferControl.AcquisitionSize / 2)) / DataBufferControl.AcquisitionSize;
 
+                    // Take amplitude for frequency sweep. At end of sweep, it requests the stop.
+                    checkFrequencySweep();
+
                     if (MeasurementControl.StopRequested) {
                         /*
                          * Handle stop
@@ -636,7 +652,11 @@ void __attribute__((noreturn)) loop(void) {
                             drawTriggerLine();
                         }
 
-                        if (!DisplayControl.DrawWhileAcquire) {
+                        /*
+                         * The frame governor skips drawing of this acquisition, if the link has not yet sent the previous chart.
+                         * This keeps the latency of the chart low for fast timebases and low baud rates.
+                         */
+                        if (!DisplayControl.DrawWhileAcquire && beginFrame()) {
                             /*
                              * Clear old chart and draw new data
                              * A delay of 150 ms is too small for my Nexus 7, 200 ms seems to be sufficient :-)
@@ -645,7 +665,8 @@ void __attribute__((noreturn)) loop(void) {
                             if (sSlowBluetoothMode) {
                                 delayMillisAndCheckForEvent(HELPFUL_DELAY_BETWEEN_DRAWING_CHART_LINES_TO_STABILIZE_BT_CONNECTION);
                             }
-                            drawDataBuffer(&DataBufferControl.DataBuffer[0], COLOR_DATA_RUN, DisplayControl.EraseColor);
+                            drawRunningDataBuffer();
+                            endFrame();
                         }
                         startAcquisition();
                     }
@@ -653,6 +674,13 @@ void __attribute__((noreturn)) loop(void) {
                     /*
                      * Here data buffer is NOT full and acquisition is still ongoing
                      */
+                    if (!MeasurementControl.AcquisitionFastMode) {
+                        // pointer is written by ISR, so read it atomically
+                        noInterrupts();
+                        uint8_t *tDataBufferNextInPointer = DataBufferControl.DataBufferNextInPointer;
+                        interrupts();
+                        processStreamingMeasurement(tDataBufferNextInPointer);
+                    }
 
                     /*
                      * Handle slow modes (draw while acquire)
@@ -736,9 +764,16 @@ void __attribute__((noreturn)) loop(void) {
             } else if (DisplayControl.DisplayPage == DSO_PAGE_FREQUENCY) {
                 if (sBackButtonPressed) {
                     sBackButtonPressed = false;
-                    stopFrequencyGeneratorPage();
-                    DisplayControl.DisplayPage = DSO_PAGE_SETTINGS;
-                    redrawDisplay();
+                    if (sFrequencySweep.State == SWEEP_STATE_SHOW_CHART) {
+                        // Back from sweep chart to frequency generator page
+                        sFrequencySweep.State = SWEEP_STATE_OFF;
+                        BlueDisplay1.clearDisplay();
+                        drawFrequencyGeneratorPage();
+                    } else {
+                        stopFrequencyGeneratorPage();
+                        DisplayControl.DisplayPage = DSO_PAGE_SETTINGS;
+                        redrawDisplay();
+                    }
                 } else {
                     //not required here, because is contains only checkAndHandleEvents()
                     // loopFrequencyGeneratorPage();
@@ -773,6 +808,7 @@ void startAcquisition(void) {
     DataBufferControl.DataBufferNextDrawPointer = &DataBufferControl.DataBuffer[0];
     DataBufferControl.DataBufferNextDrawIndex = 0;
     MeasurementControl.IntegrateValueForAverage = 0;
+    initStreamingMeasurement();
     DataBufferControl.DataBufferFull = false;
     /*
      * Timebase
@@ -827,6 +863,120 @@ void startAcquisition(void) {
     }
 }
 
+/*
+ * Must be called after trigger level, offset and range are set for the next acquisition
+ */
+void initStreamingMeasurement(void) {
+    StreamingMeasurementStruct *tMeasurement = &StreamingMeasurement;
+    tMeasurement->NextPointer = &DataBufferControl.DataBuffer[0];
+    tMeasurement->DeferredEndPointer = &DataBufferControl.DataBuffer[0]; // nothing to process
+    tMeasurement->SampleIndex = 0;
+    tMeasurement->IntegrateValue = 0;
+    tMeasurement->IntegrateSquareValue = 0;
+
+    tMeasurement->TriggerValue = DISPLAY_VALUE_FOR_ZERO - getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel);
+    tMeasurement->HysteresisValue = DISPLAY_VALUE_FOR_ZERO
+            - getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevelHysteresis);
+    tMeasurement->TriggerStatus = TRIGGER_STATUS_START;
+    tMeasurement->CompareValue = tMeasurement->HysteresisValue; // start with hysteresis
+    tMeasurement->StartIndex = 0;
+    tMeasurement->LastCrossingIndex = 0;
+    if (MeasurementControl.TriggerMode >= TRIGGER_MODE_FREE || MeasurementControl.TriggerDelayMode != TRIGGER_DELAY_NONE) {
+        /*
+         * For TRIGGER_MODE_FREE, TRIGGER_MODE_EXTERN or delayed trigger first value is not any trigger,
+         * so start with search for begin of period.
+         */
+        tMeasurement->CrossingCount = -1;
+    } else {
+        // First value is the first after triggering condition so we have at least one trigger, but still no period.
+        tMeasurement->CrossingCount = 0;
+    }
+
+    // Start with opposite hysteresis for measurement of first interval
+    tMeasurement->FirstIntervalStatus = TRIGGER_STATUS_START;
+    if (MeasurementControl.TriggerSlopeRising) {
+        tMeasurement->FirstIntervalCompareValue = DISPLAY_VALUE_FOR_ZERO
+                - getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel + MeasurementControl.RawHysteresis);
+    } else {
+        tMeasurement->FirstIntervalCompareValue = DISPLAY_VALUE_FOR_ZERO
+                - getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel - MeasurementControl.RawHysteresis);
+    }
+    tMeasurement->FirstEndIndex = 0;
+    tMeasurement->FirstIntervalLength = 0;
+    tMeasurement->SecondIntervalLength = 0;
+}
+
+/*
+ * Processes all stored values up to aEndPointer (exclusive).
+ * For ISR acquisition it is called by the main loop while the ISR is filling the buffer,
+ * so at end of acquisition only a few values are left. The ISR itself has no time left for this at 496 us/div.
+ * For fast modes it is called by computePeriodFrequency() with DeferredEndPointer.
+ */
+void processStreamingMeasurement(uint8_t *aEndPointer) {
+    StreamingMeasurementStruct *tMeasurement = &StreamingMeasurement;
+    uint8_t *tDataPointer = tMeasurement->NextPointer;
+    uint16_t i = tMeasurement->SampleIndex;
+    uint32_t tIntegrateValue = tMeasurement->IntegrateValue;
+    uint32_t tIntegrateSquareValue = tMeasurement->IntegrateSquareValue;
+    bool tSlopeFalling = !MeasurementControl.TriggerSlopeRising;
+
+    while (tDataPointer < aEndPointer) {
+        uint8_t tValue = DISPLAY_VALUE_FOR_ZERO - *tDataPointer++;
+        tIntegrateValue += tValue;
+        tIntegrateSquareValue += (uint16_t) tValue * tValue; // 8 x 8 bit multiplication
+
+        /*
+         * First value is the first sample after triggering condition (including delay)
+         */
+        if (tMeasurement->FirstEndIndex == 0 && tMeasurement->CrossingCount == 0) {
+            /*
+             * Compute time of first pulse (pause) here.
+             * First wait for signal to go beyond hysteresis, then check for crossing trigger level
+             */
+            bool tValueLessThanTriggerForFirstPeriod = (tValue < tMeasurement->FirstIntervalCompareValue) ^ tSlopeFalling;
+            if (tMeasurement->FirstIntervalStatus == TRIGGER_STATUS_START) {
+                if (!tValueLessThanTriggerForFirstPeriod) {
+                    tMeasurement->FirstIntervalStatus = TRIGGER_STATUS_AFTER_HYSTERESIS;
+                    tMeasurement->FirstIntervalCompareValue = tMeasurement->TriggerValue;
+                }
+            } else if (tValueLessThanTriggerForFirstPeriod) {
+                // signal crosses trigger -> first interval detected
+                tMeasurement->FirstEndIndex = i;
+                tMeasurement->FirstIntervalLength = i - tMeasurement->StartIndex;
+            }
+        }
+
+        bool tValueGreaterCompareValue = (tValue > tMeasurement->CompareValue) ^ tSlopeFalling; // variable name is correct for rising slope!
+        if (tMeasurement->TriggerStatus == TRIGGER_STATUS_START) {
+            // rising slope - wait for value below hysteresis value
+            // falling slope - wait for value above hysteresis value
+            if (!tValueGreaterCompareValue) {
+                tMeasurement->TriggerStatus = TRIGGER_STATUS_AFTER_HYSTERESIS;
+                tMeasurement->CompareValue = tMeasurement->TriggerValue;
+            }
+        } else if (tValueGreaterCompareValue) {
+            // rising slope - value rises above trigger value, falling slope - value goes below trigger value
+            tMeasurement->TriggerStatus = TRIGGER_STATUS_START;
+            tMeasurement->CompareValue = tMeasurement->HysteresisValue;
+            tMeasurement->CrossingCount++;
+            if (tMeasurement->CrossingCount == 0) {
+                // set start position for TRIGGER_MODE_FREE, TRIGGER_MODE_EXTERN or delayed trigger.
+                tMeasurement->StartIndex = i;
+            } else if (tMeasurement->CrossingCount == 1) {
+                // first complete period (pulse + pause) is detected here
+                tMeasurement->SecondIntervalLength = i - tMeasurement->FirstEndIndex;
+            }
+            tMeasurement->LastCrossingIndex = i;
+        }
+        i++;
+    }
+
+    tMeasurement->NextPointer = tDataPointer;
+    tMeasurement->SampleIndex = i;
+    tMeasurement->IntegrateValue = tIntegrateValue;
+    tMeasurement->IntegrateSquareValue = tIntegrateSquareValue;
+}
+
 /*
  * ISR for external trigger input
  * not used if MeasurementControl.AcquisitionFastMode == true
@@ -870,10 +1020,109 @@ ISR(INT0_vect) {
     ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIF) | ADC_PRESCALE_FOR_TRIGGER_SEARCH | _BV(ADIE);
 }
 
+/*
+ * Transforms 10 bit raw value in order to fit on screen and inverts it for display
+ */
+inline uint8_t getDisplayFromRawValueForFastMode(uint16_t aRawValue, uint16_t aValueOffset) {
+    if (aRawValue < aValueOffset) {
+        aRawValue = 0;
+    } else {
+        aRawValue -= aValueOffset;
+    }
+    aRawValue = aRawValue >> MeasurementControl.ShiftValue;
+    if (aRawValue >= 0X100) {
+        aRawValue = 0xFF;
+    }
+    return DISPLAY_VALUE_FOR_ZERO - (uint8_t) aRawValue;
+}
+
+/*
+ * Rotate buffer content left by aShift, using 3 reversals, so no additional RAM is required
+ */
+void reverseBuffer(uint8_t *aStart, uint8_t *aEnd) {
+    while (aStart < --aEnd) {
+        uint8_t tValue = *aStart;
+        *aStart++ = *aEnd;
+        *aEnd = tValue;
+    }
+}
+void rotateBufferLeft(uint8_t *aBuffer, uint16_t aLength, uint16_t aShift) {
+    if (aShift == 0 || aShift >= aLength) {
+        return;
+    }
+    reverseBuffer(aBuffer, aBuffer + aShift);
+    reverseBuffer(aBuffer + aShift, aBuffer + aLength);
+    reverseBuffer(aBuffer, aBuffer + aLength);
+}
+
+/*
+ * Equivalent time sampling for periodic signals at the timebases which are simulated by XScale.
+ * The phase of the trigger crossing between 2 samples is computed by linear interpolation of the last value
+ * before and the value after the trigger level. The samples of each sweep are then stored at the display columns
+ * matching this phase. Since the phase of a signal not synchronous to the ADC clock is random,
+ * all XScale columns between 2 samples are filled after some sweeps, giving XScale times the sample rate.
+ * The record is kept in DisplayBuffer, columns not yet acquired hold the value of the preceding sample.
+ * Every other function writing to DisplayBuffer must call resetEquivalentTimeRecord(),
+ * otherwise the valid columns of the next sweeps are merged with foreign values.
+ */
+bool isEquivalentTimeActive(void) {
+    return (MeasurementControl.isEquivalentTimeMode && MeasurementControl.TimebaseIndex < TIMEBASE_NUMBER_OF_XSCALE_CORRECTION
+            && MeasurementControl.TriggerMode < TRIGGER_MODE_FREE && MeasurementControl.TriggerDelayMode == TRIGGER_DELAY_NONE);
+}
+
+/*
+ * Must be called if timebase, range or offset changes. Old values are kept for display until overwritten.
+ */
+void resetEquivalentTimeRecord(void) {
+    memset(DataBufferControl.EquivalentTimeSlotIsValid, 0, sizeof(DataBufferControl.EquivalentTimeSlotIsValid));
+    MeasurementControl.EquivalentTimeValidSlots = 0;
+    MeasurementControl.EquivalentTimeSweepCount = 0;
+    uint8_t tFactor = 1;
+    if (MeasurementControl.TimebaseIndex < TIMEBASE_NUMBER_OF_XSCALE_CORRECTION) {
+        tFactor = xScaleForTimebase[MeasurementControl.TimebaseIndex];
+    }
+    MeasurementControl.EquivalentTimeSweepTarget = tFactor * EQUIVALENT_TIME_SWEEPS_PER_PHASE;
+}
+
+/*
+ * @param aPhaseSlot - 0 to XScale. Display column of first sample after trigger.
+ */
+void mergeEquivalentTimeSweep(uint8_t aPhaseSlot) {
+    if (MeasurementControl.EquivalentTimeSweepCount >= MeasurementControl.EquivalentTimeSweepTarget) {
+        resetEquivalentTimeRecord();
+    }
+    uint8_t tFactor = xScaleForTimebase[MeasurementControl.TimebaseIndex];
+    uint8_t *tDataPointer = &DataBufferControl.DataBuffer[0];
+    uint8_t tValue = *tDataPointer;
+    for (uint16_t tSlot = 0; tSlot < DISPLAY_WIDTH; ++tSlot) {
+        uint8_t tMask = _BV(tSlot & 0x07);
+        uint8_t *tValidPointer = &DataBufferControl.EquivalentTimeSlotIsValid[tSlot / 8];
+        if (tSlot >= aPhaseSlot && ((tSlot - aPhaseSlot) % tFactor) == 0) {
+            // Column of a sample
+            tValue = *tDataPointer++;
+            if (!(*tValidPointer & tMask)) {
+                *tValidPointer |= tMask;
+                MeasurementControl.EquivalentTimeValidSlots++;
+            }
+            DataBufferControl.DisplayBuffer[tSlot] = tValue;
+        } else if (!(*tValidPointer & tMask)) {
+            // Hold value until this column is acquired by another sweep
+            DataBufferControl.DisplayBuffer[tSlot] = tValue;
+        }
+    }
+    MeasurementControl.EquivalentTimeSweepCount++;
+}
+
 /*
  * Fast ADC read routine for timebase 101-201us and ultra fast for 10-50us
  * Value, which mets trigger condition, is taken as first data.
  *
+ * Pretrigger for fast mode (101-201us):
+ * While waiting for the trigger, values are continuously stored in a ring buffer
+ * at the start of DataBuffer, which has DisplayControl.DatabufferPreTriggerDisplaySize entries.
+ * After acquisition, the ring buffer is rotated, so the trigger value is at index DatabufferPreTriggerDisplaySize.
+ * The ultra fast loop and the ISR trigger search (which runs with a faster sample rate) have no time for this.
+ *
  * Only TRIGGER_MODE_MANUAL_TIMEOUT and TRIGGER_MODE_EXTERN is supported yet.
  * But TRIGGER_MODE_EXTERN has timeout here!
  */
@@ -886,6 +1135,9 @@ void acquireDataFast(void) {
     uint8_t tTriggerStatus = TRIGGER_STATUS_START;
     uint16_t i;
     uint16_t tValueOffset = MeasurementControl.OffsetValue;
+    uint16_t tPreTriggerSize = 0;
+    uint16_t tRingIndex = 0; // index of next and oldest value in pretrigger ring buffer
+    uint16_t tLastValue = 0; // value before trigger value, for phase of equivalent time sampling
 
     if (MeasurementControl.TriggerMode == TRIGGER_MODE_EXTERN) {
         if (MeasurementControl.TriggerSlopeRising) {
@@ -911,6 +1163,21 @@ void acquireDataFast(void) {
 
         TIMSK2 = 0; // disable timer2 (millis()) interrupt to avoid jitter and signal dropouts
 
+        if (MeasurementControl.TimebaseIndex > TIMEBASE_INDEX_ULTRAFAST_MODES
+                && MeasurementControl.TriggerDelayMode == TRIGGER_DELAY_NONE && !MeasurementControl.isEquivalentTimeMode) {
+            tPreTriggerSize = DisplayControl.DatabufferPreTriggerDisplaySize;
+        }
+        /*
+         * Fill pretrigger ring buffer once before searching the trigger, so it never contains values of an old acquisition
+         */
+        for (i = 0; i < tPreTriggerSize; ++i) {
+            loop_until_bit_is_set(ADCSRA, ADIF);
+            tUValue.byte.LowByte = ADCL;
+            tUValue.byte.HighByte = ADCH;
+            ADCSRA |= _BV(ADIF);
+            DataBufferControl.DataBuffer[i] = getDisplayFromRawValueForFastMode(tUValue.Word, tValueOffset);
+        }
+
         /*
          * Wait for trigger for max. 10 screens e.g. < 20 ms
          * if trigger condition not met it will run forever in single shot mode
@@ -941,6 +1208,7 @@ void acquireDataFast(void) {
                 } else {
                     // rising slope - wait for value to rise above trigger level
                     if (tUValue.Word > MeasurementControl.RawTriggerLevel) {
+                        tTriggerStatus = TRIGGER_STATUS_FOUND;
                         break;
                     }
                 }
@@ -953,12 +1221,26 @@ void acquireDataFast(void) {
                 } else {
                     // falling slope - wait for value to go below trigger level
                     if (tUValue.Word < MeasurementControl.RawTriggerLevel) {
+                        tTriggerStatus = TRIGGER_STATUS_FOUND;
                         break;
                     }
                 }
             }
+
+            /*
+             * Store non trigger value in pretrigger ring buffer
+             */
+            if (tPreTriggerSize != 0) {
+                DataBufferControl.DataBuffer[tRingIndex] = getDisplayFromRawValueForFastMode(tUValue.Word, tValueOffset);
+                tRingIndex++;
+                if (tRingIndex >= tPreTriggerSize) {
+                    tRingIndex = 0;
+                }
+            }
+            tLastValue = tUValue.Word;
         }
     }
+    uint16_t tTriggerValue = tUValue.Word;
 
     /*
      * Only microseconds delay makes sense here
@@ -1027,6 +1309,7 @@ void acquireDataFast(void) {
         tUValue.byte.LowByte = *DataPointerFast++;
         tUValue.byte.HighByte = *DataPointerFast++;
     } // (tIndex <= TIMEBASE_INDEX_ULTRAFAST_MODES)
+    tLoopCount -= tPreTriggerSize; // tPreTriggerSize is 0 for ultra fast mode
 
     /*
      * Data is processed here.
@@ -1034,7 +1317,7 @@ void acquireDataFast(void) {
      * for ultra fast mode data is read from buffer.
      */
     uint32_t tIntegrateValue = 0;
-    uint8_t *DataPointer = &DataBufferControl.DataBuffer[0]; // ca. 1064 / 0x428
+    uint8_t *DataPointer = &DataBufferControl.DataBuffer[tPreTriggerSize]; // ca. 1064 / 0x428
     for (i = tLoopCount; i > 0; --i) {
         /*
          * process (first) value
@@ -1102,7 +1385,34 @@ void acquireDataFast(void) {
             *DataPointer++ = 0;
         }
     }
+    if (tPreTriggerSize != 0) {
+        // move oldest pretrigger value to start of buffer
+        rotateBufferLeft(&DataBufferControl.DataBuffer[0], tPreTriggerSize, tRingIndex);
+        // average is computed by main loop for the whole acquisition size
+        tIntegrateValue = (tIntegrateValue * DataBufferControl.AcquisitionSize) / tLoopCount;
+    }
     MeasurementControl.IntegrateValueForAverage = tIntegrateValue;
+    /*
+     * The ADC loop above has no time left for the measurement engine at 201 us/div,
+     * and an additional pass here would delay the next acquisition.
+     * So it is deferred to computePeriodFrequency(), which is only called for info output. See StreamingMeasurementStruct.
+     * Process only the values acquired after trigger, not the zeros appended for ultra fast mode.
+     */
+    StreamingMeasurement.NextPointer = &DataBufferControl.DataBuffer[tPreTriggerSize];
+    StreamingMeasurement.DeferredEndPointer = &DataBufferControl.DataBuffer[tPreTriggerSize + tLoopCount];
+
+    if (tTriggerStatus == TRIGGER_STATUS_FOUND && isEquivalentTimeActive()) {
+        /*
+         * Trigger crossing was (tBeyondLevel / tDelta) sample periods before the trigger value
+         */
+        uint16_t tDelta = uintDifferenceAbs(tTriggerValue, tLastValue);
+        uint16_t tBeyondLevel = uintDifferenceAbs(tTriggerValue, MeasurementControl.RawTriggerLevel);
+        uint8_t tPhaseSlot = 0;
+        if (tDelta != 0) {
+            tPhaseSlot = (((uint32_t) tBeyondLevel * xScaleForTimebase[tIndex]) + (tDelta / 2)) / tDelta;
+        }
+        mergeEquivalentTimeSweep(tPhaseSlot);
+    }
     DataBufferControl.DataBufferFull = true;
 }
 
@@ -1587,8 +1897,14 @@ void computeAutoOffset(void) {
         BlueDisplay1.clearDisplayArea();
         MeasurementControl.OffsetValue = tNumberOfGridLinesToSkip * tRawValuePerGrid;
         MeasurementControl.OffsetGridCount = tNumberOfGridLinesToSkip;
+        resetEquivalentTimeRecord();
+        resetDisplayAccumulation();
         drawGridLinesWithHorizLabelsAndTriggerLine();
     } else if (tNumberOfGridLinesToSkip == 0) {
+        if (MeasurementControl.OffsetValue != 0) {
+            resetEquivalentTimeRecord();
+            resetDisplayAccumulation();
+        }
         MeasurementControl.OffsetValue = 0;
         MeasurementControl.OffsetGridCount = 0;
     }
@@ -1610,6 +1926,8 @@ void resetOffset(void) {
     } else if (MeasurementControl.OffsetMode != OFFSET_MODE_AUTOMATIC) {
         MeasurementControl.OffsetValue = 0;
     }
+    resetEquivalentTimeRecord();
+    resetDisplayAccumulation();
 }
 
 /***********************************************************************
@@ -1774,32 +2092,186 @@ bool scrollChart(int aScrollAmount) {
             isError = true;
         }
     }
-    drawDataBuffer(DataBufferControl.DataBufferDisplayStart, COLOR_DATA_HOLD, COLOR_BACKGROUND_DSO);
+    if (DisplayControl.ShowFFT) {
+        redrawDisplay(); // spectrum at new position
+    } else {
+        drawDataBuffer(DataBufferControl.DataBufferDisplayStart, COLOR_DATA_HOLD, COLOR_BACKGROUND_DSO);
+    }
 
     return isError;
 }
 
-void drawDataBuffer(uint8_t *aByteBuffer, uint16_t aColor, uint16_t aClearBeforeColor) {
+/*
+ * Expand to DisplayBuffer - show each value XScale times
+ */
+void expandDataBufferForDisplay(uint8_t *aByteBuffer) {
+    resetEquivalentTimeRecord(); // DisplayBuffer is overwritten
     uint8_t tXScale = DisplayControl.XScale;
     uint8_t *tBufferPtr = aByteBuffer;
-    if (tXScale > 1) {
-        // expand - show value several times
-        uint8_t *tDisplayBufferPtr = &DataBufferControl.DisplayBuffer[0];
-        uint8_t tXScaleCounter = tXScale;
-        uint8_t tValue = *tBufferPtr++;
-        for (unsigned int i = 0; i < sizeof(DataBufferControl.DisplayBuffer); ++i) {
-            if (tXScaleCounter == 0) {
-                tValue = *tBufferPtr++;
-                tXScaleCounter = tXScale;
-            }
-            tXScaleCounter--;
-            *tDisplayBufferPtr++ = tValue;
+    uint8_t *tDisplayBufferPtr = &DataBufferControl.DisplayBuffer[0];
+    uint8_t tXScaleCounter = tXScale;
+    uint8_t tValue = *tBufferPtr++;
+    for (unsigned int i = 0; i < sizeof(DataBufferControl.DisplayBuffer); ++i) {
+        if (tXScaleCounter == 0) {
+            tValue = *tBufferPtr++;
+            tXScaleCounter = tXScale;
         }
+        tXScaleCounter--;
+        *tDisplayBufferPtr++ = tValue;
+    }
+}
+
+void drawDataBuffer(uint8_t *aByteBuffer, uint16_t aColor, uint16_t aClearBeforeColor) {
+    uint8_t *tBufferPtr = aByteBuffer;
+    if (DisplayControl.XScale > 1) {
+        expandDataBufferForDisplay(aByteBuffer);
         tBufferPtr = &DataBufferControl.DisplayBuffer[0];
     }
     BlueDisplay1.drawChartByteBuffer(0, 0, aColor, aClearBeforeColor, tBufferPtr, sizeof(DataBufferControl.DisplayBuffer));
 }
 
+/*
+ * Accumulation buffer must be refilled with the next sweep
+ */
+void resetDisplayAccumulation(void) {
+    DisplayControl.AccumulationBufferIsValid = false;
+}
+
+/*
+ * Draws the chart of the current acquisition according to DisplayMode.
+ * Every mode sends only one chart per sweep to the host.
+ */
+void drawRunningDataBuffer(void) {
+    if (isEquivalentTimeActive()) {
+        // record is already expanded to display width
+        BlueDisplay1.drawChartByteBuffer(0, 0, COLOR_DATA_RUN, DisplayControl.EraseColor, DataBufferControl.DisplayBuffer,
+                sizeof(DataBufferControl.DisplayBuffer));
+        return;
+    }
+
+    uint8_t tDisplayMode = DisplayControl.DisplayMode;
+    if (tDisplayMode == DISPLAY_MODE_PERSISTENCE) {
+        /*
+         * Each sweep gets its own chart index. The host clears the chart with the same index,
+         * which was drawn DISPLAY_PERSISTENCE_LAYERS sweeps before.
+         */
+        uint8_t *tBufferPtr = &DataBufferControl.DataBuffer[0];
+        if (DisplayControl.XScale > 1) {
+            expandDataBufferForDisplay(tBufferPtr);
+            tBufferPtr = &DataBufferControl.DisplayBuffer[0];
+        }
+        BlueDisplay1.drawChartByteBuffer(0, 0, COLOR_DATA_RUN, DisplayControl.EraseColor, DisplayControl.PersistenceLayer + 1, true,
+                tBufferPtr, sizeof(DataBufferControl.DisplayBuffer));
+        DisplayControl.PersistenceLayer++;
+        if (DisplayControl.PersistenceLayer >= DISPLAY_PERSISTENCE_LAYERS) {
+            DisplayControl.PersistenceLayer = 0;
+        }
+        return;
+    }
+
+    if (tDisplayMode == DISPLAY_MODE_NORMAL || DataBufferControl.AcquisitionSize > DATABUFFER_SIZE - DISPLAY_WIDTH) {
+        // Last acquisition before stop overwrites accumulation buffer
+        drawDataBuffer(&DataBufferControl.DataBuffer[0], COLOR_DATA_RUN, DisplayControl.EraseColor);
+        resetDisplayAccumulation();
+        return;
+    }
+
+    uint8_t *tDataPointer = &DataBufferControl.DataBuffer[0];
+    uint8_t *tAccumulationPointer = ACCUMULATION_BUFFER;
+    if (!DisplayControl.AccumulationBufferIsValid) {
+        memcpy(tAccumulationPointer, tDataPointer, DISPLAY_WIDTH);
+        DisplayControl.AccumulationBufferIsValid = true;
+    } else {
+        for (uint16_t i = 0; i < DISPLAY_WIDTH; ++i) {
+            uint8_t tValue = *tDataPointer++;
+            uint8_t tAccumulatedValue = *tAccumulationPointer;
+            if (tDisplayMode == DISPLAY_MODE_AVERAGE) {
+                /*
+                 * Exponential running mean with 8 bit state. Step at least 1 towards the new value,
+                 * otherwise differences smaller than (1 << DISPLAY_AVERAGE_SHIFT) would never be reached.
+                 */
+                int16_t tDelta = (int16_t) tValue - tAccumulatedValue;
+                int16_t tStep = tDelta / (1 << DISPLAY_AVERAGE_SHIFT);
+                if (tStep == 0 && tDelta != 0) {
+                    tStep = (tDelta > 0) ? 1 : -1;
+                }
+                tAccumulatedValue += tStep;
+            } else if (tValue < tAccumulatedValue) {
+                // Peak hold. Display values are inverted, so maximum voltage is minimum value.
+                tAccumulatedValue = tValue;
+            }
+            *tAccumulationPointer++ = tAccumulatedValue;
+        }
+    }
+    drawDataBuffer(ACCUMULATION_BUFFER, COLOR_DATA_RUN, DisplayControl.EraseColor);
+}
+
+/*
+ * Spectrum of FFT_NUMBER_OF_SAMPLES values starting at the current scroll position.
+ * The peak is at the top of the chart and each grid line is 10 dB lower.
+ * The chart is sent with one drawChartByteBuffer() call, each bin is FFT_PIXEL_PER_BIN pixel wide.
+ */
+void computeAndDrawFFT(void) {
+    uint8_t *tInputPointer = DataBufferControl.DataBufferDisplayStart;
+    uint8_t *tMaxAddress = &DataBufferControl.DataBuffer[DATABUFFER_SIZE];
+    if (MeasurementControl.TimebaseIndex < TIMEBASE_NUMBER_OF_FAST_MODES) {
+        // Only half of data buffer is filled
+        tMaxAddress = &DataBufferControl.DataBuffer[DATABUFFER_SIZE / 2];
+    }
+    if (tInputPointer > tMaxAddress - FFT_NUMBER_OF_SAMPLES) {
+        tInputPointer = tMaxAddress - FFT_NUMBER_OF_SAMPLES;
+    }
+
+    resetEquivalentTimeRecord(); // DisplayBuffer is overwritten
+    uint8_t *tFFTValues = &DataBufferControl.DisplayBuffer[0];
+    computeFFTMagnitudeHalfDB(tInputPointer, tFFTValues, DisplayControl.FFTWindow);
+    uint16_t tPeakBin = getFFTPeakBin(tFFTValues);
+    uint32_t tPeakBinShift8 = getFFTInterpolatedPeakBinShift8(tFFTValues, tPeakBin);
+    uint8_t tPeakHalfDB = tFFTValues[tPeakBin];
+
+    /*
+     * Convert to chart values with 4 pixel per dB.
+     * Start with the last bin, since the values are expanded in place.
+     */
+    uint8_t *tDisplayPointer = &DataBufferControl.DisplayBuffer[DISPLAY_WIDTH];
+    for (int16_t i = FFT_NUMBER_OF_BINS - 1; i >= 0; --i) {
+        uint16_t tChartValue = 0;
+        if (tFFTValues[i] < tPeakHalfDB) {
+            tChartValue = (tPeakHalfDB - tFFTValues[i]) * (FFT_PIXEL_PER_DB / 2);
+            if (tChartValue > FFT_CHART_HEIGHT - 1) {
+                tChartValue = FFT_CHART_HEIGHT - 1;
+            }
+        }
+        for (uint8_t j = 0; j < FFT_PIXEL_PER_BIN; ++j) {
+            *--tDisplayPointer = tChartValue;
+        }
+    }
+
+    for (uint16_t tYPos = FFT_CHART_TOP; tYPos < DISPLAY_HEIGHT; tYPos += 10 * FFT_PIXEL_PER_DB) {
+        BlueDisplay1.drawLineRel(0, tYPos, DISPLAY_WIDTH, 0, COLOR_GRID_LINES);
+    }
+    BlueDisplay1.drawChartByteBuffer(0, FFT_CHART_TOP, COLOR_DATA_HOLD, COLOR_BACKGROUND_DSO, DataBufferControl.DisplayBuffer,
+            sizeof(DataBufferControl.DisplayBuffer));
+
+    /*
+     * Peak frequency = bin / (number of samples * sample period)
+     */
+    float tSamplePeriodMicros = (pgm_read_float(&TimebaseExactDivValuesMicros[MeasurementControl.TimebaseIndex])
+            * DisplayControl.XScale) / TIMING_GRID_WIDTH;
+    float tPeakHertz = (tPeakBinShift8 * (1000000.0 / 256.0)) / (FFT_NUMBER_OF_SAMPLES * tSamplePeriodMicros);
+    char tUnitChar = ' ';
+    if (tPeakHertz >= 1000) {
+        tPeakHertz /= 1000;
+        tUnitChar = 'k';
+    }
+    char tFrequencyStringBuffer[8];
+    dtostrf(tPeakHertz, 7, 3, tFrequencyStringBuffer);
+    strcpy_P(sStringBuffer, reinterpret_cast<const char*>(pgm_read_word(&FFTWindowStrings[DisplayControl.FFTWindow])));
+    snprintf_P(&sStringBuffer[strlen(sStringBuffer)], sizeof(sStringBuffer) - strlen(sStringBuffer),
+            PSTR(" peak %s%cHz  10dB/div"), tFrequencyStringBuffer, tUnitChar);
+    BlueDisplay1.drawText(INFO_LEFT_MARGIN, 0, sStringBuffer, FONT_SIZE_INFO_SHORT, COLOR16_BLACK, COLOR_INFO_BACKGROUND);
+}
+
 void clearDisplayedChart(uint8_t *aDisplayBufferPtr) {
     BlueDisplay1.drawChartByteBuffer(0, 0, COLOR_BACKGROUND_DSO, COLOR16_NO_BACKGROUND, aDisplayBufferPtr,
             sizeof(DataBufferControl.DisplayBuffer));
@@ -1817,6 +2289,9 @@ void drawRemainingDataBufferValues(void) {
     uint8_t tNextValueByte;
     uint8_t tValueByte;
     uint16_t tBufferIndex = DataBufferControl.DataBufferNextDrawIndex;
+    if (MeasurementControl.EquivalentTimeSweepCount != 0) {
+        resetEquivalentTimeRecord(); // DisplayBuffer is overwritten below
+    }
 
     while (DataBufferControl.DataBufferNextDrawPointer < DataBufferControl.DataBufferNextInPointer && tBufferIndex < DISPLAY_WIDTH) {
         /*
@@ -2022,6 +2497,22 @@ void printInfo(bool aRecomputeValues) {
         if (MeasurementControl.TriggerDelayMode != TRIGGER_DELAY_NONE) {
             strcpy_P(&sStringBuffer[35], PSTR(" del "));
             printfTriggerDelay(&sStringBuffer[40], MeasurementControl.TriggerDelayMillisOrMicros);
+        } else if (isEquivalentTimeActive()) {
+            /*
+             * Equivalent time convergence - acquired columns in percent and sweeps of current record
+             */
+            snprintf_P(&sStringBuffer[35], sizeof(sStringBuffer) - 35, PSTR(" ets%4u%%%3u"),
+                    (uint16_t) ((MeasurementControl.EquivalentTimeValidSlots * 100UL) / DISPLAY_WIDTH),
+                    MeasurementControl.EquivalentTimeSweepCount);
+        } else {
+            /*
+             * RMS - 11 character including leading space. Computed from average (DC) and standard deviation (AC) part.
+             */
+            strcpy_P(&sStringBuffer[35], PSTR(" rms "));
+            tVoltage = (int16_t) MeasurementControl.ValueAverage - tACOffset;
+            tVoltage = tRefMultiplier * sqrt((tVoltage * tVoltage) + sq((float) MeasurementControl.RawValueStandardDeviation));
+            dtostrf(tVoltage, 5, tPrecision, &sStringBuffer[40]);
+            strcpy_P(&sStringBuffer[45], PSTR("V"));
         }
 
         BlueDisplay1.drawText(INFO_LEFT_MARGIN, FONT_SIZE_INFO_LONG, sStringBuffer, FONT_SIZE_INFO_LONG, COLOR16_BLACK,
@@ -2248,6 +2739,8 @@ uint8_t changeTimeBaseValue(int8_t aChangeIndexValue) {
     } else {
         DisplayControl.XScale = 1;
     }
+    resetEquivalentTimeRecord();
+    resetDisplayAccumulation();
     if (tStartNewAcquisition) {
         startAcquisition();
     }
@@ -2298,6 +2791,17 @@ uint16_t getInputRawFromDisplayValue(uint8_t aDisplayValue) {
  * computes corresponding voltage from display y position (DISPLAY_HEIGHT - 1 -> 0 volt)
  */
 float getFloatFromDisplayValue(uint8_t aDisplayValue) {
+    int16_t tRaw = getInputRawFromDisplayValue(aDisplayValue);
+    if (MeasurementControl.ChannelIsACMode) {
+        tRaw -= MeasurementControl.RawDSOReadingACZero;
+    }
+    return getFloatFromRawValue(tRaw);
+}
+
+/*
+ * computes input voltage from raw ADC value or difference of raw values e.g. peak to peak, using current reference and range
+ */
+float getFloatFromRawValue(int16_t aRawValue) {
     float tFactor;
     if (MeasurementControl.ChannelHasActiveAttenuator) {
         tFactor = 2.0 / 1.1;
@@ -2309,12 +2813,8 @@ float getFloatFromDisplayValue(uint8_t aDisplayValue) {
     } else {
         tFactor *= 1.1 / 1024.0;
     }
-    int16_t tRaw = getInputRawFromDisplayValue(aDisplayValue);
-    if (MeasurementControl.ChannelIsACMode) {
-        tRaw -= MeasurementControl.RawDSOReadingACZero;
-    }
-// cannot multiply tRaw with getAttenuatorFactor() before since it can lead to 16 bit overflow
-    tFactor *= tRaw;
+// cannot multiply aRawValue with getAttenuatorFactor() before since it can lead to 16 bit overflow
+    tFactor *= aRawValue;
     tFactor *= getAttenuatorFactor();
     return tFactor;
 }
@@ -255,10 +255,10 @@ extern const float TimebaseExactDivValuesMicros[] PROGMEM;
 
 extern uint8_t sLastPickerValue;
 
+extern BDButton TouchButtonFFT;
 #if defined(__AVR__)
 extern BDButton TouchButtonADCReference;
 #else
-extern BDButton TouchButtonFFT;
 extern BDButton TouchButtonShowPretriggerValuesOnOff;
 extern BDButton TouchButtonDSOMoreSettings;
 extern BDButton TouchButtonCalibrateVoltage;
@@ -385,6 +385,14 @@ void doSetTriggerDelay(float aValue);
 #if defined(__AVR__)
 void doADCReference(BDButton *aTheTouchedButton, int16_t aValue);
 void doSlowBluetoothMode(BDButton *aTheTouchedButton, int16_t aValue);
+void doPretriggerSize(BDButton *aTheTouchedButton, int16_t aValue);
+void doEquivalentTimeMode(BDButton *aTheTouchedButton, int16_t aValue);
+void doDisplayMode(BDButton *aTheTouchedButton, int16_t aValue);
+void setDisplayModeButtonText(void);
+bool isPretriggerAvailable(void);
+void setPretriggerButtonText(void);
+void doShowFFT(BDButton *aTheTouchedButton, int16_t aValue);
+void setFFTButtonText(void);
 #else
 void doShowPretriggerValuesOnOff(BDButton * aTheTouchedButton, int16_t aValue);
 void doShowFFT(BDButton * aTheTouchedButton, int16_t aValue);
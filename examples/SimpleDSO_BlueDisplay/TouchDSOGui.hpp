@@ -81,47 +81,56 @@ void computeMinMax(void) {
 }
 #endif
 
-void computePeriodFrequency(void) {
 #if defined(__AVR__)
-    /*
-     * Scan data buffer (8 Bit display (!inverted!) values) for trigger conditions.
-     * Assume that first value is the first valid after a trigger
-     * (which does not hold for fast timebases and delayed or external trigger)
-     */
-    uint8_t *tDataBufferPointer = &DataBufferControl.DataBuffer[0];
-    uint8_t tValue;
-    int16_t tCount;
-    uint16_t i;
-    uint16_t tStartPositionForPulsPause = 0; // Start position != 0 for TRIGGER_MODE_FREE, TRIGGER_MODE_EXTERN or delayed trigger.
-    uint16_t tFirstEndPositionForPulsPause = 0;
-    uint16_t tCountPosition = 0;
-    uint8_t tTriggerStatus = TRIGGER_STATUS_START;
-    uint8_t tTriggerStatusForFirstInterval = TRIGGER_STATUS_START;
-
-    uint8_t tActualCompareValue = getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevelHysteresis); // start with hysteresis
-
-    uint8_t tFirstTriggerLevel; // start with opposite hysteresis for measurement of first interval
-    if (MeasurementControl.TriggerSlopeRising) {
-        tFirstTriggerLevel = getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel + MeasurementControl.RawHysteresis);
-    } else {
-        tFirstTriggerLevel = getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel - MeasurementControl.RawHysteresis);
-    }
+/*
+ * Trigger conditions and sums are already computed by processStreamingMeasurement() while acquiring by ISR,
+ * so only the results must be converted here. For fast modes, the values are processed here.
+ */
+void computePeriodFrequency(void) {
+    StreamingMeasurementStruct *tMeasurement = &StreamingMeasurement;
+    processStreamingMeasurement(tMeasurement->DeferredEndPointer); // does nothing for ISR acquisition or if already done
 
     MeasurementControl.PeriodFirst = 0;
     MeasurementControl.PeriodSecond = 0;
+    if (tMeasurement->FirstEndIndex != 0) {
+        MeasurementControl.PeriodFirst = getMicrosFromHorizontalDisplayValue(tMeasurement->FirstIntervalLength, 1);
+    }
+    if (tMeasurement->CrossingCount >= 1) {
+        MeasurementControl.PeriodSecond = getMicrosFromHorizontalDisplayValue(tMeasurement->SecondIntervalLength, 1);
+    }
 
-    if (MeasurementControl.TriggerMode >= TRIGGER_MODE_FREE || MeasurementControl.TriggerDelayMode != TRIGGER_DELAY_NONE) {
-        /*
-         * For TRIGGER_MODE_FREE, TRIGGER_MODE_EXTERN or delayed trigger first display value is not any trigger,
-         * so start with search for begin of period.
-         */
-        tCount = -1;
+    /*
+     * Standard deviation of display values, which is the AC part of the RMS value.
+     * Scale to raw values before rounding, to keep the fraction of the display value.
+     */
+    MeasurementControl.RawValueStandardDeviation = 0;
+    uint16_t tNumberOfSamples = tMeasurement->SampleIndex;
+    if (tNumberOfSamples > 0) {
+        float tAverage = (float) tMeasurement->IntegrateValue / tNumberOfSamples;
+        float tVariance = ((float) tMeasurement->IntegrateSquareValue / tNumberOfSamples) - (tAverage * tAverage);
+        if (tVariance > 0) {
+            MeasurementControl.RawValueStandardDeviation = (sqrt(tVariance) * (1 << MeasurementControl.ShiftValue)) + 0.5;
+        }
+    }
+
+    /*
+     * compute period and frequency
+     */
+    if (tMeasurement->CrossingCount <= 0) {
+        MeasurementControl.PeriodMicros = 0;
+        MeasurementControl.FrequencyHertz = 0;
     } else {
-        // First display value is the first after triggering condition so we have at least one trigger, but still no period.
-        tCount = 0;
+        uint32_t tPeriodMicros = getMicrosFromHorizontalDisplayValue(
+                tMeasurement->LastCrossingIndex - tMeasurement->StartIndex, tMeasurement->CrossingCount);
+        MeasurementControl.PeriodMicros = tPeriodMicros;
+        // frequency
+        float tHertz = 1000000.0 / tPeriodMicros;
+        MeasurementControl.FrequencyHertz = tHertz + 0.5;
     }
-    for (i = 0; i < DISPLAY_WIDTH; ++i) {
+}
+
 #else
+void computePeriodFrequency(void) {
     /**
      * Get period and frequency and average for display
      *
@@ -164,17 +173,11 @@ void computePeriodFrequency(void) {
      * Use only max value for period
      */
     for (int i = 0; i < tAcquisitionSize; ++i) {
-#endif
         tValue = *tDataBufferPointer;
 
         bool tValueGreaterCompareValue = (tValue > tActualCompareValue); // variable name is correct for rising slope!
-#if defined(__AVR__)
-        // Since all values are inverted Display values, we have to use just the inverted condition -> toggle compare result if (TriggerSlopeRising == true)
-        tValueGreaterCompareValue = tValueGreaterCompareValue ^ MeasurementControl.TriggerSlopeRising;
-#else
         // toggle compare result if TriggerSlopeRising == false
         tValueGreaterCompareValue = tValueGreaterCompareValue ^ (!MeasurementControl.TriggerSlopeRising);
-#endif
         /*
          * First value is the first sample after triggering condition (including delay)
          */
@@ -184,13 +187,8 @@ void computePeriodFrequency(void) {
              * First wait for signal to go beyond hysteresis, then check for crossing trigger level
              */
             bool tValueLessThanTriggerForFirstPeriod = (tValue < tFirstTriggerLevel);
-#if defined(__AVR__)
-            // Since all values are inverted Display values, we have to use just the inverted condition -> toggle compare result if (TriggerSlopeRising == true)
-            tValueLessThanTriggerForFirstPeriod = tValueLessThanTriggerForFirstPeriod ^ MeasurementControl.TriggerSlopeRising;
-#else
             // toggle compare result if TriggerSlopeRising == false
             tValueLessThanTriggerForFirstPeriod = tValueLessThanTriggerForFirstPeriod ^ (!MeasurementControl.TriggerSlopeRising);
-#endif
 
             if (tTriggerStatusForFirstInterval == TRIGGER_STATUS_START) {
                 // Wait for signal to go beyond hysteresis
@@ -218,11 +216,7 @@ void computePeriodFrequency(void) {
             // falling slope - wait for value above hysteresis value
             if (!tValueGreaterCompareValue) {
                 tTriggerStatus = TRIGGER_STATUS_AFTER_HYSTERESIS;
-#if defined(__AVR__)
-                tActualCompareValue = getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevel);
-#else
                 tActualCompareValue = MeasurementControl.RawTriggerLevel;
-#endif
             }
         } else {
             /*
@@ -232,10 +226,6 @@ void computePeriodFrequency(void) {
              */
 
             if (tValueGreaterCompareValue) {
-#if defined(__AVR__)
-                tTriggerStatus = TRIGGER_STATUS_START;
-                tActualCompareValue = getDisplayFromRawInputValue(MeasurementControl.RawTriggerLevelHysteresis);
-#else
                 if ((tPeriodDelta) < MIN_SAMPLES_PER_PERIOD_FOR_RELIABLE_FREQUENCY_VALUE) {
                     // found new trigger in less than MIN_SAMPLES_PER_PERIOD_FOR_RELIABLE_FREQUENCY_VALUE samples => no reliable value
                     tReliableValue = false;
@@ -251,7 +241,6 @@ void computePeriodFrequency(void) {
                     tPeriodDelta = 0;
                     // found and search for next slope
                     tIntegrateValueForTotalPeriods = tIntegrateValue;
-#endif
                 tCount++;
                 if (tCount == 0) {
                     // set start position for TRIGGER_MODE_FREE, TRIGGER_MODE_EXTERN or delayed trigger.
@@ -261,12 +250,9 @@ void computePeriodFrequency(void) {
                     MeasurementControl.PeriodSecond = getMicrosFromHorizontalDisplayValue(i - tFirstEndPositionForPulsPause, 1);
                 }
                 tCountPosition = i;
-#if !defined(__AVR__)
                 }
-#endif
             }
         }
-#if !defined(__AVR__)
         if (MeasurementControl.isEffectiveMinMaxMode) {
             uint16_t tValueMin = *(tDataBufferPointer + DATABUFFER_MIN_OFFSET);
             tIntegrateValue += (tValue + tValueMin) / 2;
@@ -275,10 +261,8 @@ void computePeriodFrequency(void) {
             tIntegrateValue += tValue;
         }
         tPeriodDelta++;
-#endif
         tDataBufferPointer++;
     } // for
-#if !defined(__AVR__)
     /*
      * check for plausi of period values
      * allow delta of periods to be at least 1/8 period + 3
@@ -287,31 +271,20 @@ void computePeriodFrequency(void) {
     if (((tCountPosition / (8 * tCount)) + 3) < tPeriodDelta) {
         tReliableValue = false;
     }
-#endif
 
     /*
      * compute period and frequency
      */
-#if defined(__AVR__)
-    if (tCount <= 0) {
-#else
     if (tCountPosition <= 0 || tCount <= 0 || !tReliableValue) {
         MeasurementControl.FrequencyHertz = 0;
         MeasurementControl.RawValueAverage = (tIntegrateValue + (tAcquisitionSize / 2)) / tAcquisitionSize;
-#endif
         MeasurementControl.PeriodMicros = 0;
         MeasurementControl.FrequencyHertz = 0;
     } else {
-#if defined(__AVR__)
-        tCountPosition -= tStartPositionForPulsPause;
-        uint32_t tPeriodMicros = getMicrosFromHorizontalDisplayValue(tCountPosition, tCount);
-        MeasurementControl.PeriodMicros = tPeriodMicros;
-#else
         MeasurementControl.RawValueAverage = (tIntegrateValueForTotalPeriods + (tCountPosition / 2)) / tCountPosition;
 
         // compute microseconds per period
         float tPeriodMicros = getMicrosFromHorizontalDisplayValue(tCountPosition, tCount) + 0.0005;
-#endif
         MeasurementControl.PeriodMicros = tPeriodMicros;
         // frequency
         float tHertz = 1000000.0 / tPeriodMicros;
@@ -319,6 +292,7 @@ void computePeriodFrequency(void) {
     }
     return;
 }
+#endif
 
 /**
  * compute new trigger value and hysteresis
@@ -400,6 +374,7 @@ void setACMode(bool aNewACMode) {
         // no OffsetAutomatic for AC mode
         MeasurementControl.OffsetMode = OFFSET_MODE_0_VOLT;
         MeasurementControl.OffsetValue = 0;
+        resetDisplayAccumulation(); // accumulated values have the old offset
         if (MeasurementControl.AttenuatorType < ATTENUATOR_TYPE_ACTIVE_ATTENUATOR) {
             digitalWriteFast(AC_DC_RELAY_PIN, HIGH);
         }
@@ -454,13 +429,28 @@ void clearInfo(uint8_t aOldMode) {
 /***********************************************************************
  * GUI initialization
  ***********************************************************************/
+BDButton TouchButtonFFT;
 #if defined(__AVR__)
 BDButton TouchButtonSlowBluetoothMode;
 BDButton TouchButtonADCReference;
+BDButton TouchButtonPretrigger;
+BDButton TouchButtonEquivalentTime;
+BDButton TouchButtonDisplayMode;
+const char DisplayModeButtonStringNormal[] PROGMEM = "Normal";
+const char DisplayModeButtonStringAverage[] PROGMEM = "Average";
+const char DisplayModeButtonStringPeakHold[] PROGMEM = "Peak\nhold";
+const char DisplayModeButtonStringPersistence[] PROGMEM = "Persist";
+const char *const DisplayModeButtonStrings[DISPLAY_MODE_NUMBER_OF_MODES] PROGMEM = { DisplayModeButtonStringNormal,
+        DisplayModeButtonStringAverage, DisplayModeButtonStringPeakHold, DisplayModeButtonStringPersistence };
+const char FFTWindowStringRectangle[] PROGMEM = "Rect";
+const char FFTWindowStringHann[] PROGMEM = "Hann";
+const char FFTWindowStringHamming[] PROGMEM = "Hamming";
+const char FFTWindowStringBlackman[] PROGMEM = "Blackman";
+const char *const FFTWindowStrings[FFT_NUMBER_OF_WINDOWS] PROGMEM = { FFTWindowStringRectangle, FFTWindowStringHann,
+        FFTWindowStringHamming, FFTWindowStringBlackman };
 const char ReferenceButtonVCC[] PROGMEM = "Ref VCC";
 const char ReferenceButton1_1V[] PROGMEM = "Ref 1.1V";
 #else
-BDButton TouchButtonFFT;
 BDButton TouchButtonShowPretriggerValuesOnOff;
 BDButton TouchButtonDSOMoreSettings;
 BDButton TouchButtonCalibrateVoltage;
@@ -577,6 +567,12 @@ void initDSOGUI(void) {
     TouchButtonLoad.init(BUTTON_WIDTH_5_POS_2, tPosY, BUTTON_WIDTH_5, START_PAGE_BUTTON_HEIGHT,
             COLOR_GUI_SOURCE_TIMEBASE, "Load", TEXT_SIZE_11, BUTTON_FLAG_NO_BEEP_ON_TOUCH, MODE_LOAD, &doStoreLoadAcquisitionData);
 #endif
+#if defined(__AVR__)
+// Button for average, peak hold and persistence
+    TouchButtonDisplayMode.init(0, tPosY, BUTTON_WIDTH_3, START_PAGE_BUTTON_HEIGHT, COLOR_GUI_CONTROL, "", TEXT_SIZE_18,
+            FLAG_BUTTON_DO_BEEP_ON_TOUCH, 0, &doDisplayMode);
+    setDisplayModeButtonText();
+#endif
 
 // big start stop button
     TouchButtonStartStopDSOMeasurement.init(BUTTON_WIDTH_3_POS_3, tPosY, BUTTON_WIDTH_3,
@@ -585,7 +581,12 @@ void initDSOGUI(void) {
 
 // 4. row
     tPosY += 2 * START_PAGE_ROW_INCREMENT;
-#if !defined(__AVR__)
+#if defined(__AVR__)
+// Button for FFT window. Spectrum is shown on chart page, if stopped.
+    TouchButtonFFT.init(0, tPosY, BUTTON_WIDTH_3, START_PAGE_BUTTON_HEIGHT, COLOR_GUI_CONTROL, "", TEXT_SIZE_18,
+            FLAG_BUTTON_DO_BEEP_ON_TOUCH, 0, &doShowFFT);
+    setFFTButtonText();
+#else
 // Button for show FFT - only for Start and Chart pages. Invisible if running.
     TouchButtonFFT.init(0, tPosY, BUTTON_WIDTH_3, BUTTON_HEIGHT_4, 0, "FFT", TEXT_SIZE_22,
             FLAG_BUTTON_DO_BEEP_ON_TOUCH | FLAG_BUTTON_TYPE_TOGGLE_RED_GREEN_MANUAL_REFRESH, DisplayControl.ShowFFT, &doShowFFT);
@@ -683,7 +684,12 @@ void initDSOGUI(void) {
 // 4. row
     tPosY += SETTINGS_PAGE_ROW_INCREMENT;
 
-#if !defined(__AVR__)
+#if defined(__AVR__)
+// Button for size of pretrigger area
+    TouchButtonPretrigger.init(0, tPosY, BUTTON_WIDTH_3, SETTINGS_PAGE_BUTTON_HEIGHT, COLOR_GUI_TRIGGER, "", TEXT_SIZE_11,
+            FLAG_BUTTON_DO_BEEP_ON_TOUCH, 0, &doPretriggerSize);
+    setPretriggerButtonText();
+#else
 // Button for min/max acquisition mode
 #  if defined(SUPPORT_LOCAL_DISPLAY)
     TouchButtonMinMaxMode.init(SLIDER_DEFAULT_BAR_WIDTH + 6, tPosY, BUTTON_WIDTH_3 - (SLIDER_DEFAULT_BAR_WIDTH + 6),
@@ -700,6 +706,13 @@ void initDSOGUI(void) {
             TEXT_SIZE_11, FLAG_BUTTON_DO_BEEP_ON_TOUCH, 0, &doOffsetMode);
     setAutoOffsetButtonText();
 
+#if defined(__AVR__)
+// Button for equivalent time sampling
+    TouchButtonEquivalentTime.init(BUTTON_WIDTH_3_POS_3, tPosY, BUTTON_WIDTH_3, SETTINGS_PAGE_BUTTON_HEIGHT, 0, "Equivalent\ntime",
+            TEXT_SIZE_11, FLAG_BUTTON_DO_BEEP_ON_TOUCH | FLAG_BUTTON_TYPE_TOGGLE_RED_GREEN, MeasurementControl.isEquivalentTimeMode,
+            &doEquivalentTimeMode);
+#endif
+
 #if defined(FUTURE)
 // Button for trigger line mode
     TouchButtonDrawModeTriggerLine.init(BUTTON_WIDTH_3_POS_3, tPosY, BUTTON_WIDTH_3, SETTINGS_PAGE_BUTTON_HEIGHT,
@@ -833,6 +846,13 @@ void redrawDisplay() {
             drawStartPage();
         } else if (DisplayControl.DisplayPage == DSO_PAGE_CHART) {
             activateChartGui();
+#if defined(__AVR__)
+            if (DisplayControl.ShowFFT) {
+                // FFT has its own grid and info line
+                computeAndDrawFFT();
+                return;
+            }
+#endif
             drawGridLinesWithHorizLabelsAndTriggerLine();
             drawMinMaxLines();
             // draw from last scroll position
@@ -845,6 +865,9 @@ void redrawDisplay() {
             printInfo();
         } else if (DisplayControl.DisplayPage == DSO_PAGE_SETTINGS) {
             drawDSOSettingsPage();
+        } else if (DisplayControl.DisplayPage == DSO_PAGE_FREQUENCY) {
+            // DSO was stopped while frequency page is shown, e.g. at end of a frequency sweep
+            drawFrequencyGeneratorPage();
         }
     }
 }
@@ -857,11 +880,14 @@ void drawStartPage(void) {
 #if defined(LOCAL_FILESYSTEM_EXISTS)
     TouchButtonStore.drawButton();
     TouchButtonLoad.drawButton();
+#endif
+#if defined(__AVR__)
+    TouchButtonDisplayMode.drawButton();
 #endif
     TouchButtonStartStopDSOMeasurement.drawButton();
 // 4. Row
-#if !defined(__AVR__)
     TouchButtonFFT.drawButton();
+#if !defined(__AVR__)
     TouchButtonMainHome.drawButton();
 #endif
     TouchButtonSettingsPage.drawButton();
@@ -932,10 +958,18 @@ void drawDSOSettingsPage(void) {
     TouchButtonChannelSelect.drawButton();
 
 // 4. Row
-#if !defined(__AVR__)
+#if defined(__AVR__)
+    setPretriggerButtonText(); // Text depends on the timebase, which may have changed since last draw. Draws the button.
+    if (!isPretriggerAvailable()) {
+        TouchButtonPretrigger.deactivate();
+    }
+#else
     TouchButtonMinMaxMode.drawButton();
 #endif
     TouchButtonAutoOffsetMode.drawButton();
+#if defined(__AVR__)
+    TouchButtonEquivalentTime.drawButton();
+#endif
 #if defined(FUTURE)
     TouchButtonDrawModeTriggerLine.drawButton();
 #endif
@@ -1265,6 +1299,40 @@ void setTriggerDelayText(void) {
     TouchButtonTriggerDelay.setText(sStringBuffer, (DisplayControl.DisplayPage == DSO_PAGE_SETTINGS));
 }
 
+void setDisplayModeButtonText(void) {
+    TouchButtonDisplayMode.setText(
+            reinterpret_cast<const __FlashStringHelper*>(pgm_read_word(&DisplayModeButtonStrings[DisplayControl.DisplayMode])),
+            (DisplayControl.DisplayPage == DSO_PAGE_START));
+}
+
+void setFFTButtonText(void) {
+    strcpy_P(sStringBuffer, PSTR("FFT\n"));
+    if (DisplayControl.ShowFFT) {
+        strcpy_P(&sStringBuffer[4], reinterpret_cast<const char*>(pgm_read_word(&FFTWindowStrings[DisplayControl.FFTWindow])));
+    } else {
+        strcpy_P(&sStringBuffer[4], PSTR("off"));
+    }
+    TouchButtonFFT.setText(sStringBuffer, (DisplayControl.DisplayPage == DSO_PAGE_START));
+}
+
+/*
+ * Pretrigger values are only recorded by the fast ADC loop for 101 and 201 us/div.
+ * The ISR trigger search and the ultra fast loop have no time for the ring buffer.
+ */
+bool isPretriggerAvailable(void) {
+    return MeasurementControl.AcquisitionFastMode && MeasurementControl.TimebaseIndex > TIMEBASE_INDEX_ULTRAFAST_MODES;
+}
+
+void setPretriggerButtonText(void) {
+    if (isPretriggerAvailable()) {
+        snprintf_P(sStringBuffer, sizeof(sStringBuffer), PSTR("Pretrigger\n%u%%"),
+                (DisplayControl.DatabufferPreTriggerDisplaySize * 100) / DISPLAY_WIDTH);
+    } else {
+        strcpy_P(sStringBuffer, PSTR("Pretrigger\nn.a."));
+    }
+    TouchButtonPretrigger.setText(sStringBuffer, (DisplayControl.DisplayPage == DSO_PAGE_SETTINGS));
+}
+
 void setReferenceButtonText(void) {
     const char *tText;
     if (MeasurementControl.ADCReferenceShifted == (DEFAULT << REFS0)) {
@@ -1479,6 +1547,8 @@ void doOffsetMode(BDButton *aTheTouchedButton, int16_t aValue) {
         setAutoRangeModeAndButtonText(true);
 #if defined(__AVR__)
         MeasurementControl.OffsetValue = 0;
+        resetEquivalentTimeRecord();
+        resetDisplayAccumulation();
 #else
         setOffsetGridCountAccordingToACMode();
 
@@ -1681,6 +1751,55 @@ void doPromptForTriggerDelay(BDButton *aTheTouchedButton, int16_t aValue) {
     BlueDisplay1.getNumberWithShortPrompt(&doSetTriggerDelay, F("Trigger delay [\xB5s]"));
 }
 
+/*
+ * Cycle pretrigger area through 0, 1/4 and 1/2 of display width.
+ * Only possible for the 101 and 201 us/div timebases, the button is deactivated for all others.
+ */
+void doPretriggerSize(BDButton *aTheTouchedButton, int16_t aValue) {
+    if (!isPretriggerAvailable()) {
+        return;
+    }
+    uint16_t tNewSize = DisplayControl.DatabufferPreTriggerDisplaySize + (DISPLAY_WIDTH / 4);
+    if (tNewSize > DISPLAY_WIDTH / 2) {
+        tNewSize = 0;
+    }
+    DisplayControl.DatabufferPreTriggerDisplaySize = tNewSize;
+    setPretriggerButtonText();
+}
+
+void doDisplayMode(BDButton *aTheTouchedButton, int16_t aValue) {
+    uint8_t tNewMode = DisplayControl.DisplayMode + 1;
+    if (tNewMode >= DISPLAY_MODE_NUMBER_OF_MODES) {
+        tNewMode = DISPLAY_MODE_NORMAL;
+    }
+    DisplayControl.DisplayMode = tNewMode;
+    resetDisplayAccumulation();
+    setDisplayModeButtonText();
+}
+
+/*
+ * Cycle through off and the FFT windows
+ */
+void doShowFFT(BDButton *aTheTouchedButton, int16_t aValue) {
+    if (!DisplayControl.ShowFFT) {
+        DisplayControl.ShowFFT = true;
+        DisplayControl.FFTWindow = FFT_WINDOW_RECTANGLE;
+    } else if (DisplayControl.FFTWindow < FFT_NUMBER_OF_WINDOWS - 1) {
+        DisplayControl.FFTWindow++;
+    } else {
+        DisplayControl.ShowFFT = false;
+    }
+    setFFTButtonText();
+}
+
+/*
+ * Only effective for the timebases with XScale > 1, and for internal trigger without delay
+ */
+void doEquivalentTimeMode(BDButton *aTheTouchedButton, int16_t aValue) {
+    MeasurementControl.isEquivalentTimeMode = aValue;
+    resetEquivalentTimeRecord();
+}
+
 #else
 
 void doShowPretriggerValuesOnOff(BDButton *aTheTouchedButton, int16_t aValue) {
@@ -2,14 +2,13 @@
  * Waveforms.cpp
  *
  * Code uses 16 bit AVR Timer1 and generates a 62.5 kHz PWM signal with 8 Bit resolution.
- * After every PWM cycle an interrupt handler sets a new PWM value, resulting in a sine, triangle or sawtooth output.
- * New value is taken by a rolling index from a table for sine, or directly computed from that index for triangle and sawtooth waveforms.
+ * After every PWM cycle an interrupt handler sets a new PWM value, resulting in a sine, triangle, sawtooth or arbitrary output.
+ * The value is taken from a table of one period by direct digital synthesis (DDS):
+ * a 32 bit phase accumulator is increased by a frequency dependent value and its upper 8 bit are the table index.
+ * The ISR has no branches and always takes the same time.
  *
- * Maximum values:                                                          Minimum values:
- * SINE: clip to minimum 8 samples per period => 128 us / 7812.5 Hz           7,421 mHz
- * SAWTOOTH: clip to minimum 16 samples per period => 256 us / 3906.25 Hz     3.725 mHz
- * TRIANGLE: clip to minimum 32 samples per period => 512 us / 1953.125 Hz    1.866 mHz
- * By using a "floating point" index increment, every frequency lower than these maximum values can be generated.
+ * All non square waveforms: clip to minimum 8 samples per period => 128 us / 7812.5 Hz. Minimum is 1 mHz.
+ * The frequency resolution is 62.5 kHz / 2^32 = 14.55 uHz.
  *
  * In CTC Mode Timer1 generates square wave from 0.119 Hz up to 8 MHz (full range of Timer1).
  * Timer1 is used by Arduino for Servo Library. For 8 bit resolution it may also be possible to use Timer2 which is used for Arduino tone().
@@ -56,11 +55,11 @@ struct FrequencyInfoStruct sFrequencyInfo;
 #define SIZE_OF_SINE_TABLE_QUARTER 32
 const uint8_t sSineTableQuarter128[SIZE_OF_SINE_TABLE_QUARTER + 1] PROGMEM = { 128, 135, 141, 147, 153, 159, 165, 171, 177, 182,
         188, 193, 199, 204, 209, 213, 218, 222, 226, 230, 234, 237, 240, 243, 245, 248, 250, 251, 253, 254, 254, 255, 255 };
-// Base period, for which exact one next value from table/computation is taken at every interrupt
-// 8 Bit PWM resolution gives 488.28125 Hz sine base frequency: 1/16 us * 256 * 128 = 16*128 = 2048 us = 488.28125 Hz
-#define BASE_PERIOD_MICROS_FOR_SINE_TABLE 2048UL // ((1/F_CPU) * PWM_RESOLUTION) * (SIZE_OF_SINE_TABLE_QUARTER * 4)
-#define BASE_PERIOD_MICROS_FOR_TRIANGLE 8176UL // (1/F_CPU) * PWM_RESOLUTION * (256+255) Values -> 122.3092 Hz
-#define BASE_PERIOD_MICROS_FOR_SAWTOOTH 4096UL // (1/F_CPU) * PWM_RESOLUTION * 256 Values -> 244.140625 Hz
+
+/*
+ * Table of one period used by ISR. In RAM to allow arbitrary waveforms.
+ */
+uint8_t sWaveformTable[DDS_TABLE_SIZE];
 
 const char FrequencyRangeChars[4] = { 'm', ' ', 'k', 'M' };
 
@@ -96,12 +95,86 @@ void initTimer1ForCTC(void) {
     TCNT1 = 0; // init counter
 }
 
+/*
+ * Fill table with one period of the built in waveforms
+ */
+void fillWaveformTable(uint8_t aWaveform) {
+    for (uint16_t i = 0; i < DDS_TABLE_SIZE; ++i) {
+        uint8_t tValue = i; // sawtooth
+        if (aWaveform == WAVEFORM_SINE) {
+            /*
+             * 64 values per quadrant, every second value is interpolated from the quarter table
+             */
+            uint8_t tQuadrant = i >> 6;
+            uint8_t tIndex = i & 0x3F;
+            if (tQuadrant & 0x01) {
+                // [90,180) and [270,360) Degree
+                tIndex = 64 - tIndex;
+            }
+            tValue = pgm_read_byte(&sSineTableQuarter128[tIndex / 2]);
+            if (tIndex & 0x01) {
+                tValue = (tValue + pgm_read_byte(&sSineTableQuarter128[(tIndex / 2) + 1]) + 1) / 2;
+            }
+            if (tQuadrant & 0x02) {
+                // [180,360) Degree  128 -> 128 ; 255 -> 1
+                tValue = -tValue;
+            }
+        } else if (aWaveform == WAVEFORM_TRIANGLE) {
+            // 0, 2, ..., 254, 255, 253, ..., 1
+            if (i < 128) {
+                tValue = i << 1;
+            } else {
+                tValue = ((255 - i) << 1) | 0x01;
+            }
+        }
+        sWaveformTable[i] = tValue;
+    }
+}
+
+void setWaveformTable(const uint8_t *aTable) {
+    memcpy(sWaveformTable, aTable, sizeof(sWaveformTable));
+    if (sFrequencyInfo.Waveform != WAVEFORM_ARBITRARY) {
+        setWaveformMode(WAVEFORM_ARBITRARY);
+    }
+}
+
+/*
+ * The points are equidistant over one period and the last point is connected with the first one.
+ * E.g. 0, 255, 128, 128 gives a rising and falling edge, followed by a plateau.
+ */
+void setWaveformTableFromPoints(const uint8_t *aPoints, uint8_t aNumberOfPoints) {
+    if (aNumberOfPoints == 0) {
+        return;
+    }
+    for (uint16_t i = 0; i < DDS_TABLE_SIZE; ++i) {
+        uint16_t tPositionShift8 = i * aNumberOfPoints; // position in 1/256 points
+        uint8_t tPointIndex = tPositionShift8 >> 8;
+        uint8_t tNextPointIndex = tPointIndex + 1;
+        if (tNextPointIndex >= aNumberOfPoints) {
+            tNextPointIndex = 0;
+        }
+        int16_t tDelta = (int16_t) aPoints[tNextPointIndex] - aPoints[tPointIndex];
+        sWaveformTable[i] = aPoints[tPointIndex] + (int16_t) (((int32_t) tDelta * (tPositionShift8 & 0xFF)) >> 8);
+    }
+    if (sFrequencyInfo.Waveform != WAVEFORM_ARBITRARY) {
+        setWaveformMode(WAVEFORM_ARBITRARY);
+    }
+}
+
+/*
+ * WAVEFORM_ARBITRARY keeps the current table content
+ */
 void setWaveformMode(uint8_t aNewMode) {
-    aNewMode &= WAVEFORM_MASK;
+    if (aNewMode >= WAVEFORM_NUMBER_OF_MODES) {
+        aNewMode = WAVEFORM_SQUARE;
+    }
     sFrequencyInfo.Waveform = aNewMode;
     if (aNewMode == WAVEFORM_SQUARE) {
         initTimer1ForCTC();
     } else {
+        if (aNewMode != WAVEFORM_ARBITRARY) {
+            fillWaveformTable(aNewMode);
+        }
         initTimer1For8BitPWM();
     }
     // start timer if not already done
@@ -128,6 +201,8 @@ const __FlashStringHelper* getWaveformModePGMString() {
         tResultString = F("Triangle");
     } else if (sFrequencyInfo.Waveform == WAVEFORM_SAWTOOTH) {
         tResultString = F("Sawtooth");
+    } else if (sFrequencyInfo.Waveform == WAVEFORM_ARBITRARY) {
+        tResultString = F("Arbitrary");
     }
     return tResultString;
 }
@@ -140,7 +215,7 @@ float getPeriodMicros() {
         tPeriodMicros = sFrequencyInfo.ControlValue.DividerInt;
         tPeriodMicros /= 8;
     } else {
-        tPeriodMicros = sFrequencyInfo.PeriodMicros;
+        tPeriodMicros = 1000000.0 / sFrequencyInfo.Frequency;
     }
     return tPeriodMicros;
 }
@@ -196,9 +271,7 @@ bool setWaveformFrequencyFromNormalizedValues() {
 }
 
 /*
- * SINE: clip to minimum 8 samples per period => 128 us / 7812.5 Hz
- * SAWTOOTH: clip to minimum 16 samples per period => 256 us / 3906.25 Hz
- * Triangle: clip to minimum 32 samples per period => 512 us / 1953.125 Hz
+ * Non square waveforms: clip to minimum 8 samples per period => 128 us / 7812.5 Hz and to 1 mHz
  * return true if clipping occurs
  */
 bool setWaveformFrequency(float aFrequency) {
@@ -207,29 +280,24 @@ bool setWaveformFrequency(float aFrequency) {
         // need initialized sFrequencyInfo structure
         hasError = setSquareWaveFrequency(aFrequency);
     } else {
-        // use shift 16 to increase resolution but avoid truncation
-        long tBasePeriodShift16 = (BASE_PERIOD_MICROS_FOR_SINE_TABLE << 16);
-        if (sFrequencyInfo.Waveform == WAVEFORM_TRIANGLE) {
-            tBasePeriodShift16 = (BASE_PERIOD_MICROS_FOR_TRIANGLE << 16);
-        } else if (sFrequencyInfo.Waveform == WAVEFORM_SAWTOOTH) {
-            tBasePeriodShift16 = (BASE_PERIOD_MICROS_FOR_SAWTOOTH << 16);
-        }
-        uint32_t tPeriodMicros = 1000000UL / aFrequency;
-        uint32_t tBaseFrequencyFactorShift16 = tBasePeriodShift16 / tPeriodMicros;
-        if (tBaseFrequencyFactorShift16 > (16L << 16)) {
-            // Clip at factor 16 (taking every 16th value) and recompute values
-            tBaseFrequencyFactorShift16 = (16L << 16);
-            tPeriodMicros = (tBasePeriodShift16 >> 16) / 16;
+        if (aFrequency > DDS_MAX_FREQUENCY) {
+            aFrequency = DDS_MAX_FREQUENCY;
             hasError = true;
-        } else if (tBaseFrequencyFactorShift16 < 1) {
-            tBaseFrequencyFactorShift16 = 1;
-            tPeriodMicros = tBasePeriodShift16;
+        } else if (aFrequency < DDS_MIN_FREQUENCY) {
+            aFrequency = DDS_MIN_FREQUENCY;
             hasError = true;
         }
+        /*
+         * PhaseIncrement = Frequency * 2^32 / SampleFrequency
+         */
+        uint32_t tPhaseIncrement = (aFrequency * (4294967296.0 / DDS_SAMPLE_FREQUENCY)) + 0.5;
         // recompute values
-        sFrequencyInfo.Frequency = 1000000.0 / tPeriodMicros;
-        sFrequencyInfo.PeriodMicros = tPeriodMicros;
-        sFrequencyInfo.ControlValue.BaseFrequencyFactorShift16 = tBaseFrequencyFactorShift16;
+        sFrequencyInfo.Frequency = tPhaseIncrement * (DDS_SAMPLE_FREQUENCY / 4294967296.0);
+        sFrequencyInfo.PeriodMicros = 1000000.0 / sFrequencyInfo.Frequency;
+        // 32 bit access is not atomic
+        noInterrupts();
+        sFrequencyInfo.ControlValue.PhaseIncrement = tPhaseIncrement;
+        interrupts();
 
         sFrequencyInfo.PrescalerRegisterValueBackup = 1;
         if (sFrequencyInfo.isOutputEnabled) {
@@ -331,116 +399,18 @@ void startWaveform() {
     TCCR1B |= sFrequencyInfo.PrescalerRegisterValueBackup;
 }
 
-//Timer1 overflow interrupt vector handler
+/*
+ * Timer1 overflow interrupt vector handler
+ * Constant runtime, no branches
+ */
 ISR(TIMER1_OVF_vect) {
-
-    static int8_t sSineTableIndex = 0;
-    static uint8_t sNumberOfQuadrant = 0;
+    static uint32_t sPhaseAccumulator = 0;
     static uint8_t sNextOcrbValue = 0;
 
 // output value at start of ISR to avoid jitter
     OCR1B = sNextOcrbValue;
-    /*
-     * Increase index by sBaseFrequencyFactor.
-     * In order to avoid floating point arithmetic in ISR, use sBaseFrequencyFactorShift16 and handle resulting residual.
-     */
-    int8_t tIndexDelta = sFrequencyInfo.ControlValue.BaseFrequencyFactorShift16 >> 16;
-// handle fraction of frequency factor
-    sFrequencyInfo.BaseFrequencyFactorAccumulator += sFrequencyInfo.ControlValue.BaseFrequencyFactorShift16 & 0xFFFF;
-    if (sFrequencyInfo.BaseFrequencyFactorAccumulator > 0x8000) {
-        /*
-         * Accumulated fraction is bigger than "half" so increase index
-         */
-        tIndexDelta++;
-        sFrequencyInfo.BaseFrequencyFactorAccumulator -= 0x10000;
-    }
-    if (tIndexDelta > 0) {
-        uint8_t tNumberOfQuadrant = sNumberOfQuadrant;
-        if (sFrequencyInfo.Waveform == WAVEFORM_SINE) {
-            uint8_t tQuadrantIncrease = 0;
-            switch (tNumberOfQuadrant) {
-            case 0: // [0,90) Degree, including 0, not including 90 Degree
-            case 2: // [180,270) Degree
-                sSineTableIndex += tIndexDelta;
-                if (sSineTableIndex >= SIZE_OF_SINE_TABLE_QUARTER) {
-                    sSineTableIndex = SIZE_OF_SINE_TABLE_QUARTER - (sSineTableIndex - SIZE_OF_SINE_TABLE_QUARTER);
-                    tQuadrantIncrease = 1;
-                }
-                break;
-            case 1: // [90,180) Degree
-            case 3: // [270,360) Degree
-                sSineTableIndex -= tIndexDelta;
-                if (sSineTableIndex <= 0) {
-                    sSineTableIndex = -sSineTableIndex;
-                    tQuadrantIncrease = 1;
-                }
-                break;
-            }
-            if (tNumberOfQuadrant & 0x02) {
-                // case 2 and 3   -128 -> 128 ; -255 -> 1
-                sNextOcrbValue = -(pgm_read_byte(&sSineTableQuarter128[sSineTableIndex]));
-            } else {
-                sNextOcrbValue = pgm_read_byte(&sSineTableQuarter128[sSineTableIndex]);
-            }
-
-            tNumberOfQuadrant = (tNumberOfQuadrant + tQuadrantIncrease) & 0x03;
-
-            /*
-             * the same as loop with variable delay
-             */
-            //    // [0,90)
-            //    for (int i = 0; i < SIZE_OF_SINE_TABLE_QUARTER; ++i) {
-            //        OCR1B = sSineTableQuarter128[i];
-            //        delayMicroseconds(sDelay);
-            //    }
-            //    // [90,180)
-            //    for (int i = SIZE_OF_SINE_TABLE_QUARTER; i > 0; i--) {
-            //        OCR1B = sSineTableQuarter128[i];
-            //        delayMicroseconds(sDelay);
-            //    }
-            //    // [180,270)
-            //    for (int i = 0; i < SIZE_OF_SINE_TABLE_QUARTER; ++i) {
-            //        OCR1B = -(sSineTableQuarter128[i]);
-            //        delayMicroseconds(sDelay);
-            //    }
-            //    // [270,360)
-            //    for (int i = SIZE_OF_SINE_TABLE_QUARTER; i > 0; i--) {
-            //        OCR1B = -(sSineTableQuarter128[i]);
-            //        delayMicroseconds(sDelay);
-            //    }
-        } else if (sFrequencyInfo.Waveform == WAVEFORM_TRIANGLE) {
-            /*
-             * Values 0 and FF are half as often as other values, so special treatment required
-             * One period from 0 to 0 consists of 256 + 255 values!
-             */
-            uint8_t tOldOcrbValue = sNextOcrbValue;
-            if (tNumberOfQuadrant == 0) {
-                // Value from 1 to FF
-                // increasing value
-                sNextOcrbValue += tIndexDelta;
-                // detect overflow (value > UINT8_MAX)
-                if (sNextOcrbValue < tOldOcrbValue) {
-                    tNumberOfQuadrant = 1;
-                    // 0->FE, 1->FD
-                    sNextOcrbValue = (~sNextOcrbValue) - 1;
-                }
-            } else {
-                // decreasing value Value from FE to 0
-                sNextOcrbValue -= tIndexDelta;
-                // detect underflow
-                if (sNextOcrbValue > tOldOcrbValue) {
-                    tNumberOfQuadrant = 0;
-                    // FF -> 1, FE -> 2
-                    sNextOcrbValue = -sNextOcrbValue;
-                }
-            }
-
-        } else if (sFrequencyInfo.Waveform == WAVEFORM_SAWTOOTH) {
-            sNextOcrbValue += tIndexDelta;
-        }
-        sNumberOfQuadrant = tNumberOfQuadrant;
-
-    }
+    sPhaseAccumulator += sFrequencyInfo.ControlValue.PhaseIncrement;
+    sNextOcrbValue = sWaveformTable[sPhaseAccumulator >> 24];
 }
 
 /*
@@ -26,7 +26,19 @@
 #define WAVEFORM_SINE       1
 #define WAVEFORM_TRIANGLE   2
 #define WAVEFORM_SAWTOOTH   3
-#define WAVEFORM_MASK       0x03
+#define WAVEFORM_ARBITRARY  4 // Table set by setWaveformTable() or setWaveformTableFromPoints()
+#define WAVEFORM_NUMBER_OF_MODES 5
+
+/*
+ * Direct digital synthesis for all non square waveforms.
+ * At each PWM cycle the 32 bit phase accumulator is increased by PhaseIncrement
+ * and its upper 8 bit are the index for the table of one period.
+ */
+#define DDS_TABLE_SIZE              256
+#define DDS_SAMPLE_FREQUENCY        (F_CPU / 256) // 62.5 kHz for 8 bit PWM
+#define DDS_MIN_SAMPLES_PER_PERIOD  8 // -> 7812.5 Hz
+#define DDS_MAX_FREQUENCY           ((float) DDS_SAMPLE_FREQUENCY / DDS_MIN_SAMPLES_PER_PERIOD)
+#define DDS_MIN_FREQUENCY           0.001 // Resolution is DDS_SAMPLE_FREQUENCY / 2^32 = 14.55 uHz
 
 #define FREQUENCY_RANGE_INDEX_MILLI_HERTZ   0
 #define FREQUENCY_RANGE_INDEX_HERTZ         1
@@ -36,7 +48,7 @@
 struct FrequencyInfoStruct {
     union {
         uint32_t DividerInt; // Only for square wave and for info - may be (divider * prescaler) - resolution is 1/8 us
-        uint32_t BaseFrequencyFactorShift16; // Value used by ISR - only for NON square wave
+        uint32_t PhaseIncrement; // Value used by ISR - only for NON square wave
     } ControlValue;
     uint32_t PeriodMicros; // only for display purposes
     float Frequency; // use float, since we have mHz.
@@ -55,8 +67,6 @@ struct FrequencyInfoStruct {
     /*
      * Internal (private) values
      */
-    int32_t BaseFrequencyFactorAccumulator; //  Value used by ISR - used to handle fractions of BaseFrequencyFactorShift16
-
     uint8_t PrescalerRegisterValueBackup; // backup of old value for start/stop of square wave
 };
 extern struct FrequencyInfoStruct sFrequencyInfo;
@@ -80,6 +90,13 @@ bool setSquareWaveFrequency(float aFrequency);
 void stopWaveform();
 void startWaveform();
 
+/*
+ * Arbitrary waveform. The table is shared with the built in waveforms,
+ * so it must be set again after switching to WAVEFORM_ARBITRARY from another non square waveform.
+ */
+void setWaveformTable(const uint8_t *aTable); // aTable has DDS_TABLE_SIZE values
+void setWaveformTableFromPoints(const uint8_t *aPoints, uint8_t aNumberOfPoints); // Equidistant points, linear interpolated
+
 // utility Function
 void computeSineTableValues(uint8_t aSineTable[], unsigned int aNumber);
 
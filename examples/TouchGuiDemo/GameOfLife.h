@@ -2,7 +2,7 @@
  *  GameOfLife.h
  *
  *
- *  Copyright (C) 2012-2023  Armin Joachimsmeyer
+ *  Copyright (C) 2012-2026  Armin Joachimsmeyer
  *
  *  This file is part of BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
  *  This file is part of STMF3-Discovery-Demos https://github.com/ArminJo/STMF3-Discovery-Demos.
@@ -32,7 +32,7 @@
 
 #define GAME_OF_LIFE_MAX_GEN  (600) //max generations
 #if defined(SUPPORT_LOCAL_DISPLAY) && (defined(RAMEND) || defined(RAMSIZE)) && (RAMEND <= 0x8FF || RAMSIZE < 0x8FF)
-// One cell requires one byte
+// One column requires 5 * 2 bytes here
 #define GAME_OF_LIFE_X_SIZE   (20)
 #define GAME_OF_LIFE_Y_SIZE   (15)
 #else
@@ -40,16 +40,29 @@
 #define GAME_OF_LIFE_Y_SIZE   (30)
 #endif
 
+#if GAME_OF_LIFE_Y_SIZE > 32
+#error GAME_OF_LIFE_Y_SIZE must not be greater than 32, since a column is stored in a 32 bit word
+#endif
+
 /*
- * Cell bit meanings
+ * A column of cells is stored as bit vector, bit y is the cell at y.
+ * This allows to compute the next generation of a whole column with a few bitwise operations.
  */
-#define CELL_IS_EMPTY   (0x00)
-#define CELL_JUST_DIED  (0x04)
-#define CELL_IS_ALIVE   (0x08)
-#define CELL_IS_NEW     (0x10)
-#define CELL_DIE_HISTORY_COUNTER_MASK (0x03) // Lower 2 bits are used as a die history counter from 2 to 0
+#if GAME_OF_LIFE_Y_SIZE <= 16
+typedef uint16_t GameOfLifeColumn_t;
+#else
+typedef uint32_t GameOfLifeColumn_t;
+#endif
+
+struct GameOfLifeColumnStruct {
+    GameOfLifeColumn_t Alive;
+    GameOfLifeColumn_t JustDied;    // Died in the last generation, shown with JUST_DIED_COLOR
+    GameOfLifeColumn_t LongerDead;  // Died one generation before, shown with LONGER_DEAD_COLOR
+    GameOfLifeColumn_t Changed;     // Cells changed by playGameOfLife(), which must be drawn by drawGameOfLife()
+    GameOfLifeColumn_t Joined;      // Bit y set -> cell y and y+1 are shown as one rectangle, i.e. the grid line between them is covered
+};
 
-extern uint8_t (*tGameOfLifeByteArray)[GAME_OF_LIFE_Y_SIZE];
+extern GameOfLifeColumnStruct *sGameOfLifeColumns;
 extern uint16_t sCurrentGameOfLifeGeneration;
 
 void initGameOfLife(void);
@@ -1,11 +1,13 @@
 /*
  *  GameOfLife.hpp
  *
- *  Implements the Game Of Life on a (Display) by using a byte array
+ *  Implements the Game Of Life on a (Display) by using one bit vector per column and state.
+ *  The next generation is computed with bitwise adders for a whole column at once.
+ *  Only changed cells are drawn, and vertically adjacent cells with the same state are drawn with one fillRect().
  *  Cells outside the borders are taken as empty
  *
  *
- *  Copyright (C) 2012-2024  Armin Joachimsmeyer
+ *  Copyright (C) 2012-2026  Armin Joachimsmeyer
  *
  *  This file is part of BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
  *  This file is part of STMF3-Discovery-Demos https://github.com/ArminJo/STMF3-Discovery-Demos.
@@ -49,99 +51,90 @@
 #  endif
 #endif
 
-unsigned long sLastFrameChangeMillis = 0; // Millis of last no tGameOfLifeByteArray change
+unsigned long sLastFrameChangeMillis = 0; // Millis of last change of alive cells
 uint16_t sCurrentGameOfLifeGeneration = 0;
-uint16_t drawcolor[5]; // Color scheme for EMPTY_CELL_COLOR, ALIVE_COLOR, JUST_DIED_COLOR etc.
+uint16_t drawcolor[5]; // Color scheme for EMPTY_CELL_COLOR, ALIVE_COLOR_INDEX, JUST_DIED_COLOR etc.
 
-uint8_t (*tGameOfLifeByteArray)[GAME_OF_LIFE_Y_SIZE];
+GameOfLifeColumnStruct *sGameOfLifeColumns;
+
+// Bits 0 to GAME_OF_LIFE_Y_SIZE - 1 set
+#define GAME_OF_LIFE_COLUMN_MASK ((GameOfLifeColumn_t) (((GameOfLifeColumn_t) ~0) >> ((sizeof(GameOfLifeColumn_t) * 8) - GAME_OF_LIFE_Y_SIZE)))
 
 /*
- * Checks if the cell is alive
- * Cells outside the borders are taken as empty
+ * Computes for all y of a column the sum of cell y and its upper and lower neighbor.
+ * The sum (0 to 3) is returned as 2 bit vectors. Cells outside the borders are taken as empty.
  */
-uint8_t isAlive(uint8_t x, uint8_t y) {
-    if ((x < GAME_OF_LIFE_X_SIZE) && (y < GAME_OF_LIFE_Y_SIZE)) {
-        if (tGameOfLifeByteArray[x][y] & CELL_IS_ALIVE) {
-            return 1;
-        }
-    }
-    return 0;
-}
-
-uint8_t countNeighbors(uint8_t x, uint8_t y) {
-    uint8_t count = 0;
-
-    //3 above
-    if (isAlive(x - 1, y - 1)) {
-        count++;
-    }
-    if (isAlive(x, y - 1)) {
-        count++;
-    }
-    if (isAlive(x + 1, y - 1)) {
-        count++;
-    }
-
-    //2 on each side
-    if (isAlive(x - 1, y)) {
-        count++;
-    }
-    if (isAlive(x + 1, y)) {
-        count++;
-    }
-
-    //3 below
-    if (isAlive(x - 1, y + 1)) {
-        count++;
-    }
-    if (isAlive(x, y + 1)) {
-        count++;
-    }
-    if (isAlive(x + 1, y + 1)) {
-        count++;
-    }
-
-    return count;
+void addVerticalNeighbors(GameOfLifeColumn_t aColumn, GameOfLifeColumn_t *aSumBit0, GameOfLifeColumn_t *aSumBit1) {
+    GameOfLifeColumn_t tUpper = aColumn << 1; // bit y is now cell y - 1
+    GameOfLifeColumn_t tLower = aColumn >> 1; // bit y is now cell y + 1
+    *aSumBit0 = tUpper ^ aColumn ^ tLower;
+    *aSumBit1 = (tUpper & aColumn) | (tLower & (tUpper ^ aColumn));
 }
 
 /**
- * This implements the rule of Game of Life and creates and dies cells by setting the appropriate flags
+ * This implements the rule of Game of Life for a whole column at once.
+ * The 3 * 3 block sum of alive cells, including the cell itself, is computed by bitwise adders
+ * from the vertical sums of the left, current and right column.
+ * A sum of 3 results in an alive cell, a sum of 4 keeps the current state.
+ * The dying history is shifted and all cells, which must be redrawn, are marked as changed.
  */
 void playGameOfLife(void) {
     bool tFrameHasChanged = false;
 
-    //update cells
+    GameOfLifeColumn_t tLeftSum0 = 0; // Cells left of column 0 are empty
+    GameOfLifeColumn_t tLeftSum1 = 0;
+    GameOfLifeColumn_t tSum0, tSum1;
+    addVerticalNeighbors(sGameOfLifeColumns[0].Alive, &tSum0, &tSum1);
+
     for (uint_fast8_t x = 0; x < GAME_OF_LIFE_X_SIZE; x++) {
-        for (uint_fast8_t y = 0; y < GAME_OF_LIFE_Y_SIZE; y++) {
-            /*
-             * Get the values for the rule
-             */
-            uint8_t tNeightborsCount = countNeighbors(x, y);
-            uint8_t tNewCellValue = 0;
-            /*
-             * Apply the rule
-             */
-            if (isAlive(x, y)) {
-                if (((tNeightborsCount < 2) || (tNeightborsCount > 3))) {
-                    /*
-                     * Let cell die in next iteration.
-                     * Do not clear the alive flag, it is required for the alive check of the next processed cells.
-                     * The alive flag is removed later by the drawing function.
-                     */
-                    tFrameHasChanged = true;
-                    tNewCellValue = CELL_IS_ALIVE | CELL_JUST_DIED;
-                }
-            } else {
-                if ((tNeightborsCount == 3)) {
-                    // create new cell
-                    tFrameHasChanged = true;
-                    tNewCellValue = CELL_IS_NEW;
-                }
-            }
-            if (tNewCellValue != 0) {
-                tGameOfLifeByteArray[x][y] = tNewCellValue;
-            }
+        GameOfLifeColumn_t tRightSum0 = 0;
+        GameOfLifeColumn_t tRightSum1 = 0;
+        if (x < GAME_OF_LIFE_X_SIZE - 1) {
+            // Must be done before the column x + 1 is overwritten
+            addVerticalNeighbors(sGameOfLifeColumns[x + 1].Alive, &tRightSum0, &tRightSum1);
+        }
+
+        /*
+         * Add the 3 2 bit sums to a 4 bit sum
+         */
+        GameOfLifeColumn_t tPartialSum0 = tLeftSum0 ^ tSum0;
+        GameOfLifeColumn_t tCarry = tLeftSum0 & tSum0;
+        GameOfLifeColumn_t tPartialSum1 = tLeftSum1 ^ tSum1 ^ tCarry;
+        GameOfLifeColumn_t tPartialSum2 = (tLeftSum1 & tSum1) | (tCarry & (tLeftSum1 ^ tSum1));
+
+        GameOfLifeColumn_t tBlockSum0 = tPartialSum0 ^ tRightSum0;
+        tCarry = tPartialSum0 & tRightSum0;
+        GameOfLifeColumn_t tBlockSum1 = tPartialSum1 ^ tRightSum1 ^ tCarry;
+        tCarry = (tPartialSum1 & tRightSum1) | (tCarry & (tPartialSum1 ^ tRightSum1));
+        GameOfLifeColumn_t tBlockSum2 = tPartialSum2 ^ tCarry;
+        GameOfLifeColumn_t tBlockSum3 = tPartialSum2 & tCarry;
+
+        /*
+         * Apply the rule
+         */
+        GameOfLifeColumnStruct *tColumn = &sGameOfLifeColumns[x];
+        GameOfLifeColumn_t tAlive = tColumn->Alive;
+        GameOfLifeColumn_t tNewAlive = ~tBlockSum3
+                & ((~tBlockSum2 & tBlockSum1 & tBlockSum0) | (tAlive & tBlockSum2 & ~tBlockSum1 & ~tBlockSum0))
+                & GAME_OF_LIFE_COLUMN_MASK;
+        GameOfLifeColumn_t tNewJustDied = 0;
+        GameOfLifeColumn_t tNewLongerDead = 0;
+        if (GameOfLifeShowDying) {
+            tNewJustDied = tAlive & ~tNewAlive;
+            tNewLongerDead = tColumn->JustDied & ~tNewAlive;
         }
+        if (tNewAlive != tAlive) {
+            tFrameHasChanged = true;
+        }
+        tColumn->Changed |= (tAlive ^ tNewAlive) | (tColumn->JustDied ^ tNewJustDied) | (tColumn->LongerDead ^ tNewLongerDead);
+        tColumn->Alive = tNewAlive;
+        tColumn->JustDied = tNewJustDied;
+        tColumn->LongerDead = tNewLongerDead;
+
+        tLeftSum0 = tSum0;
+        tLeftSum1 = tSum1;
+        tSum0 = tRightSum0;
+        tSum1 = tRightSum1;
     }
     if (tFrameHasChanged) {
         sLastFrameChangeMillis = millis();
@@ -149,75 +142,95 @@ void playGameOfLife(void) {
 }
 
 /**
- * Convert new cells to alive cells and handle dying history.
- * then draw all cells, which are alive or changed.
- * Fill cell region with color corresponding to current cell state
+ * Draws only the cells, which changed since last call.
+ * Vertically adjacent cells with the same not dead state are drawn as one rectangle, which also covers the grid lines between them.
+ * Such a run is completely redrawn if one of its cells changed.
+ * If a run is split, the grid line at the split position is restored.
+ * This reduces the number of fillRect() commands from all not empty cells to the changed runs,
+ * which is essential for the throughput of the Bluetooth connection.
  */
 void drawGameOfLife(void) {
+    uint_fast16_t tCellWidth = Display.getRequestedDisplayWidth() / GAME_OF_LIFE_X_SIZE;
+    uint_fast16_t tCellHeight = Display.getRequestedDisplayHeight() / GAME_OF_LIFE_Y_SIZE;
     uint_fast16_t tPosX = 0;
     for (uint_fast8_t x = 0; x < GAME_OF_LIFE_X_SIZE; x++) {
-#if DISPLAY_HEIGHT > 0xFF
-        uint_fast16_t tPosY = 0;
-#else
-        uint_fast8_t tPosY = 0;
-#endif
+        GameOfLifeColumnStruct *tColumn = &sGameOfLifeColumns[x];
+        GameOfLifeColumn_t tAlive = tColumn->Alive;
+        GameOfLifeColumn_t tJustDied = tColumn->JustDied;
+        GameOfLifeColumn_t tLongerDead = tColumn->LongerDead;
+        /*
+         * Cell y and y + 1 are joined, if they have the same state and are not dead
+         */
+        GameOfLifeColumn_t tJoined = (tAlive | tJustDied | tLongerDead)
+                & ~((tAlive ^ (tAlive >> 1)) | (tJustDied ^ (tJustDied >> 1)) | (tLongerDead ^ (tLongerDead >> 1)))
+                & (GAME_OF_LIFE_COLUMN_MASK >> 1);
+        // A newly joined cell must be redrawn to cover the grid line
+        GameOfLifeColumn_t tChanged = tColumn->Changed | (tJoined & ~tColumn->Joined);
+        GameOfLifeColumn_t tSplit = tColumn->Joined & ~tJoined;
+
+        uint_fast8_t tRunStartY = 0;
         for (uint_fast8_t y = 0; y < GAME_OF_LIFE_Y_SIZE; y++) {
-            uint8_t tCellValue = tGameOfLifeByteArray[x][y];
-            if (tCellValue != CELL_IS_EMPTY) {
-                /*
-                 * Process all not empty cells
-                 */
-                uint8_t tColorIndex = ALIVE_COLOR_INDEX; // Red, green or blue
-                if (tCellValue & CELL_JUST_DIED) { // die 1. time -> clear isAlive Bits and set die count to 2
-                    tGameOfLifeByteArray[x][y] = 2;
+            GameOfLifeColumn_t tMask = (GameOfLifeColumn_t) 1 << y;
+            if (tJoined & tMask) {
+                continue; // run continues
+            }
+            // here y is the last cell of the run
+            GameOfLifeColumn_t tRunMask = (GameOfLifeColumn_t) ((GameOfLifeColumn_t) (tMask << 1) - ((GameOfLifeColumn_t) 1 << tRunStartY));
+            if (tChanged & tRunMask) {
+                uint8_t tColorIndex = DEAD_COLOR_INDEX; // Clear with white
+                if (tAlive & tMask) {
+                    tColorIndex = ALIVE_COLOR_INDEX; // Red, green or blue
+                } else if (tJustDied & tMask) {
                     tColorIndex = JUST_DIED_COLOR;
-                } else if (tCellValue == 2) { // die 2.time (to show as history)
-                    tGameOfLifeByteArray[x][y] = 1;
+                } else if (tLongerDead & tMask) {
                     tColorIndex = LONGER_DEAD_COLOR;
-                } else if (tCellValue == 1) { //die 3. time, delete now
-                    tGameOfLifeByteArray[x][y] = CELL_IS_EMPTY;
-                    tColorIndex = DEAD_COLOR_INDEX; // Clear with wWhite
-                } else if (tCellValue & CELL_IS_NEW) { // new
-                    tGameOfLifeByteArray[x][y] = CELL_IS_ALIVE;
-//                    tColorIndex = ALIVE_COLOR_INDEX; // Red, green or blue
                 }
-                Display.fillRect(tPosX + 1, tPosY + 1, tPosX + (Display.getRequestedDisplayWidth() / GAME_OF_LIFE_X_SIZE) - 2,
-                        tPosY + (Display.getRequestedDisplayHeight() / GAME_OF_LIFE_Y_SIZE) - 2, drawcolor[tColorIndex]);
+                Display.fillRect(tPosX + 1, (tRunStartY * tCellHeight) + 1, tPosX + tCellWidth - 2, ((y + 1) * tCellHeight) - 2,
+                        drawcolor[tColorIndex]);
+            }
+            if (tSplit & tMask) {
+                Display.fillRect(tPosX + 1, ((y + 1) * tCellHeight) - 1, tPosX + tCellWidth - 2, (y + 1) * tCellHeight,
+                        drawcolor[EMPTY_CELL_COLOR]);
             }
-            tPosY += (Display.getRequestedDisplayHeight() / GAME_OF_LIFE_Y_SIZE);
+            tRunStartY = y + 1;
         }
-        tPosX += (Display.getRequestedDisplayWidth() / GAME_OF_LIFE_X_SIZE);
+        tColumn->Joined = tJoined;
+        tColumn->Changed = 0;
+        tPosX += tCellWidth;
     }
 }
 
 /**
- * Sets display to grid color and clears each cell region,
- * resulting in a grid :-)
+ * Clears display with white and draws the grid lines,
+ * which requires much less commands than clearing each cell region.
+ * Each cell has a 1 pixel border of grid color, so inner grid lines are 2 pixel wide.
  */
 void ClearScreenAndDrawGameOfLifeGrid(void) {
-    Display.clearDisplay(drawcolor[EMPTY_CELL_COLOR]);
-    uint_fast16_t tPosX = 0;
-    for (uint_fast8_t x = 0; x < GAME_OF_LIFE_X_SIZE; x++) {
-#if DISPLAY_HEIGHT > 0xFF
-        uint_fast16_t tPosY = 0;
-#else
-        uint_fast8_t tPosY = 0;
-#endif
-        for (uint_fast8_t y = 0; y < GAME_OF_LIFE_Y_SIZE; y++) {
-            //clear cells
-            Display.fillRect(tPosX + 1, tPosY + 1, tPosX - 2 + (Display.getRequestedDisplayWidth() / GAME_OF_LIFE_X_SIZE),
-                    tPosY + (Display.getRequestedDisplayHeight() / GAME_OF_LIFE_Y_SIZE) - 2, drawcolor[DEAD_COLOR_INDEX]);
-            tPosY += (Display.getRequestedDisplayHeight() / GAME_OF_LIFE_Y_SIZE);
-        }
-        tPosX += (Display.getRequestedDisplayWidth() / GAME_OF_LIFE_X_SIZE);
+    uint_fast16_t tDisplayWidth = Display.getRequestedDisplayWidth();
+    uint_fast16_t tDisplayHeight = Display.getRequestedDisplayHeight();
+    uint_fast16_t tCellWidth = tDisplayWidth / GAME_OF_LIFE_X_SIZE;
+    uint_fast16_t tCellHeight = tDisplayHeight / GAME_OF_LIFE_Y_SIZE;
+
+    Display.clearDisplay(drawcolor[DEAD_COLOR_INDEX]);
+    Display.fillRect(0, 0, 0, tDisplayHeight - 1, drawcolor[EMPTY_CELL_COLOR]);
+    for (uint_fast8_t x = 1; x < GAME_OF_LIFE_X_SIZE; x++) {
+        Display.fillRect((x * tCellWidth) - 1, 0, x * tCellWidth, tDisplayHeight - 1, drawcolor[EMPTY_CELL_COLOR]);
+    }
+    // Right border including the unused area
+    Display.fillRect((GAME_OF_LIFE_X_SIZE * tCellWidth) - 1, 0, tDisplayWidth - 1, tDisplayHeight - 1, drawcolor[EMPTY_CELL_COLOR]);
+
+    Display.fillRect(0, 0, tDisplayWidth - 1, 0, drawcolor[EMPTY_CELL_COLOR]);
+    for (uint_fast8_t y = 1; y < GAME_OF_LIFE_Y_SIZE; y++) {
+        Display.fillRect(0, (y * tCellHeight) - 1, tDisplayWidth - 1, y * tCellHeight, drawcolor[EMPTY_CELL_COLOR]);
     }
+    Display.fillRect(0, (GAME_OF_LIFE_Y_SIZE * tCellHeight) - 1, tDisplayWidth - 1, tDisplayHeight - 1, drawcolor[EMPTY_CELL_COLOR]);
 }
 
 void startGameOfLifePage(){
-    tGameOfLifeByteArray = new uint8_t[GAME_OF_LIFE_X_SIZE][GAME_OF_LIFE_Y_SIZE]; // One cell requires one byte
+    sGameOfLifeColumns = new GameOfLifeColumnStruct[GAME_OF_LIFE_X_SIZE];
 }
 void stopGameOfLifePage(){
-    delete[] tGameOfLifeByteArray;
+    delete[] sGameOfLifeColumns;
 }
 
 /**
@@ -255,37 +268,25 @@ void initGameOfLife(void) {
         drawcolor[JUST_DIED_COLOR] = COLOR16_WHITE;
     }
 
-    //generate random start data
-#if defined(ARDUINO)
+    /*
+     * Generate random start data.
+     * Get random data interpreted as 32 bit bit vector, which is more bits than GAME_OF_LIFE_Y_SIZE :-)
+     * Use random() & random() to set every 2. bit to zero
+     */
     for (unsigned int x = 0; x < GAME_OF_LIFE_X_SIZE; x++) {
-        /*
-         * get random data interpreted as 32 bit bit vector, which is more bits than GAME_OF_LIFE_Y_SIZE :-)
-         * use random() & random() to set every 2. bit to zero
-         */
+#if defined(ARDUINO)
         uint32_t tRandom32BitValue = random() & random();
-        for (unsigned int y = 0; y < GAME_OF_LIFE_Y_SIZE; y++) {
-            if (tRandom32BitValue & 1) {
-                tGameOfLifeByteArray[x][y] = CELL_IS_ALIVE;
-            } else {
-                tGameOfLifeByteArray[x][y] = CELL_IS_EMPTY;
-            }
-            tRandom32BitValue >>= 1; // shift bit vector
-        }
-    }
-
-    #else
-    for (unsigned int x = 0; x < GAME_OF_LIFE_X_SIZE; x++) {
+#else
         uint32_t tRandom32BitValue = rand() & rand();
-        for (unsigned int y = 0; y < GAME_OF_LIFE_Y_SIZE; y++) {
-            if (tRandom32BitValue & 1) {
-                tGameOfLifeByteArray[x][y] = CELL_IS_ALIVE;
-            } else {
-                tGameOfLifeByteArray[x][y] = CELL_IS_EMPTY;
-            }
-            tRandom32BitValue >>= 1; // shift bit vector
-        }
-    }
 #endif
+        GameOfLifeColumnStruct *tColumn = &sGameOfLifeColumns[x];
+        tColumn->Alive = tRandom32BitValue & GAME_OF_LIFE_COLUMN_MASK;
+        tColumn->JustDied = 0;
+        tColumn->LongerDead = 0;
+        // The grid is drawn below, so only alive cells must be drawn
+        tColumn->Changed = tColumn->Alive;
+        tColumn->Joined = 0;
+    }
 
     ClearScreenAndDrawGameOfLifeGrid();
 
@@ -297,15 +298,20 @@ void drawGenerationText(void) {
     Display.drawText(0, TEXT_SIZE_11_ASCEND, sStringBuffer, TEXT_SIZE_11, COLOR16(50, 50, 50), drawcolor[DEAD_COLOR_INDEX]);
 }
 
+void setGameOfLifeCellAlive(uint8_t x, uint8_t y) {
+    sGameOfLifeColumns[x].Alive |= (GameOfLifeColumn_t) 1 << y;
+    sGameOfLifeColumns[x].Changed |= (GameOfLifeColumn_t) 1 << y;
+}
+
 void test(void) {
-    tGameOfLifeByteArray[2][2] = CELL_IS_ALIVE;
-    tGameOfLifeByteArray[3][2] = CELL_IS_ALIVE;
-    tGameOfLifeByteArray[4][2] = CELL_IS_ALIVE;
-
-    tGameOfLifeByteArray[6][2] = CELL_IS_ALIVE;
-    tGameOfLifeByteArray[7][2] = CELL_IS_ALIVE;
-    tGameOfLifeByteArray[6][3] = CELL_IS_ALIVE;
-    tGameOfLifeByteArray[7][3] = CELL_IS_ALIVE;
+    setGameOfLifeCellAlive(2, 2);
+    setGameOfLifeCellAlive(3, 2);
+    setGameOfLifeCellAlive(4, 2);
+
+    setGameOfLifeCellAlive(6, 2);
+    setGameOfLifeCellAlive(7, 2);
+    setGameOfLifeCellAlive(6, 3);
+    setGameOfLifeCellAlive(7, 3);
 }
 
 #if defined(BUTTON_IS_DEFINED_LOCALLY)
@@ -167,7 +167,6 @@ void startGuiDemo(void) {
 
     createDemoButtonsAndSliders();
     showGuiDemoMenu();
-//    tGameOfLifeByteArray = new uint8_t[GAME_OF_LIFE_X_SIZE][GAME_OF_LIFE_Y_SIZE]; // One cell requires one byte
     sMillisOfLastLoop = millis();
     registerLongTouchDownCallback(&LongTouchDownHandlerGUIDemo, TOUCH_STANDARD_LONG_TOUCH_TIMEOUT_MILLIS);
 }
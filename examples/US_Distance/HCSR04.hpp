@@ -69,6 +69,27 @@
 //#define USE_PIN_CHANGE_INTERRUPT_D0_TO_D7  // using PCINT2_vect - PORT D
 //#define USE_PIN_CHANGE_INTERRUPT_D8_TO_D13 // using PCINT0_vect - PORT B - Pin 13 is feedback output
 //#define USE_PIN_CHANGE_INTERRUPT_A0_TO_A5  // using PCINT1_vect - PORT C
+
+/*
+ * Activate the scanner for multiple sensors, which also requires the lines above for all echo in pins.
+ * Usage:
+ *  setup() {
+ *      addUSDistanceScannerSensor(FRONT_TRIGGER_PIN, FRONT_ECHO_PIN);
+ *      addUSDistanceScannerSensor(LEFT_TRIGGER_PIN, LEFT_ECHO_PIN);
+ *      initUSDistanceScanner(200);
+ *  }
+ *  loop() {
+ *      uint8_t tSensorIndex = handleUSDistanceScanner();
+ *      if (tSensorIndex != HCSR04_SCANNER_NO_NEW_VALUE) {
+ *          use getUSDistanceScannerCentimeter(tSensorIndex);
+ *      }
+ *  }
+ */
+//#define USE_HCSR04_SCANNER
+#if defined(USE_HCSR04_SCANNER) \
+        && !(defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5))
+#error USE_HCSR04_SCANNER requires at least one of the USE_PIN_CHANGE_INTERRUPT_* macros
+#endif
 #if __has_include("digitalWriteFast.h")
 #include "digitalWriteFast.h"
 #else
@@ -283,7 +304,152 @@ void testUSSensor(uint16_t aSecondsToTest) {
     }
 }
 
-#if (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5))
+#if defined(USE_HCSR04_SCANNER)
+HCSR04ScannerStruct sUSDistanceScanner;
+
+/*
+ * Common code for all interrupt handlers. Only the pin of the active sensor is enabled for pin change interrupt.
+ */
+void handleUSDistanceScannerPCInterrupt() {
+    uint8_t tActiveSensorIndex = sUSDistanceScanner.ActiveSensorIndex;
+    if (tActiveSensorIndex == HCSR04_SCANNER_NO_NEW_VALUE) {
+        return;
+    }
+    HCSR04SensorStruct *tSensor = &sUSDistanceScanner.Sensors[tActiveSensorIndex];
+    if (*tSensor->EchoInPortInputRegister & tSensor->EchoInPinMask) {
+        // start of pulse
+        sUSDistanceScanner.MicrosAtStartOfPulse = micros();
+    } else if (sUSDistanceScanner.MicrosAtStartOfPulse != 0) {
+        // end of pulse
+        sUSDistanceScanner.PulseMicros = micros() - sUSDistanceScanner.MicrosAtStartOfPulse;
+        sUSDistanceScanner.PulseIsValid = true;
+    }
+}
+
+/*
+ * @return Index of sensor or HCSR04_SCANNER_NO_NEW_VALUE if all sensors are already in use
+ */
+uint8_t addUSDistanceScannerSensor(uint8_t aTriggerOutPin, uint8_t aEchoInPin) {
+    uint8_t tSensorIndex = sUSDistanceScanner.NumberOfSensors;
+    if (tSensorIndex >= HCSR04_SCANNER_MAX_NUMBER_OF_SENSORS) {
+        return HCSR04_SCANNER_NO_NEW_VALUE;
+    }
+    HCSR04SensorStruct *tSensor = &sUSDistanceScanner.Sensors[tSensorIndex];
+    tSensor->TriggerOutPin = aTriggerOutPin;
+    tSensor->EchoInPortInputRegister = portInputRegister(digitalPinToPort(aEchoInPin));
+    tSensor->EchoInPinMask = digitalPinToBitMask(aEchoInPin);
+    tSensor->EchoInPCMSKRegister = digitalPinToPCMSK(aEchoInPin);
+    tSensor->EchoInPCMSKMask = bit(digitalPinToPCMSKbit(aEchoInPin));
+    tSensor->DistanceCentimeter = DISTANCE_TIMEOUT_RESULT;
+    tSensor->NumberOfConsecutiveTimeouts = HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT; // first valid value is taken unfiltered
+    pinMode(aTriggerOutPin, OUTPUT);
+    pinMode(aEchoInPin, INPUT);
+    // the 2 registers exists only once!
+    PCICR |= bit(digitalPinToPCICRbit(aEchoInPin)); // enable interrupt for the group, pins are enabled at trigger
+    sUSDistanceScanner.NumberOfSensors = tSensorIndex + 1;
+    return tSensorIndex;
+}
+
+/*
+ * @param aMillisBetweenTriggers - Time between triggers of 2 consecutive sensors.
+ *                                 Must be long enough to let the echoes of the previous sensor vanish.
+ */
+void initUSDistanceScanner(unsigned int aTimeoutCentimeter, uint8_t aMillisBetweenTriggers) {
+    sUSDistanceScanner.TimeoutMicros = ((aTimeoutCentimeter * 233L) + 2) / 4; // = * 58.25 (rounded by using +1)
+    sUSDistanceScanner.MillisBetweenTriggers = aMillisBetweenTriggers;
+    sUSDistanceScanner.ActiveSensorIndex = HCSR04_SCANNER_NO_NEW_VALUE;
+    sUSDistanceScanner.NextSensorIndex = 0;
+    sUSDistanceScanner.LastTriggerMillis = millis() - aMillisBetweenTriggers; // trigger at next call of handleUSDistanceScanner()
+}
+
+unsigned int getUSDistanceScannerCentimeter(uint8_t aSensorIndex) {
+    return sUSDistanceScanner.Sensors[aSensorIndex].DistanceCentimeter;
+}
+
+/*
+ * Triggers the next sensor if the time between triggers has elapsed and processes the result of the active sensor.
+ * The trigger pulse blocks for around 12 microseconds, everything else is non blocking.
+ * @return Index of sensor with new value or HCSR04_SCANNER_NO_NEW_VALUE
+ */
+uint8_t handleUSDistanceScanner() {
+    uint8_t tActiveSensorIndex = sUSDistanceScanner.ActiveSensorIndex;
+    if (tActiveSensorIndex == HCSR04_SCANNER_NO_NEW_VALUE) {
+        if (sUSDistanceScanner.NumberOfSensors > 0
+                && millis() - sUSDistanceScanner.LastTriggerMillis >= sUSDistanceScanner.MillisBetweenTriggers) {
+            /*
+             * Trigger next sensor
+             */
+            sUSDistanceScanner.LastTriggerMillis = millis();
+            tActiveSensorIndex = sUSDistanceScanner.NextSensorIndex;
+            HCSR04SensorStruct *tSensor = &sUSDistanceScanner.Sensors[tActiveSensorIndex];
+            sUSDistanceScanner.PulseIsValid = false;
+            sUSDistanceScanner.MicrosAtStartOfPulse = 0;
+            sUSDistanceScanner.ActiveSensorIndex = tActiveSensorIndex;
+            // need minimum 10 usec Trigger Pulse
+            digitalWrite(tSensor->TriggerOutPin, HIGH);
+            *tSensor->EchoInPCMSKRegister |= tSensor->EchoInPCMSKMask; // enable pin for pin change interrupt
+            delayMicroseconds(10);
+            // falling edge starts measurement
+            digitalWrite(tSensor->TriggerOutPin, LOW);
+            sUSDistanceScanner.MicrosAtTrigger = micros();
+        }
+        return HCSR04_SCANNER_NO_NEW_VALUE;
+    }
+
+    /*
+     * Measurement of active sensor is running
+     */
+    HCSR04SensorStruct *tSensor = &sUSDistanceScanner.Sensors[tActiveSensorIndex];
+    if (!sUSDistanceScanner.PulseIsValid
+            && micros() - sUSDistanceScanner.MicrosAtTrigger
+                    < sUSDistanceScanner.TimeoutMicros + HCSR04_SCANNER_MICROS_UNTIL_ECHO_START) {
+        return HCSR04_SCANNER_NO_NEW_VALUE;
+    }
+    *tSensor->EchoInPCMSKRegister &= ~tSensor->EchoInPCMSKMask; // disable pin for pin change interrupt, ISR does not write any more
+    unsigned int tCentimeter = DISTANCE_TIMEOUT_RESULT;
+    // HC-SR04 modules report no echo by a pulse of up to 200 ms, so pulses longer than timeout are treated as timeout.
+    if (sUSDistanceScanner.PulseIsValid && sUSDistanceScanner.PulseMicros <= sUSDistanceScanner.TimeoutMicros) {
+        tCentimeter = getCentimeterFromUSMicroSeconds(sUSDistanceScanner.PulseMicros);
+    }
+    sUSDistanceScanner.ActiveSensorIndex = HCSR04_SCANNER_NO_NEW_VALUE;
+    uint8_t tNextSensorIndex = tActiveSensorIndex + 1;
+    if (tNextSensorIndex >= sUSDistanceScanner.NumberOfSensors) {
+        tNextSensorIndex = 0;
+    }
+    sUSDistanceScanner.NextSensorIndex = tNextSensorIndex;
+
+    /*
+     * Filter and publish value
+     */
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+        if (tSensor->NumberOfConsecutiveTimeouts < HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT) {
+            tSensor->NumberOfConsecutiveTimeouts++;
+            if (tSensor->NumberOfConsecutiveTimeouts < HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT) {
+                return HCSR04_SCANNER_NO_NEW_VALUE; // ignore single timeout
+            }
+        }
+        tSensor->DistanceCentimeter = DISTANCE_TIMEOUT_RESULT;
+    } else {
+        if (tSensor->NumberOfConsecutiveTimeouts >= HCSR04_SCANNER_TIMEOUTS_FOR_TIMEOUT_RESULT) {
+            // first value after timeout
+            tSensor->FilteredCentimeterShifted = tCentimeter << HCSR04_SCANNER_FILTER_SHIFT;
+        } else {
+            // 3/4 * old + 1/4 * new
+            tSensor->FilteredCentimeterShifted = tSensor->FilteredCentimeterShifted - (tSensor->FilteredCentimeterShifted >> HCSR04_SCANNER_FILTER_SHIFT)
+                    + tCentimeter;
+        }
+        tSensor->NumberOfConsecutiveTimeouts = 0;
+#if HCSR04_SCANNER_FILTER_SHIFT == 0
+        tSensor->DistanceCentimeter = tCentimeter; // no filter, e.g. if a median filter follows, which requires raw values
+#else
+        tSensor->DistanceCentimeter = (tSensor->FilteredCentimeterShifted + (1 << (HCSR04_SCANNER_FILTER_SHIFT - 1)))
+                >> HCSR04_SCANNER_FILTER_SHIFT;
+#endif
+    }
+    return tActiveSensorIndex;
+}
+
+#elif (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5))
 
 volatile unsigned long sUSPulseMicros;
 volatile bool sUSValueIsValid = false;
@@ -316,7 +482,11 @@ void handlePCInterrupt(uint8_t aPortState) {
 ISR (PCINT2_vect) {
 // read pin
 //    uint8_t tPortState = digitalReadFast(sEchoInPin);//(*portInputRegister(digitalPinToPort(sEchoInPin))) & bit((digitalPinToPCMSKbit(sEchoInPin)));
+#if defined(USE_HCSR04_SCANNER)
+    handleUSDistanceScannerPCInterrupt();
+#else
     handlePCInterrupt(digitalReadFast(sEchoInPin));
+#endif
 }
 #endif
 
@@ -326,9 +496,13 @@ ISR (PCINT2_vect) {
  * state of pin is echoed to output 13 for debugging purpose
  */
 ISR (PCINT0_vect) {
+#if defined(USE_HCSR04_SCANNER)
+    handleUSDistanceScannerPCInterrupt();
+#else
 // check pin
     uint8_t tPortState = (*portInputRegister(digitalPinToPort(sEchoInPin))) & bit((digitalPinToPCMSKbit(sEchoInPin)));
     handlePCInterrupt(tPortState);
+#endif
 }
 #endif
 
@@ -338,13 +512,18 @@ ISR (PCINT0_vect) {
  * state of pin is echoed to output 13 for debugging purpose
  */
 ISR (PCINT1_vect) {
+#if defined(USE_HCSR04_SCANNER)
+    handleUSDistanceScannerPCInterrupt();
+#else
 // check pin
     uint8_t tPortState = (*portInputRegister(digitalPinToPort(sEchoInPin))) & bit((digitalPinToPCMSKbit(sEchoInPin)));
     handlePCInterrupt(tPortState);
+#endif
 }
 #endif
 
-#if (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5))
+#if (defined(USE_PIN_CHANGE_INTERRUPT_D0_TO_D7) | defined(USE_PIN_CHANGE_INTERRUPT_D8_TO_D13) | defined(USE_PIN_CHANGE_INTERRUPT_A0_TO_A5)) \
+        && !defined(USE_HCSR04_SCANNER)
 
 void startUSDistanceAsCentimeterWithCentimeterTimeoutNonBlocking(unsigned int aTimeoutCentimeter) {
 // need minimum 10 usec Trigger Pulse
@@ -33,8 +33,15 @@
  */
 #define DO_NOT_NEED_BASIC_TOUCH_EVENTS // Disables basic touch events down, move and up. Saves 620 bytes program memory and 36 bytes RAM
 //#define BD_USE_SIMPLE_SERIAL // Do not use the Serial object. Saves up to 1250 bytes program memory and 185 bytes RAM, if Serial is not used otherwise
+#define BD_USE_RETAINED_DISPLAY_LIST // Background and caption are recorded once and then sent by the library on each redraw
 #include "BlueDisplay.hpp"
 
+//#define US_SENSOR_SUPPORTS_1_PIN_MODE // Activate it, if you use modified HC-SR04 modules or HY-SRF05 ones
+
+#if defined(__AVR__) && !defined(US_SENSOR_SUPPORTS_1_PIN_MODE)
+#define USE_PIN_CHANGE_INTERRUPT_D0_TO_D7 // ECHO_IN_PIN is 4
+#define USE_HCSR04_SCANNER // Measure distance without blocking the event loop for up to 18 ms
+#endif
 #include "HCSR04.hpp"
 
 /****************************************************************************
@@ -45,8 +52,6 @@
 #define BLUETOOTH_BAUD_RATE BAUD_9600
 #endif
 
-//#define US_SENSOR_SUPPORTS_1_PIN_MODE // Activate it, if you use modified HC-SR04 modules or HY-SRF05 ones
-
 #define MEASUREMENT_INTERVAL_MILLIS 50
 #define DISTANCE_TIMEOUT_CM         300  // cm timeout for US reading
 
@@ -89,6 +94,9 @@ void setup(void) {
     pinMode(LED_BUILTIN, OUTPUT);
 
     initUSDistancePin(TRIGGER_OUT_PIN);
+#elif defined(USE_HCSR04_SCANNER)
+    addUSDistanceScannerSensor(TRIGGER_OUT_PIN, ECHO_IN_PIN);
+    initUSDistanceScanner(DISTANCE_TIMEOUT_CM, MEASUREMENT_INTERVAL_MILLIS);
 #else
     initUSDistancePins(TRIGGER_OUT_PIN, ECHO_IN_PIN);
 #endif
@@ -109,7 +117,7 @@ void setup(void) {
      * If active, mCurrentDisplaySize and mHostUnixTimestamp are set and initDisplay() and drawGui() functions are called.
      * If not active, the periodic call of checkAndHandleEvents() in the main loop waits for the (re)connection and then performs the same actions.
      */
-    BlueDisplay1.initCommunication(&Serial, &handleConnectAndReorientation, &drawGui); // introduces up to 1.5 seconds delay
+    BlueDisplay1.initCommunication(&Serial, &handleConnectAndReorientation, &drawGui, &handleConnectAndReorientation); // introduces up to 1.5 seconds delay
 
 #if defined(BD_USE_SERIAL1) || defined(ESP32) // BD_USE_SERIAL1 may be defined in BlueSerial.h
 // Serial(0) is available for Serial.print output.
@@ -143,8 +151,16 @@ void setup(void) {
 }
 
 void loop(void) {
+#if defined(USE_HCSR04_SCANNER)
+    checkAndHandleEvents();
+    if (handleUSDistanceScanner() == HCSR04_SCANNER_NO_NEW_VALUE) {
+        return; // Events are handled while the scanner waits for the echo or the next trigger
+    }
+    unsigned int tUSDistanceCentimeter = getUSDistanceScannerCentimeter(0);
+#else
     getUSDistanceAsCentimeterWithCentimeterTimeout(DISTANCE_TIMEOUT_CM);
     auto tUSDistanceCentimeter = sUSDistanceCentimeter;
+#endif
 #if ! defined(BD_USE_SIMPLE_SERIAL) || defined(BD_USE_SERIAL1)
     // If using simple serial on first USART we cannot use Serial.print, since this uses the same interrupt vector as simple serial.
 #  if !defined(BD_USE_SERIAL1) && !defined(ESP32)
@@ -155,9 +171,13 @@ void loop(void) {
             Serial.println("timeout");
         } else {
             Serial.print(tUSDistanceCentimeter);
+#if defined(USE_HCSR04_SCANNER)
+            Serial.println(" cm");
+#else
             Serial.print(" cm, ");
             Serial.print(sUSDistanceMicroseconds);
             Serial.println(" micro secounds.");
+#endif
         }
 #  if !defined(BD_USE_SERIAL1) && !defined(ESP32)
     }
@@ -168,10 +188,14 @@ void loop(void) {
         /*
          * Here distance timeout happened
          */
+#if defined(USE_HCSR04_SCANNER)
+        tone(TONE_PIN, 1000, MEASUREMENT_INTERVAL_MILLIS / 2); // Intermittent tone, since we get a timeout for each measurement
+#else
         tone(TONE_PIN, 1000, 50);
         delay(100);
         tone(TONE_PIN, 2000, 50);
         delay((100 - MEASUREMENT_INTERVAL_MILLIS) - 20);
+#endif
 
     } else {
         if (doTone && tUSDistanceCentimeter < 100) {
@@ -226,8 +250,10 @@ void loop(void) {
         }
         sLastUSDistanceCentimeter = tUSDistanceCentimeter;
     }
+#if !defined(USE_HCSR04_SCANNER)
     checkAndHandleEvents();
     delay(MEASUREMENT_INTERVAL_MILLIS); // < 200
+#endif
 }
 
 /*
@@ -277,10 +303,16 @@ void handleConnectAndReorientation(void) {
 
 /*
  * Function used as callback handler for redraw event
+ * The retained display list is empty at the first call and after a layout change by reorientation or a new canvas size.
+ * Otherwise background and caption were already sent by the library, directly before this call.
  */
 void drawGui(void) {
-    BlueDisplay1.clearDisplay(COLOR16_BLUE);
-    BlueDisplay1.drawText(sCaptionStartX, sButtonTextSize, "Distance", sButtonTextSize, COLOR16_WHITE, COLOR16_BLUE);
+    if (getRetainedDisplayListLength() == 0) {
+        startRetainedDisplayList(0);
+        BlueDisplay1.clearDisplay(COLOR16_BLUE);
+        BlueDisplay1.drawText(sCaptionStartX, sButtonTextSize, "Distance", sButtonTextSize, COLOR16_WHITE, COLOR16_BLUE);
+        stopRetainedDisplayList();
+    }
     SliderShowDistance.drawSlider();
     TouchButtonStartStop.drawButton();
     TouchButtonOffset.drawButton();
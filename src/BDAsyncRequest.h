@@ -0,0 +1,135 @@
+/*
+ * BDAsyncRequest.h
+ *
+ * Non blocking requests to the BlueDisplay app (host), which are answered by an event.
+ * Each request occupies one of BD_NUMBER_OF_ASYNC_REQUESTS slots until its response is received or its timeout occurred.
+ * The BDAsyncRequest object is just a handle for the slot, which can be polled with isDone()
+ * and a per request callback is called, when the request is done.
+ *
+ * Number and info requests send an individual callback address for each slot and the last 2 bits of its sequence,
+ * so their responses are assigned to the right request, even if several requests are pending or a slot was reused.
+ * Canvas size and speaking done responses carry no such information and are assigned to the oldest pending request of this type.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_ASYNC_REQUEST_H
+#define _BD_ASYNC_REQUEST_H
+
+#include <stdint.h>
+#include "BlueDisplayProtocol.h" // for ByteShortLongFloatUnion
+
+#if !defined(BD_NUMBER_OF_ASYNC_REQUESTS)
+#define BD_NUMBER_OF_ASYNC_REQUESTS     4 // Maximum number of pending requests. Each slot requires 19 (AVR) / 24 (32 bit) bytes RAM. Max value is 4.
+#endif
+#if BD_NUMBER_OF_ASYNC_REQUESTS > 4
+#error BD_NUMBER_OF_ASYNC_REQUESTS must not be greater than 4
+#endif
+
+#define BD_ASYNC_REQUEST_NO_TIMEOUT     0
+#define BD_ASYNC_REQUEST_NO_SLOT        0xFF // Handle value, if no free slot was available at time of request
+/*
+ * The lower bits of the slot sequence select the response callback sent to the host.
+ * So a response for one of the last 3 older requests of a slot, which arrives after timeout or cancel(), is ignored.
+ */
+#define BD_ASYNC_REQUEST_GENERATION_MASK    0x03
+
+// Request types
+#define BD_ASYNC_REQUEST_TYPE_NUMBER        0
+#define BD_ASYNC_REQUEST_TYPE_INFO          1
+#define BD_ASYNC_REQUEST_TYPE_CANVAS_SIZE   2
+#define BD_ASYNC_REQUEST_TYPE_SPEAK         3
+
+// Request states
+#define BD_ASYNC_REQUEST_STATE_FREE         0
+#define BD_ASYNC_REQUEST_STATE_PENDING      1
+#define BD_ASYNC_REQUEST_STATE_DONE         2 // Response received
+#define BD_ASYNC_REQUEST_STATE_TIMEOUT      3
+#define BD_ASYNC_REQUEST_STATE_INVALID      4 // No slot was available or slot was already reused by a newer request
+
+class BDAsyncRequest {
+public:
+    BDAsyncRequest();
+    BDAsyncRequest(uint8_t aSlotIndex);
+
+    bool isValid(); // false if no slot was available or slot was already reused by a newer request
+    uint8_t getState();
+    uint8_t getType();
+    bool isPending();
+    bool isDone(); // true if response was received, timeout happened or request was invalid
+    bool isTimedOut();
+    void cancel(); // Free the slot without calling the callback. A response received later is ignored.
+
+    // Results. Only valid as long as slot is not reused, i.e. if isValid(). Otherwise 0 is returned.
+    float getNumber();
+    uint8_t getInfoByte();
+    uint16_t getInfoShort();
+    ByteShortLongFloatUnion getInfoLong();
+    int16_t getSpeakingErrorCode();
+    unsigned long getRoundTripMillis(); // Millis from request until response or timeout
+
+    uint8_t mSlotIndex;
+    uint8_t mSequence; // To detect if slot was reused by a newer request
+};
+
+struct BDAsyncRequestSlot {
+    uint8_t State;
+    uint8_t Type;
+    uint8_t Sequence;
+    uint8_t InfoSubcommand;
+    uint16_t TimeoutMillis;
+    unsigned long StartMillis; // After completion, it holds the round trip millis
+    void (*CompletionCallback)(BDAsyncRequest *aRequest);
+    union {
+        float NumberValue;
+        struct {
+            uint8_t ByteInfo;
+            uint16_t ShortInfo;
+            ByteShortLongFloatUnion LongInfo;
+        } Info;
+        int16_t SpeakingErrorCode;
+    } Result;
+};
+
+extern BDAsyncRequestSlot sBDAsyncRequestSlots[BD_NUMBER_OF_ASYNC_REQUESTS];
+extern uint8_t sBDAsyncRequestsPending;
+
+/*
+ * The callback is called by checkAndHandleEvents() after the response was received or the timeout happened.
+ * aTimeoutMillis of BD_ASYNC_REQUEST_NO_TIMEOUT (0) means wait forever, which is useful for number input.
+ * If no slot is available, an invalid handle is returned and the callback is never called.
+ */
+BDAsyncRequest getNumberAsync(void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis,
+        const char *aShortPromptString = nullptr, float aInitialValue = NUMBER_INITIAL_VALUE_DO_NOT_SHOW);
+BDAsyncRequest getInfoAsync(uint8_t aInfoSubcommand, void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis);
+BDAsyncRequest requestMaxCanvasSizeAsync(void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis);
+#if !defined(DO_NOT_NEED_SPEAK_EVENTS)
+BDAsyncRequest speakStringAsync(const char *aString, bool aAddToQueue, void (*aCallback)(BDAsyncRequest *aRequest),
+        uint16_t aTimeoutMillis);
+#endif
+
+// Internal functions called by EventHandler
+void checkBDAsyncRequestTimeouts();
+void handleBDAsyncCanvasSizeResponse();
+#if !defined(DO_NOT_NEED_SPEAK_EVENTS)
+void handleBDAsyncSpeakingDone(int16_t aErrorCode);
+#endif
+
+#endif // _BD_ASYNC_REQUEST_H
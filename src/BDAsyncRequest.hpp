@@ -0,0 +1,352 @@
+/*
+ * BDAsyncRequest.hpp
+ *
+ * Implementation of non blocking requests to the BlueDisplay app (host) with per request callbacks and timeouts.
+ * Enabled by defining BD_USE_ASYNC_REQUESTS.
+ *
+ * Usage:
+ *  BDAsyncRequest sTimeRequest;
+ *  sTimeRequest = getInfoAsync(SUBFUNCTION_GET_INFO_LOCAL_TIME, &handleTimeResponse, 500);
+ *  ...
+ *  loop() {
+ *      checkAndHandleEvents(); // calls callbacks and checks for timeouts
+ *      if (sTimeRequest.isDone()) ...
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_ASYNC_REQUEST_HPP
+#define _BD_ASYNC_REQUEST_HPP
+
+#include "BlueDisplay.h"
+#include "BDAsyncRequest.h"
+
+BDAsyncRequestSlot sBDAsyncRequestSlots[BD_NUMBER_OF_ASYNC_REQUESTS];
+uint8_t sBDAsyncRequestsPending = 0; // To return fast from checkBDAsyncRequestTimeouts()
+
+BDAsyncRequest::BDAsyncRequest() {
+    mSlotIndex = BD_ASYNC_REQUEST_NO_SLOT;
+    mSequence = 0;
+}
+
+BDAsyncRequest::BDAsyncRequest(uint8_t aSlotIndex) {
+    mSlotIndex = aSlotIndex;
+    mSequence = 0;
+    if (aSlotIndex < BD_NUMBER_OF_ASYNC_REQUESTS) {
+        mSequence = sBDAsyncRequestSlots[aSlotIndex].Sequence;
+    }
+}
+
+/*
+ * @return false if no slot was available or slot was already reused by a newer request
+ */
+bool BDAsyncRequest::isValid() {
+    return mSlotIndex < BD_NUMBER_OF_ASYNC_REQUESTS && sBDAsyncRequestSlots[mSlotIndex].Sequence == mSequence;
+}
+
+uint8_t BDAsyncRequest::getState() {
+    if (!isValid()) {
+        return BD_ASYNC_REQUEST_STATE_INVALID;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].State;
+}
+
+uint8_t BDAsyncRequest::getType() {
+    if (mSlotIndex >= BD_NUMBER_OF_ASYNC_REQUESTS) {
+        return BD_ASYNC_REQUEST_NO_SLOT;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Type;
+}
+
+bool BDAsyncRequest::isPending() {
+    return getState() == BD_ASYNC_REQUEST_STATE_PENDING;
+}
+
+bool BDAsyncRequest::isDone() {
+    return getState() != BD_ASYNC_REQUEST_STATE_PENDING;
+}
+
+bool BDAsyncRequest::isTimedOut() {
+    return getState() == BD_ASYNC_REQUEST_STATE_TIMEOUT;
+}
+
+void BDAsyncRequest::cancel() {
+    uint8_t tState = getState();
+    if (tState == BD_ASYNC_REQUEST_STATE_PENDING) {
+        sBDAsyncRequestsPending--;
+    }
+    if (tState != BD_ASYNC_REQUEST_STATE_INVALID) {
+        sBDAsyncRequestSlots[mSlotIndex].State = BD_ASYNC_REQUEST_STATE_FREE;
+    }
+}
+
+/*
+ * All result functions return 0 for an invalid request
+ */
+float BDAsyncRequest::getNumber() {
+    if (!isValid()) {
+        return 0;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Result.NumberValue;
+}
+uint8_t BDAsyncRequest::getInfoByte() {
+    if (!isValid()) {
+        return 0;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Result.Info.ByteInfo;
+}
+uint16_t BDAsyncRequest::getInfoShort() {
+    if (!isValid()) {
+        return 0;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Result.Info.ShortInfo;
+}
+ByteShortLongFloatUnion BDAsyncRequest::getInfoLong() {
+    if (!isValid()) {
+        ByteShortLongFloatUnion tZero;
+        tZero.uint32Value = 0;
+        return tZero;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Result.Info.LongInfo;
+}
+int16_t BDAsyncRequest::getSpeakingErrorCode() {
+    if (!isValid()) {
+        return 0;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].Result.SpeakingErrorCode;
+}
+unsigned long BDAsyncRequest::getRoundTripMillis() {
+    if (!isValid()) {
+        return 0;
+    }
+    if (isPending()) {
+        return millis() - sBDAsyncRequestSlots[mSlotIndex].StartMillis;
+    }
+    return sBDAsyncRequestSlots[mSlotIndex].StartMillis;
+}
+
+/*
+ * Get a slot, which is not pending and initialize it
+ * @return BD_ASYNC_REQUEST_NO_SLOT if all slots are pending
+ */
+uint8_t allocateBDAsyncRequestSlot(uint8_t aType, void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis) {
+    uint8_t tSlotIndex = BD_ASYNC_REQUEST_NO_SLOT;
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_ASYNC_REQUESTS; ++i) {
+        uint8_t tState = sBDAsyncRequestSlots[i].State;
+        if (tState == BD_ASYNC_REQUEST_STATE_FREE) {
+            tSlotIndex = i;
+            break;
+        }
+        if (tState != BD_ASYNC_REQUEST_STATE_PENDING && tSlotIndex == BD_ASYNC_REQUEST_NO_SLOT) {
+            tSlotIndex = i; // take completed slot only if no free slot is available
+        }
+    }
+    if (tSlotIndex != BD_ASYNC_REQUEST_NO_SLOT) {
+        BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[tSlotIndex];
+        tSlot->State = BD_ASYNC_REQUEST_STATE_PENDING;
+        tSlot->Type = aType;
+        tSlot->Sequence++; // invalidates all old handles for this slot
+        tSlot->TimeoutMillis = aTimeoutMillis;
+        tSlot->StartMillis = millis();
+        tSlot->CompletionCallback = aCallback;
+        sBDAsyncRequestsPending++;
+    }
+    return tSlotIndex;
+}
+
+void completeBDAsyncRequest(uint8_t aSlotIndex, uint8_t aState) {
+    BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[aSlotIndex];
+    tSlot->State = aState;
+    tSlot->StartMillis = millis() - tSlot->StartMillis; // store round trip time
+    sBDAsyncRequestsPending--;
+    if (tSlot->CompletionCallback != nullptr) {
+        BDAsyncRequest tRequest(aSlotIndex);
+        tSlot->CompletionCallback(&tRequest);
+    }
+}
+
+/*
+ * @return index of the oldest pending request of this type or BD_ASYNC_REQUEST_NO_SLOT
+ */
+uint8_t getOldestPendingBDAsyncRequest(uint8_t aType) {
+    uint8_t tSlotIndex = BD_ASYNC_REQUEST_NO_SLOT;
+    unsigned long tMaxAge = 0;
+    unsigned long tMillis = millis();
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_ASYNC_REQUESTS; ++i) {
+        BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[i];
+        if (tSlot->State == BD_ASYNC_REQUEST_STATE_PENDING && tSlot->Type == aType && tMillis - tSlot->StartMillis >= tMaxAge) {
+            tMaxAge = tMillis - tSlot->StartMillis;
+            tSlotIndex = i;
+        }
+    }
+    return tSlotIndex;
+}
+
+/*
+ * Called by the handler for the number and info callbacks, which are individual for each slot and generation.
+ * A late response for an older request of this slot, e.g. after a timeout or cancel(), has another generation and is ignored.
+ */
+void handleBDAsyncNumberResponse(uint8_t aSlotIndex, uint8_t aGeneration, float aNumber) {
+    BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[aSlotIndex];
+    if (tSlot->State == BD_ASYNC_REQUEST_STATE_PENDING && tSlot->Type == BD_ASYNC_REQUEST_TYPE_NUMBER
+            && (tSlot->Sequence & BD_ASYNC_REQUEST_GENERATION_MASK) == aGeneration) {
+        tSlot->Result.NumberValue = aNumber;
+        completeBDAsyncRequest(aSlotIndex, BD_ASYNC_REQUEST_STATE_DONE);
+    }
+}
+
+void handleBDAsyncInfoResponse(uint8_t aSlotIndex, uint8_t aGeneration, uint8_t aSubcommand, uint8_t aByteInfo,
+        uint16_t aShortInfo, ByteShortLongFloatUnion aLongInfo) {
+    BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[aSlotIndex];
+    if (tSlot->State == BD_ASYNC_REQUEST_STATE_PENDING && tSlot->Type == BD_ASYNC_REQUEST_TYPE_INFO
+            && (tSlot->Sequence & BD_ASYNC_REQUEST_GENERATION_MASK) == aGeneration && tSlot->InfoSubcommand == aSubcommand) {
+        tSlot->Result.Info.ByteInfo = aByteInfo;
+        tSlot->Result.Info.ShortInfo = aShortInfo;
+        tSlot->Result.Info.LongInfo = aLongInfo;
+        completeBDAsyncRequest(aSlotIndex, BD_ASYNC_REQUEST_STATE_DONE);
+    }
+}
+
+/*
+ * One callback function per slot and generation. Its address is sent to the host and returned with the response event,
+ * so we know which slot and which request of this slot the response belongs to.
+ */
+#define DEFINE_BD_ASYNC_RESPONSE_HANDLERS(aSlotIndex, aGeneration) \
+void handleBDAsyncNumberResponse##aSlotIndex##_##aGeneration(float aNumber) { \
+    handleBDAsyncNumberResponse(aSlotIndex, aGeneration, aNumber); \
+} \
+void handleBDAsyncInfoResponse##aSlotIndex##_##aGeneration(uint8_t aSubcommand, uint8_t aByteInfo, uint16_t aShortInfo, ByteShortLongFloatUnion aLongInfo) { \
+    handleBDAsyncInfoResponse(aSlotIndex, aGeneration, aSubcommand, aByteInfo, aShortInfo, aLongInfo); \
+}
+#define DEFINE_BD_ASYNC_RESPONSE_HANDLERS_FOR_SLOT(aSlotIndex) \
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS(aSlotIndex, 0) \
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS(aSlotIndex, 1) \
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS(aSlotIndex, 2) \
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS(aSlotIndex, 3)
+
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS_FOR_SLOT(0)
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS_FOR_SLOT(1)
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS_FOR_SLOT(2)
+DEFINE_BD_ASYNC_RESPONSE_HANDLERS_FOR_SLOT(3)
+
+#define BD_ASYNC_NUMBER_HANDLERS_FOR_SLOT(aSlotIndex) { &handleBDAsyncNumberResponse##aSlotIndex##_0, \
+        &handleBDAsyncNumberResponse##aSlotIndex##_1, &handleBDAsyncNumberResponse##aSlotIndex##_2, \
+        &handleBDAsyncNumberResponse##aSlotIndex##_3 }
+#define BD_ASYNC_INFO_HANDLERS_FOR_SLOT(aSlotIndex) { &handleBDAsyncInfoResponse##aSlotIndex##_0, \
+        &handleBDAsyncInfoResponse##aSlotIndex##_1, &handleBDAsyncInfoResponse##aSlotIndex##_2, \
+        &handleBDAsyncInfoResponse##aSlotIndex##_3 }
+
+void (*const sBDAsyncNumberResponseHandlers[4][BD_ASYNC_REQUEST_GENERATION_MASK + 1])(float) = {
+        BD_ASYNC_NUMBER_HANDLERS_FOR_SLOT(0), BD_ASYNC_NUMBER_HANDLERS_FOR_SLOT(1), BD_ASYNC_NUMBER_HANDLERS_FOR_SLOT(2),
+        BD_ASYNC_NUMBER_HANDLERS_FOR_SLOT(3) };
+void (*const sBDAsyncInfoResponseHandlers[4][BD_ASYNC_REQUEST_GENERATION_MASK + 1])(uint8_t, uint8_t, uint16_t,
+        ByteShortLongFloatUnion) = { BD_ASYNC_INFO_HANDLERS_FOR_SLOT(0), BD_ASYNC_INFO_HANDLERS_FOR_SLOT(1),
+        BD_ASYNC_INFO_HANDLERS_FOR_SLOT(2), BD_ASYNC_INFO_HANDLERS_FOR_SLOT(3) };
+
+/*
+ * If the number input is cancelled on the host, nothing is sent back, so the request stays pending until timeout or cancel().
+ */
+BDAsyncRequest getNumberAsync(void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis, const char *aShortPromptString,
+        float aInitialValue) {
+    uint8_t tSlotIndex = allocateBDAsyncRequestSlot(BD_ASYNC_REQUEST_TYPE_NUMBER, aCallback, aTimeoutMillis);
+    if (tSlotIndex == BD_ASYNC_REQUEST_NO_SLOT) {
+        return BDAsyncRequest();
+    }
+    uint8_t tGeneration = sBDAsyncRequestSlots[tSlotIndex].Sequence & BD_ASYNC_REQUEST_GENERATION_MASK;
+    if (aShortPromptString == nullptr) {
+        BlueDisplay1.getNumber(sBDAsyncNumberResponseHandlers[tSlotIndex][tGeneration]);
+    } else {
+        BlueDisplay1.getNumberWithShortPrompt(sBDAsyncNumberResponseHandlers[tSlotIndex][tGeneration], aShortPromptString,
+                aInitialValue);
+    }
+    return BDAsyncRequest(tSlotIndex);
+}
+
+BDAsyncRequest getInfoAsync(uint8_t aInfoSubcommand, void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis) {
+    uint8_t tSlotIndex = allocateBDAsyncRequestSlot(BD_ASYNC_REQUEST_TYPE_INFO, aCallback, aTimeoutMillis);
+    if (tSlotIndex == BD_ASYNC_REQUEST_NO_SLOT) {
+        return BDAsyncRequest();
+    }
+    sBDAsyncRequestSlots[tSlotIndex].InfoSubcommand = aInfoSubcommand;
+    uint8_t tGeneration = sBDAsyncRequestSlots[tSlotIndex].Sequence & BD_ASYNC_REQUEST_GENERATION_MASK;
+    BlueDisplay1.getInfo(aInfoSubcommand, sBDAsyncInfoResponseHandlers[tSlotIndex][tGeneration]);
+    return BDAsyncRequest(tSlotIndex);
+}
+
+/*
+ * The new canvas size is available by BlueDisplay1.getHostDisplayWidth() etc. when the callback is called
+ */
+BDAsyncRequest requestMaxCanvasSizeAsync(void (*aCallback)(BDAsyncRequest *aRequest), uint16_t aTimeoutMillis) {
+    uint8_t tSlotIndex = allocateBDAsyncRequestSlot(BD_ASYNC_REQUEST_TYPE_CANVAS_SIZE, aCallback, aTimeoutMillis);
+    if (tSlotIndex == BD_ASYNC_REQUEST_NO_SLOT) {
+        return BDAsyncRequest();
+    }
+    BlueDisplay1.requestMaxCanvasSize();
+    return BDAsyncRequest(tSlotIndex);
+}
+
+#if !defined(DO_NOT_NEED_SPEAK_EVENTS)
+BDAsyncRequest speakStringAsync(const char *aString, bool aAddToQueue, void (*aCallback)(BDAsyncRequest *aRequest),
+        uint16_t aTimeoutMillis) {
+    uint8_t tSlotIndex = allocateBDAsyncRequestSlot(BD_ASYNC_REQUEST_TYPE_SPEAK, aCallback, aTimeoutMillis);
+    if (tSlotIndex == BD_ASYNC_REQUEST_NO_SLOT) {
+        return BDAsyncRequest();
+    }
+    if (aAddToQueue) {
+        BlueDisplay1.speakStringAddToQueue(aString);
+    } else {
+        BlueDisplay1.speakString(aString);
+    }
+    return BDAsyncRequest(tSlotIndex);
+}
+
+void handleBDAsyncSpeakingDone(int16_t aErrorCode) {
+    uint8_t tSlotIndex = getOldestPendingBDAsyncRequest(BD_ASYNC_REQUEST_TYPE_SPEAK);
+    if (tSlotIndex != BD_ASYNC_REQUEST_NO_SLOT) {
+        sBDAsyncRequestSlots[tSlotIndex].Result.SpeakingErrorCode = aErrorCode;
+        completeBDAsyncRequest(tSlotIndex, BD_ASYNC_REQUEST_STATE_DONE);
+    }
+}
+#endif
+
+void handleBDAsyncCanvasSizeResponse() {
+    uint8_t tSlotIndex = getOldestPendingBDAsyncRequest(BD_ASYNC_REQUEST_TYPE_CANVAS_SIZE);
+    if (tSlotIndex != BD_ASYNC_REQUEST_NO_SLOT) {
+        completeBDAsyncRequest(tSlotIndex, BD_ASYNC_REQUEST_STATE_DONE);
+    }
+}
+
+/*
+ * Is called by checkAndHandleEvents()
+ */
+void checkBDAsyncRequestTimeouts() {
+    if (sBDAsyncRequestsPending == 0) {
+        return;
+    }
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_ASYNC_REQUESTS; ++i) {
+        BDAsyncRequestSlot *tSlot = &sBDAsyncRequestSlots[i];
+        if (tSlot->State == BD_ASYNC_REQUEST_STATE_PENDING && tSlot->TimeoutMillis != BD_ASYNC_REQUEST_NO_TIMEOUT
+                && millis() - tSlot->StartMillis >= tSlot->TimeoutMillis) {
+            completeBDAsyncRequest(i, BD_ASYNC_REQUEST_STATE_TIMEOUT);
+        }
+    }
+}
+#endif // _BD_ASYNC_REQUEST_HPP
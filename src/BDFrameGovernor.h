@@ -0,0 +1,75 @@
+/*
+ * BDFrameGovernor.h
+ *
+ * Frame rate governor for loops which redraw the screen periodically.
+ * beginFrame() tells if the next frame should be rendered or skipped, endFrame() measures the bytes sent for the frame.
+ *
+ * The bytes sent are added to an estimated backlog, which is drained with the link throughput.
+ * A frame is skipped if it is too early for the target frame rate or the link can not (yet) take another frame,
+ * i.e. if the backlog would exceed BD_FRAME_GOVERNOR_MAX_LATENCY_MILLIS.
+ * This gives a stable latency at the highest sustainable frame rate instead of filling the buffers
+ * of the Bluetooth module and the host, which results in seconds of lag.
+ *
+ * The throughput starts with baud rate / 10 and is reduced if sending of a frame takes longer,
+ * e.g. because the Bluetooth module or the host can not keep up with the baud rate.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_FRAME_GOVERNOR_H
+#define _BD_FRAME_GOVERNOR_H
+
+#include <stdint.h>
+
+#if !defined(BD_FRAME_GOVERNOR_MAX_LATENCY_MILLIS)
+#define BD_FRAME_GOVERNOR_MAX_LATENCY_MILLIS        100 // Maximum time the link needs to send the backlog before we render a new frame
+#endif
+/*
+ * Frames with less bytes are not used for throughput measurement,
+ * since they may fit completely in the serial buffer and sending them does not block.
+ */
+#if !defined(BD_FRAME_GOVERNOR_MIN_BYTES_FOR_MEASUREMENT)
+#define BD_FRAME_GOVERNOR_MIN_BYTES_FOR_MEASUREMENT 128
+#endif
+
+struct BDFrameGovernorInfo {
+    uint16_t FrameIntervalMillis; // Current interval, which is max of target interval and the time to send an average frame
+    uint16_t AverageBytesPerFrame;
+    uint32_t LinkBytesPerSecond; // Estimated throughput of the link
+    uint32_t NominalLinkBytesPerSecond; // Throughput derived from baud rate
+    uint32_t BacklogBytes; // Estimated number of bytes sent, but not yet received by host
+    uint32_t LastBacklogUpdateMillis;
+    uint32_t FrameStartMillis;
+    uint32_t FrameStartBytesSent;
+    uint16_t TargetFrameIntervalMillis;
+    uint16_t RenderedFrames; // Since last call of getFrameGovernorFramesPerSecond()
+    uint16_t SkippedFrames; // Since initFrameGovernor()
+    uint32_t LastFramesPerSecondMillis;
+};
+extern BDFrameGovernorInfo sBDFrameGovernor;
+
+void initFrameGovernor(uint8_t aTargetFramesPerSecond, uint32_t aBaudRate);
+bool beginFrame(void); // returns true if frame should be rendered. Only in this case endFrame() must be called.
+void endFrame(void);
+void setFrameGovernorLinkBytesPerSecond(uint32_t aLinkBytesPerSecond); // If known, e.g. for a slow Bluetooth module
+uint8_t getFrameGovernorFramesPerSecond(void); // Rendered frames per second since last call
+uint16_t getFrameGovernorSkippedFrames(void);
+
+#endif // _BD_FRAME_GOVERNOR_H
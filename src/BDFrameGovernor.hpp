@@ -0,0 +1,186 @@
+/*
+ * BDFrameGovernor.hpp
+ *
+ * Implementation of the frame rate governor.
+ * Enabled by defining BD_USE_FRAME_GOVERNOR.
+ *
+ * Usage:
+ *  setup() {
+ *      initFrameGovernor(20, BLUETOOTH_BAUD_RATE);
+ *  }
+ *  loop() {
+ *      checkAndHandleEvents();
+ *      if (beginFrame()) {
+ *          drawValues();
+ *          endFrame();
+ *      }
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_FRAME_GOVERNOR_HPP
+#define _BD_FRAME_GOVERNOR_HPP
+
+#include "BlueDisplay.h"
+#include "BDFrameGovernor.h"
+
+#if !defined(ARDUINO)
+#include "timing.h" // for millis()
+#endif
+
+BDFrameGovernorInfo sBDFrameGovernor;
+
+/*
+ * @param aBaudRate - 8N1 is assumed, i.e. 10 bits per byte
+ */
+void initFrameGovernor(uint8_t aTargetFramesPerSecond, uint32_t aBaudRate) {
+    if (aTargetFramesPerSecond == 0) {
+        aTargetFramesPerSecond = 1;
+    }
+    sBDFrameGovernor.TargetFrameIntervalMillis = 1000 / aTargetFramesPerSecond;
+    sBDFrameGovernor.FrameIntervalMillis = sBDFrameGovernor.TargetFrameIntervalMillis;
+    setFrameGovernorLinkBytesPerSecond(aBaudRate / 10);
+    sBDFrameGovernor.AverageBytesPerFrame = 0;
+    sBDFrameGovernor.BacklogBytes = 0;
+    sBDFrameGovernor.RenderedFrames = 0;
+    sBDFrameGovernor.SkippedFrames = 0;
+    uint32_t tMillis = millis();
+    sBDFrameGovernor.LastBacklogUpdateMillis = tMillis;
+    sBDFrameGovernor.LastFramesPerSecondMillis = tMillis;
+    // Let the first call of beginFrame() render
+    sBDFrameGovernor.FrameStartMillis = tMillis - sBDFrameGovernor.FrameIntervalMillis;
+}
+
+/*
+ * Values below 1 are clamped to 1, since endFrame() divides by it
+ */
+void setFrameGovernorLinkBytesPerSecond(uint32_t aLinkBytesPerSecond) {
+    if (aLinkBytesPerSecond == 0) {
+        aLinkBytesPerSecond = 1;
+    }
+    sBDFrameGovernor.NominalLinkBytesPerSecond = aLinkBytesPerSecond;
+    sBDFrameGovernor.LinkBytesPerSecond = aLinkBytesPerSecond;
+}
+
+/*
+ * Drain backlog by the bytes the link could send since last update
+ */
+void updateFrameGovernorBacklog(uint32_t aMillis) {
+    uint32_t tDeltaMillis = aMillis - sBDFrameGovernor.LastBacklogUpdateMillis;
+    if (tDeltaMillis > 10000) {
+        tDeltaMillis = 10000; // avoid overflow of multiplication below, backlog is empty anyway
+    }
+    uint32_t tDrainedBytes = (tDeltaMillis * sBDFrameGovernor.LinkBytesPerSecond) / 1000;
+    if (tDrainedBytes > 0) {
+        // Only advance timestamp if something was drained, to avoid losing the fraction for short intervals
+        sBDFrameGovernor.LastBacklogUpdateMillis = aMillis;
+        if (tDrainedBytes >= sBDFrameGovernor.BacklogBytes) {
+            sBDFrameGovernor.BacklogBytes = 0;
+        } else {
+            sBDFrameGovernor.BacklogBytes -= tDrainedBytes;
+        }
+    }
+}
+
+/*
+ * @return true if frame should be rendered now. Then endFrame() must be called after rendering.
+ */
+bool beginFrame() {
+    uint32_t tMillis = millis();
+    if (tMillis - sBDFrameGovernor.FrameStartMillis < sBDFrameGovernor.FrameIntervalMillis) {
+        return false; // too early, no skip
+    }
+    updateFrameGovernorBacklog(tMillis);
+    if (sBDFrameGovernor.BacklogBytes
+            > (sBDFrameGovernor.LinkBytesPerSecond * BD_FRAME_GOVERNOR_MAX_LATENCY_MILLIS) / 1000) {
+        sBDFrameGovernor.SkippedFrames++;
+        return false;
+    }
+    sBDFrameGovernor.FrameStartMillis = tMillis;
+    sBDFrameGovernor.FrameStartBytesSent = sBDBytesSent;
+    return true;
+}
+
+void endFrame() {
+    uint32_t tMillis = millis();
+    uint32_t tFrameBytes = sBDBytesSent - sBDFrameGovernor.FrameStartBytesSent;
+    uint32_t tRenderMillis = tMillis - sBDFrameGovernor.FrameStartMillis;
+    sBDFrameGovernor.RenderedFrames++;
+
+    /*
+     * Adapt throughput estimate. If sending was blocking (frame larger than serial buffer),
+     * the render time is limited by the link, so the measured value is an upper bound of throughput.
+     * If it is lower than estimated, reduce estimate, otherwise slowly return to nominal value.
+     */
+    if (tFrameBytes >= BD_FRAME_GOVERNOR_MIN_BYTES_FOR_MEASUREMENT && tRenderMillis > 0) {
+        uint32_t tMeasuredBytesPerSecond = (tFrameBytes * 1000) / tRenderMillis;
+        if (tMeasuredBytesPerSecond < sBDFrameGovernor.LinkBytesPerSecond) {
+            sBDFrameGovernor.LinkBytesPerSecond = (sBDFrameGovernor.LinkBytesPerSecond * 3 + tMeasuredBytesPerSecond) / 4;
+        }
+    }
+    if (sBDFrameGovernor.LinkBytesPerSecond < sBDFrameGovernor.NominalLinkBytesPerSecond) {
+        sBDFrameGovernor.LinkBytesPerSecond += ((sBDFrameGovernor.NominalLinkBytesPerSecond - sBDFrameGovernor.LinkBytesPerSecond)
+                / 16) + 1;
+    }
+
+    /*
+     * Add frame to backlog. Bytes which were already sent during rendering are drained by the following update.
+     */
+    sBDFrameGovernor.BacklogBytes += tFrameBytes;
+    updateFrameGovernorBacklog(tMillis);
+
+    // Exponential moving average with 1/4 weight. Computed with 32 bit, since 3 * average overflows 16 bit int on AVR.
+    uint32_t tAverageBytesPerFrame = tFrameBytes;
+    if (sBDFrameGovernor.AverageBytesPerFrame != 0) {
+        tAverageBytesPerFrame = ((uint32_t) sBDFrameGovernor.AverageBytesPerFrame * 3 + tFrameBytes) / 4;
+    }
+    sBDFrameGovernor.AverageBytesPerFrame = (tAverageBytesPerFrame > 0xFFFF) ? 0xFFFF : tAverageBytesPerFrame;
+
+    /*
+     * Interval is max of target interval and time to send an average frame
+     */
+    uint32_t tLinkIntervalMillis = ((uint32_t) sBDFrameGovernor.AverageBytesPerFrame * 1000) / sBDFrameGovernor.LinkBytesPerSecond;
+    if (tLinkIntervalMillis > sBDFrameGovernor.TargetFrameIntervalMillis) {
+        sBDFrameGovernor.FrameIntervalMillis = (tLinkIntervalMillis > 0xFFFF) ? 0xFFFF : tLinkIntervalMillis;
+    } else {
+        sBDFrameGovernor.FrameIntervalMillis = sBDFrameGovernor.TargetFrameIntervalMillis;
+    }
+}
+
+/*
+ * @return Rendered frames per second since last call
+ */
+uint8_t getFrameGovernorFramesPerSecond() {
+    uint32_t tMillis = millis();
+    uint32_t tDeltaMillis = tMillis - sBDFrameGovernor.LastFramesPerSecondMillis;
+    uint8_t tFramesPerSecond = 0;
+    if (tDeltaMillis > 0) {
+        tFramesPerSecond = ((uint32_t) sBDFrameGovernor.RenderedFrames * 1000 + (tDeltaMillis / 2)) / tDeltaMillis;
+    }
+    sBDFrameGovernor.RenderedFrames = 0;
+    sBDFrameGovernor.LastFramesPerSecondMillis = tMillis;
+    return tFramesPerSecond;
+}
+
+uint16_t getFrameGovernorSkippedFrames() {
+    return sBDFrameGovernor.SkippedFrames;
+}
+#endif // _BD_FRAME_GOVERNOR_HPP
@@ -0,0 +1,81 @@
+/*
+ * BDRetainedDisplayList.h
+ *
+ * Bounded recorder for the static part of the screen, like background, labels and axes.
+ * All commands sent between startRetainedDisplayList() and stopRetainedDisplayList() are stored as encoded protocol bytes,
+ * and are sent again in one burst on reconnect and redraw, directly before the redraw callback is called.
+ * The redraw callback then only has to draw the dynamic content, if getRetainedDisplayListLength() is not 0.
+ *
+ * Each recorded command is tagged with a layer number, which enables to clear e.g. only the axes after a scale change.
+ * Consecutive commands of the same layer are stored in one entry with a 3 byte header.
+ * If the buffer is full, recording is stopped and isRetainedDisplayListOverflow() returns true.
+ * Then the content is incomplete and the app should clear it and draw all by itself.
+ *
+ * The list is cleared automatically on reorientation and if setFlagsAndSize() changes the canvas size,
+ * since the recorded coordinates belong to the old layout. The redraw callback then finds getRetainedDisplayListLength() == 0
+ * and must draw and record the static content again. For other layout changes, call clearRetainedDisplayList(BD_RETAINED_LAYER_ALL).
+ *
+ * Buttons and sliders are not retained, since they are recreated by the connect callback.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_RETAINED_DISPLAY_LIST_H
+#define _BD_RETAINED_DISPLAY_LIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if !defined(BD_RETAINED_DISPLAY_LIST_SIZE)
+#  if defined(__AVR__) && RAMEND <= 0x8FF
+#define BD_RETAINED_DISPLAY_LIST_SIZE   200 // Enough for a clear, a few lines and labels
+#  elif defined(__AVR__)
+#define BD_RETAINED_DISPLAY_LIST_SIZE   512
+#  else
+#define BD_RETAINED_DISPLAY_LIST_SIZE   2048
+#  endif
+#endif
+
+#define BD_RETAINED_LAYER_NONE              0xFF // Not recording
+#define BD_RETAINED_LAYER_ALL               0xFF // For clearRetainedDisplayList()
+#define BD_RETAINED_ENTRY_HEADER_SIZE       3    // Layer and 16 bit length of the following protocol bytes
+
+struct BDRetainedDisplayListInfo {
+    uint8_t Buffer[BD_RETAINED_DISPLAY_LIST_SIZE];
+    uint16_t Length;            // Number of bytes used in buffer
+    uint16_t LastEntryIndex;    // Index of the header of the last entry, which is extended for the same layer
+    uint8_t RecordingLayer;     // BD_RETAINED_LAYER_NONE -> not recording
+    bool IsReplaying;           // Suppresses recording of the replayed bytes
+    bool HasOverflow;
+};
+extern BDRetainedDisplayListInfo sBDRetainedDisplayList;
+
+void startRetainedDisplayList(uint8_t aLayer); // aLayer 0 to 254
+void stopRetainedDisplayList(void);
+void clearRetainedDisplayList(uint8_t aLayer); // BD_RETAINED_LAYER_ALL clears all layers and the overflow flag
+bool replayRetainedDisplayList(void); // Is called automatically on reconnect and redraw. Returns false if list is empty.
+uint16_t getRetainedDisplayListLength(void);
+bool isRetainedDisplayListOverflow(void);
+
+// Called by sendUSARTBufferNoSizeCheck()
+void recordToRetainedDisplayList(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
+        size_t aDataBufferLength);
+
+#endif // _BD_RETAINED_DISPLAY_LIST_H
@@ -0,0 +1,170 @@
+/*
+ * BDRetainedDisplayList.hpp
+ *
+ * Implementation of the retained display list.
+ * Enabled by defining BD_USE_RETAINED_DISPLAY_LIST.
+ *
+ * Usage:
+ *  void drawGui() { // redraw callback
+ *      if (getRetainedDisplayListLength() == 0) { // first call or cleared, otherwise static content was just replayed
+ *          startRetainedDisplayList(0);
+ *          BlueDisplay1.clearDisplay(COLOR16_WHITE);
+ *          drawStaticContent();
+ *          stopRetainedDisplayList();
+ *      }
+ *      drawDynamicContent();
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_RETAINED_DISPLAY_LIST_HPP
+#define _BD_RETAINED_DISPLAY_LIST_HPP
+
+#include "BlueDisplay.h"
+#include "BDRetainedDisplayList.h"
+
+#include <string.h> // for memcpy(), memmove()
+
+BDRetainedDisplayListInfo sBDRetainedDisplayList = { { 0 }, 0, 0, BD_RETAINED_LAYER_NONE, false, false };
+
+void startRetainedDisplayList(uint8_t aLayer) {
+    if (!sBDRetainedDisplayList.HasOverflow) {
+        sBDRetainedDisplayList.RecordingLayer = aLayer;
+    }
+}
+
+void stopRetainedDisplayList() {
+    sBDRetainedDisplayList.RecordingLayer = BD_RETAINED_LAYER_NONE;
+}
+
+uint16_t getRetainedEntryLength(uint16_t aEntryIndex) {
+    return sBDRetainedDisplayList.Buffer[aEntryIndex + 1] | (sBDRetainedDisplayList.Buffer[aEntryIndex + 2] << 8);
+}
+
+void setRetainedEntryLength(uint16_t aEntryIndex, uint16_t aLength) {
+    sBDRetainedDisplayList.Buffer[aEntryIndex + 1] = aLength;
+    sBDRetainedDisplayList.Buffer[aEntryIndex + 2] = aLength >> 8;
+}
+
+/*
+ * Removes all entries of the layer and compacts the buffer
+ */
+void clearRetainedDisplayList(uint8_t aLayer) {
+    if (aLayer == BD_RETAINED_LAYER_ALL) {
+        sBDRetainedDisplayList.Length = 0;
+        sBDRetainedDisplayList.HasOverflow = false;
+        return;
+    }
+    uint8_t *tBuffer = sBDRetainedDisplayList.Buffer;
+    uint16_t tReadIndex = 0;
+    uint16_t tWriteIndex = 0;
+    while (tReadIndex < sBDRetainedDisplayList.Length) {
+        uint16_t tEntryLength = getRetainedEntryLength(tReadIndex);
+        if (tBuffer[tReadIndex] != aLayer) {
+            uint16_t tLastEntryIndex = sBDRetainedDisplayList.LastEntryIndex;
+            if (tWriteIndex > 0 && tBuffer[tLastEntryIndex] == tBuffer[tReadIndex]) {
+                // Merge with preceding entry of same layer, which was separated by the removed one
+                setRetainedEntryLength(tLastEntryIndex, getRetainedEntryLength(tLastEntryIndex) + tEntryLength);
+                memmove(&tBuffer[tWriteIndex], &tBuffer[tReadIndex + BD_RETAINED_ENTRY_HEADER_SIZE], tEntryLength);
+                tWriteIndex += tEntryLength;
+            } else {
+                memmove(&tBuffer[tWriteIndex], &tBuffer[tReadIndex], BD_RETAINED_ENTRY_HEADER_SIZE + tEntryLength);
+                sBDRetainedDisplayList.LastEntryIndex = tWriteIndex;
+                tWriteIndex += BD_RETAINED_ENTRY_HEADER_SIZE + tEntryLength;
+            }
+        }
+        tReadIndex += BD_RETAINED_ENTRY_HEADER_SIZE + tEntryLength;
+    }
+    sBDRetainedDisplayList.Length = tWriteIndex;
+}
+
+/*
+ * Appends the bytes to the last entry if it has the recording layer, otherwise creates a new entry
+ */
+void recordToRetainedDisplayList(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
+        size_t aDataBufferLength) {
+    uint8_t tLayer = sBDRetainedDisplayList.RecordingLayer;
+    if (tLayer == BD_RETAINED_LAYER_NONE || sBDRetainedDisplayList.IsReplaying) {
+        return;
+    }
+    uint16_t tIndex = sBDRetainedDisplayList.Length;
+    bool tIsNewEntry = (tIndex == 0 || sBDRetainedDisplayList.Buffer[sBDRetainedDisplayList.LastEntryIndex] != tLayer);
+    size_t tRequiredSize = aParameterBufferLength + aDataBufferLength;
+    if (tIsNewEntry) {
+        tRequiredSize += BD_RETAINED_ENTRY_HEADER_SIZE;
+    }
+    if (tRequiredSize > (size_t) (BD_RETAINED_DISPLAY_LIST_SIZE - tIndex)) {
+        // Stop recording, since replaying only a part of the commands would give an inconsistent screen
+        sBDRetainedDisplayList.HasOverflow = true;
+        sBDRetainedDisplayList.RecordingLayer = BD_RETAINED_LAYER_NONE;
+        return;
+    }
+
+    if (tIsNewEntry) {
+        sBDRetainedDisplayList.LastEntryIndex = tIndex;
+        sBDRetainedDisplayList.Buffer[tIndex] = tLayer;
+        setRetainedEntryLength(tIndex, 0);
+        tIndex += BD_RETAINED_ENTRY_HEADER_SIZE;
+    }
+    memcpy(&sBDRetainedDisplayList.Buffer[tIndex], aParameterBufferPointer, aParameterBufferLength);
+    tIndex += aParameterBufferLength;
+    if (aDataBufferLength > 0) {
+        memcpy(&sBDRetainedDisplayList.Buffer[tIndex], aDataBufferPointer, aDataBufferLength);
+        tIndex += aDataBufferLength;
+    }
+    setRetainedEntryLength(sBDRetainedDisplayList.LastEntryIndex,
+            getRetainedEntryLength(sBDRetainedDisplayList.LastEntryIndex) + aParameterBufferLength + aDataBufferLength);
+    sBDRetainedDisplayList.Length = tIndex;
+}
+
+/*
+ * Sends the protocol bytes of all entries in chunks of at most 255 bytes.
+ * The chunks need not to be aligned to commands, since the host just receives a byte stream.
+ * @return false if list is empty
+ */
+bool replayRetainedDisplayList() {
+    if (sBDRetainedDisplayList.Length == 0) {
+        return false;
+    }
+    sBDRetainedDisplayList.IsReplaying = true;
+    uint16_t tIndex = 0;
+    while (tIndex < sBDRetainedDisplayList.Length) {
+        uint16_t tEntryLength = getRetainedEntryLength(tIndex);
+        tIndex += BD_RETAINED_ENTRY_HEADER_SIZE;
+        while (tEntryLength > 0) {
+            uint8_t tChunkLength = (tEntryLength > 0xFF) ? 0xFF : tEntryLength;
+            sendUSARTBufferNoSizeCheck(&sBDRetainedDisplayList.Buffer[tIndex], tChunkLength, nullptr, 0);
+            tIndex += tChunkLength;
+            tEntryLength -= tChunkLength;
+        }
+    }
+    sBDRetainedDisplayList.IsReplaying = false;
+    return true;
+}
+
+uint16_t getRetainedDisplayListLength() {
+    return sBDRetainedDisplayList.Length;
+}
+
+bool isRetainedDisplayListOverflow() {
+    return sBDRetainedDisplayList.HasOverflow;
+}
+#endif // _BD_RETAINED_DISPLAY_LIST_HPP
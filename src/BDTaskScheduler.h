@@ -0,0 +1,82 @@
+/*
+ * BDTaskScheduler.h
+ *
+ * Lightweight cooperative scheduler for periodic and one shot tasks, which are run by checkAndHandleEvents().
+ * Replaces the millis() polling code in loop() and works on all platforms, whereas registerDelayCallback()
+ * and changeDelayCallback() are only available for STM32.
+ *
+ * A task is identified by its function, like for changeDelayCallback().
+ * Events are always dispatched first and only one due task is run per call of checkAndHandleEvents(),
+ * so a long running task cannot starve event dispatching or the other tasks.
+ * If more than one task is due, the one with the oldest deadline is run.
+ * Tasks are never run nested, i.e. if a task calls delayMillisWithCheckAndHandleEvents(), only events are handled.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_TASK_SCHEDULER_H
+#define _BD_TASK_SCHEDULER_H
+
+#include <stdint.h>
+
+#if !defined(BD_NUMBER_OF_TASKS)
+#define BD_NUMBER_OF_TASKS      4 // Each task requires 13 (AVR) bytes RAM
+#endif
+
+#define BD_TASK_ONE_SHOT        0 // Period value for one shot tasks
+#define BD_TASK_NOT_FOUND       0xFF
+
+struct BDTask {
+    void (*TaskFunction)(void); // nullptr for unused entry
+    uint32_t DeadlineMillis; // Task is due if millis() reaches this value
+    uint16_t PeriodMillis; // BD_TASK_ONE_SHOT (0) for one shot tasks
+    uint16_t MaxLateMillis; // Maximum observed delay between deadline and start of task
+    uint16_t MaxRuntimeMillis;
+    uint8_t OverrunCount; // Number of complete periods missed. Saturates at 255.
+};
+
+extern BDTask sBDTasks[BD_NUMBER_OF_TASKS];
+
+/*
+ * Register or change task. Period is also the delay before first call.
+ * A period of 0 is rejected. Use registerOneShotTask() for tasks, which should run only once.
+ * @return index of task or BD_TASK_NOT_FOUND if no free entry is available or aPeriodMillis is 0.
+ */
+uint8_t registerPeriodicTask(void (*aTaskFunction)(void), uint16_t aPeriodMillis);
+uint8_t registerOneShotTask(void (*aTaskFunction)(void), uint16_t aDelayMillis); // Task is removed before it is called
+void removeTask(void (*aTaskFunction)(void));
+bool isTaskRegistered(void (*aTaskFunction)(void));
+void runTaskNow(void (*aTaskFunction)(void)); // Set deadline to now, e.g. to force an immediate redraw
+
+/*
+ * Overrun reporting
+ * The callback is called after a periodic task ended, if one or more of its periods were missed.
+ */
+void registerTaskOverrunCallback(void (*aTaskOverrunCallback)(void (*aTaskFunction)(void), uint16_t aLateMillis));
+uint8_t getTaskOverrunCount(void (*aTaskFunction)(void));
+void resetTaskStatistics(void);
+#if defined(ARDUINO)
+void printTaskStatistics(Print *aSerial);
+#endif
+
+// Internal function called by checkAndHandleEvents()
+void runNextDueTask(void);
+
+#endif // _BD_TASK_SCHEDULER_H
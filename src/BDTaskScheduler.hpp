@@ -0,0 +1,214 @@
+/*
+ * BDTaskScheduler.hpp
+ *
+ * Implementation of the cooperative task scheduler, which is run by checkAndHandleEvents().
+ * Enabled by defining BD_USE_TASK_SCHEDULER.
+ *
+ * Usage:
+ *  setup() {
+ *      registerPeriodicTask(&readSensor, 1000);
+ *      registerPeriodicTask(&drawChart, 200);
+ *  }
+ *  loop() {
+ *      checkAndHandleEvents(); // handles events and then runs at most one due task
+ *  }
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *
+ *  This file is part of Arduino-BlueDisplay https://github.com/ArminJo/Arduino-BlueDisplay.
+ *  This file is part of android-blue-display https://github.com/ArminJo/android-blue-display.
+ *
+ *  BlueDisplay is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _BD_TASK_SCHEDULER_HPP
+#define _BD_TASK_SCHEDULER_HPP
+
+#include "BlueDisplay.h"
+#include "BDTaskScheduler.h"
+
+#if !defined(ARDUINO)
+#include "timing.h" // for millis()
+#endif
+
+BDTask sBDTasks[BD_NUMBER_OF_TASKS];
+bool sBDTaskIsRunning = false; // Avoid nested calls of tasks, if a task calls checkAndHandleEvents()
+void (*sTaskOverrunCallback)(void (*aTaskFunction)(void), uint16_t aLateMillis) = nullptr;
+
+uint8_t getTaskIndex(void (*aTaskFunction)(void)) {
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_TASKS; ++i) {
+        if (sBDTasks[i].TaskFunction == aTaskFunction) {
+            return i;
+        }
+    }
+    return BD_TASK_NOT_FOUND;
+}
+
+/*
+ * Updates existing entry for this function or takes a free one
+ */
+uint8_t registerTask(void (*aTaskFunction)(void), uint16_t aPeriodMillis, uint16_t aDelayMillis) {
+    uint8_t tTaskIndex = getTaskIndex(aTaskFunction);
+    if (tTaskIndex == BD_TASK_NOT_FOUND) {
+        tTaskIndex = getTaskIndex(nullptr);
+        if (tTaskIndex == BD_TASK_NOT_FOUND) {
+            return BD_TASK_NOT_FOUND;
+        }
+        sBDTasks[tTaskIndex].MaxLateMillis = 0;
+        sBDTasks[tTaskIndex].MaxRuntimeMillis = 0;
+        sBDTasks[tTaskIndex].OverrunCount = 0;
+    }
+    BDTask *tTask = &sBDTasks[tTaskIndex];
+    tTask->DeadlineMillis = millis() + aDelayMillis;
+    tTask->PeriodMillis = aPeriodMillis;
+    tTask->TaskFunction = aTaskFunction; // set last, since this makes the entry valid
+    return tTaskIndex;
+}
+
+uint8_t registerPeriodicTask(void (*aTaskFunction)(void), uint16_t aPeriodMillis) {
+    if (aPeriodMillis == 0) {
+        return BD_TASK_NOT_FOUND; // 0 is BD_TASK_ONE_SHOT, so it would silently be a one shot task
+    }
+    return registerTask(aTaskFunction, aPeriodMillis, aPeriodMillis);
+}
+
+uint8_t registerOneShotTask(void (*aTaskFunction)(void), uint16_t aDelayMillis) {
+    return registerTask(aTaskFunction, BD_TASK_ONE_SHOT, aDelayMillis);
+}
+
+void removeTask(void (*aTaskFunction)(void)) {
+    uint8_t tTaskIndex = getTaskIndex(aTaskFunction);
+    if (tTaskIndex != BD_TASK_NOT_FOUND) {
+        sBDTasks[tTaskIndex].TaskFunction = nullptr;
+    }
+}
+
+bool isTaskRegistered(void (*aTaskFunction)(void)) {
+    return getTaskIndex(aTaskFunction) != BD_TASK_NOT_FOUND;
+}
+
+void runTaskNow(void (*aTaskFunction)(void)) {
+    uint8_t tTaskIndex = getTaskIndex(aTaskFunction);
+    if (tTaskIndex != BD_TASK_NOT_FOUND) {
+        sBDTasks[tTaskIndex].DeadlineMillis = millis();
+    }
+}
+
+void registerTaskOverrunCallback(void (*aTaskOverrunCallback)(void (*aTaskFunction)(void), uint16_t aLateMillis)) {
+    sTaskOverrunCallback = aTaskOverrunCallback;
+}
+
+uint8_t getTaskOverrunCount(void (*aTaskFunction)(void)) {
+    uint8_t tTaskIndex = getTaskIndex(aTaskFunction);
+    if (tTaskIndex == BD_TASK_NOT_FOUND) {
+        return 0;
+    }
+    return sBDTasks[tTaskIndex].OverrunCount;
+}
+
+void resetTaskStatistics() {
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_TASKS; ++i) {
+        sBDTasks[i].MaxLateMillis = 0;
+        sBDTasks[i].MaxRuntimeMillis = 0;
+        sBDTasks[i].OverrunCount = 0;
+    }
+}
+
+#if defined(ARDUINO)
+/*
+ * Prints one line per task: index, function address, period, max late, max runtime and overruns
+ */
+void printTaskStatistics(Print *aSerial) {
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_TASKS; ++i) {
+        BDTask *tTask = &sBDTasks[i];
+        if (tTask->TaskFunction != nullptr) {
+            aSerial->print(F("Task "));
+            aSerial->print(i);
+            aSerial->print(F(" @0x"));
+            aSerial->print((uintptr_t) tTask->TaskFunction, HEX);
+            aSerial->print(F(" period="));
+            aSerial->print(tTask->PeriodMillis);
+            aSerial->print(F(" max late="));
+            aSerial->print(tTask->MaxLateMillis);
+            aSerial->print(F(" max runtime="));
+            aSerial->print(tTask->MaxRuntimeMillis);
+            aSerial->print(F(" overruns="));
+            aSerial->println(tTask->OverrunCount);
+        }
+    }
+}
+#endif
+
+/*
+ * Is called by checkAndHandleEvents() after events are handled.
+ * Runs the due task with the oldest deadline.
+ * For periodic tasks the next deadline is computed from the old one, to avoid drifting.
+ * If periods were missed, they are skipped and counted as overrun.
+ */
+void runNextDueTask() {
+    if (sBDTaskIsRunning) {
+        return;
+    }
+    unsigned long tMillis = millis();
+    uint8_t tTaskIndex = BD_TASK_NOT_FOUND;
+    unsigned long tMaxLateMillis = 0;
+    for (uint_fast8_t i = 0; i < BD_NUMBER_OF_TASKS; ++i) {
+        BDTask *tTask = &sBDTasks[i];
+        unsigned long tLateMillis = tMillis - tTask->DeadlineMillis;
+        if (tTask->TaskFunction != nullptr && (long) tLateMillis >= 0 && tLateMillis >= tMaxLateMillis) {
+            tMaxLateMillis = tLateMillis;
+            tTaskIndex = i;
+        }
+    }
+    if (tTaskIndex == BD_TASK_NOT_FOUND) {
+        return;
+    }
+
+    BDTask *tTask = &sBDTasks[tTaskIndex];
+    void (*tTaskFunction)(void) = tTask->TaskFunction;
+    if (tMaxLateMillis > tTask->MaxLateMillis) {
+        tTask->MaxLateMillis = (tMaxLateMillis > 0xFFFF) ? 0xFFFF : tMaxLateMillis;
+    }
+    bool tOverrun = false;
+    if (tTask->PeriodMillis == BD_TASK_ONE_SHOT) {
+        tTask->TaskFunction = nullptr; // remove before call, so the task can register itself again
+    } else {
+        tTask->DeadlineMillis += tTask->PeriodMillis;
+        if ((long) (tMillis - tTask->DeadlineMillis) >= 0) {
+            // Missed at least one period -> skip missed periods
+            tTask->DeadlineMillis = tMillis + tTask->PeriodMillis;
+            if (tTask->OverrunCount < 0xFF) {
+                tTask->OverrunCount++;
+            }
+            tOverrun = true;
+        }
+    }
+
+    sBDTaskIsRunning = true;
+    tTaskFunction();
+    sBDTaskIsRunning = false;
+
+    unsigned long tRuntimeMillis = millis() - tMillis;
+    /*
+     * Task may have removed or re-registered itself, so do not use tTask here without check
+     */
+    if (tTask->TaskFunction == tTaskFunction && tRuntimeMillis > tTask->MaxRuntimeMillis) {
+        tTask->MaxRuntimeMillis = (tRuntimeMillis > 0xFFFF) ? 0xFFFF : tRuntimeMillis;
+    }
+    if (tOverrun && sTaskOverrunCallback != nullptr) {
+        sTaskOverrunCallback(tTaskFunction, (tMaxLateMillis > 0xFFFF) ? 0xFFFF : tMaxLateMillis);
+    }
+}
+#endif // _BD_TASK_SCHEDULER_HPP
@@ -88,6 +88,19 @@
 #error DISABLE_REMOTE_DISPLAY is defined but SUPPORT_LOCAL_DISPLAY is not defined! No-display is not supported ;-). Seems you forgot to #define SUPPORT_LOCAL_DISPLAY.
 #endif
 
+/*
+ * Encode the basic drawing commands (pixel, line, rect, circle) only once into a BlueDisplay protocol buffer,
+ * send it and then render the same buffer on the local display. Saves program memory for the duplicated argument handling.
+ * Local rendering is done after sending, so it overlaps with the transmission of buffered or interrupt driven serial.
+ */
+//#define BD_USE_UNIFIED_RENDERING
+#if defined(BD_USE_UNIFIED_RENDERING) && !defined(SUPPORT_LOCAL_DISPLAY)
+#undef BD_USE_UNIFIED_RENDERING // Nothing to unify
+#endif
+#if defined(BD_USE_RETAINED_DISPLAY_LIST) && defined(DISABLE_REMOTE_DISPLAY)
+#undef BD_USE_RETAINED_DISPLAY_LIST // Local display keeps its content
+#endif
+
 #if defined(ARDUINO)
 #  if defined(AVR)
 #include <avr/pgmspace.h>
@@ -370,6 +383,9 @@ public:
             uint8_t *aByteBuffer, size_t aByteBufferLength);
     void drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
             uint8_t aChartIndex, bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength);
+    void drawChartByteBufferZeroCopy(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+            uint8_t aChartIndex, bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength,
+            void (*aCompletionCallback)(uint8_t *aByteBuffer));
     void drawChartByteBufferScaled(uint16_t aXOffset, uint16_t aYOffset, int16_t aIntegerXScaleFactor, float aYScaleFactor,
             uint8_t aLineSize, uint8_t aChartMode, color16_t aColor, color16_t aClearBeforeColor, uint8_t aChartIndex,
             bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength);
@@ -442,6 +458,19 @@ uint8_t _clipAndCopyPGMString(char *aStringBuffer, const __FlashStringHelper *aP
 // The instance provided by the class itself
 extern BlueDisplay BlueDisplay1;
 
+#if defined(BD_USE_ASYNC_REQUESTS)
+#include "BDAsyncRequest.h"
+#endif
+#if defined(BD_USE_TASK_SCHEDULER)
+#include "BDTaskScheduler.h"
+#endif
+#if defined(BD_USE_FRAME_GOVERNOR)
+#include "BDFrameGovernor.h"
+#endif
+#if defined(BD_USE_RETAINED_DISPLAY_LIST)
+#include "BDRetainedDisplayList.h"
+#endif
+
 #endif // __cplusplus
 
 extern bool isLocalDisplayAvailable;
@@ -40,6 +40,12 @@
  * - DO_NOT_NEED_LONG_TOUCH_DOWN_AND_SWIPE_EVENTS Disables LongTouchDown and SwipeEnd events.
  * - ONLY_CONNECT_EVENT_REQUIRED        Disables reorientation, redraw and SensorChange events
  * - BD_USE_SIMPLE_SERIAL               Only for AVR! Do not use the Serial object. Saves up to 1250 bytes program memory and 185 bytes RAM, if Serial is not used otherwise.
+ * - BD_USE_SIMPLE_SERIAL_TX_BUFFER     Only for AVR and BD_USE_SIMPLE_SERIAL! Send by UDRE interrupt from a BD_SIMPLE_SERIAL_TX_BUFFER_SIZE byte ring buffer.
+ * - BD_USE_ASYNC_REQUESTS              Enables getNumberAsync(), getInfoAsync() etc. with per request callbacks and timeouts.
+ * - BD_USE_TASK_SCHEDULER              Enables registerPeriodicTask() and registerOneShotTask(). Due tasks are run by checkAndHandleEvents().
+ * - BD_USE_FRAME_GOVERNOR              Enables beginFrame() and endFrame() to limit frame rate to what the link can transfer.
+ * - BD_USE_RETAINED_DISPLAY_LIST       Enables recording of static drawing commands, which are sent again on reconnect and redraw.
+ * - BD_USE_UNIFIED_RENDERING           Only for SUPPORT_LOCAL_DISPLAY! Encode basic drawing commands once, send them and render the encoded command locally.
  * - BD_USE_USB_SERIAL                  Activate it, if you want to force using Serial instead of Serial1 for direct USB cable connection to your smartphone / tablet.
  *
  */
@@ -57,6 +63,18 @@
 #include "BDSlider.hpp"
 #include "Chart.hpp"
 #include "GUIHelper.hpp"
+#if defined(BD_USE_ASYNC_REQUESTS)
+#include "BDAsyncRequest.hpp"
+#endif
+#if defined(BD_USE_TASK_SCHEDULER)
+#include "BDTaskScheduler.hpp"
+#endif
+#if defined(BD_USE_FRAME_GOVERNOR)
+#include "BDFrameGovernor.hpp"
+#endif
+#if defined(BD_USE_RETAINED_DISPLAY_LIST)
+#include "BDRetainedDisplayList.hpp"
+#endif
 
 #if defined(SUPPORT_LOCAL_DISPLAY)
 // LocalGUI/LocalTouchButton.hpp etc are included by BDButton.hpp etc. above
@@ -219,6 +237,11 @@ void BlueDisplay::sendSync() {
  *         or combination of BD_FLAG_SCREEN_ORIENTATION_*
  */
 void BlueDisplay::setFlagsAndSize(uint16_t aFlags, uint16_t aWidth, uint16_t aHeight) {
+#if defined(BD_USE_RETAINED_DISPLAY_LIST)
+    if (mRequestedDisplaySize.XWidth != aWidth || mRequestedDisplaySize.YHeight != aHeight) {
+        clearRetainedDisplayList(BD_RETAINED_LAYER_ALL); // Recorded coordinates belong to the old canvas size
+    }
+#endif
     mRequestedDisplaySize.XWidth = aWidth;
     mRequestedDisplaySize.YHeight = aHeight;
     if (USART_isBluetoothPaired()) {
@@ -436,8 +459,112 @@ void BlueDisplay::speakStringBlockingWait(const __FlashStringHelper *aPGMString,
 #endif
 }
 
+#if defined(BD_USE_UNIFIED_RENDERING)
+#include <stdarg.h> // for va_start, va_list etc.
+/*
+ * Renders a command encoded in BlueDisplay protocol format on the local display.
+ * Only the basic drawing commands are supported, all others are ignored.
+ * @param aParameterBuffer - Sync token and function tag, parameter length in bytes, parameters
+ */
+void renderCommandOnLocalDisplay(uint16_t *aParameterBuffer) {
+    uint8_t tFunctionTag = aParameterBuffer[0] >> 8;
+    uint8_t tNumberOfArgs = aParameterBuffer[1] / 2;
+    uint16_t *tArgs = &aParameterBuffer[2];
+    switch (tFunctionTag) {
+    case FUNCTION_CLEAR_DISPLAY_AREA:
+        LocalDisplay.clearDisplay(tArgs[0]);
+        break;
+    case FUNCTION_DRAW_PIXEL:
+        LocalDisplay.drawPixel(tArgs[0], tArgs[1], tArgs[2]);
+        break;
+    case FUNCTION_DRAW_LINE_REL:
+    case FUNCTION_DRAW_LINE: {
+        // Only line commands have at least 2 parameters and the aliasing flag in start Y
+        uint16_t tStartY = tArgs[1] & 0x7FFF;
+        if (tFunctionTag == FUNCTION_DRAW_LINE_REL) {
+            tArgs[2] += tArgs[0];
+            tArgs[3] += tStartY;
+        }
+        if (tNumberOfArgs > 5) {
+            drawThickLine(tArgs[0], tStartY, tArgs[2], tArgs[3], tArgs[5], LINE_THICKNESS_MIDDLE, tArgs[4]);
+        } else {
+            LocalDisplay.drawLine(tArgs[0], tStartY, tArgs[2], tArgs[3], tArgs[4]);
+        }
+        break;
+    }
+    case FUNCTION_DRAW_RECT_REL:
+        tArgs[2] += tArgs[0];
+        tArgs[3] += tArgs[1];
+        // fall through
+    case FUNCTION_DRAW_RECT:
+        LocalDisplay.drawRect(tArgs[0], tArgs[1], tArgs[2] - 1, tArgs[3] - 1, tArgs[4]);
+        break;
+    case FUNCTION_FILL_RECT_REL:
+        LocalDisplay.fillRect(tArgs[0], tArgs[1], tArgs[0] + tArgs[2] - 1, tArgs[1] + tArgs[3] - 1, tArgs[4]);
+        break;
+    case FUNCTION_FILL_RECT:
+        LocalDisplay.fillRect(tArgs[0], tArgs[1], tArgs[2], tArgs[3], tArgs[4]);
+        break;
+    case FUNCTION_DRAW_CIRCLE:
+        LocalDisplay.drawCircle(tArgs[0], tArgs[1], tArgs[2], tArgs[3]);
+        break;
+    case FUNCTION_FILL_CIRCLE:
+        LocalDisplay.fillCircle(tArgs[0], tArgs[1], tArgs[2], tArgs[3]);
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Send first, so that the local rendering overlaps with the transmission of buffered or interrupt driven serial.
+ * The buffer is modified by rendering, so rendering must be last.
+ */
+void sendAndRenderUSART5Args(uint8_t aFunctionTag, uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY,
+        color16_t aColor) {
+    uint16_t tParamBuffer[7];
+    tParamBuffer[0] = aFunctionTag << 8 | SYNC_TOKEN;
+    tParamBuffer[1] = 10;
+    tParamBuffer[2] = aStartX;
+    tParamBuffer[3] = aStartY;
+    tParamBuffer[4] = aEndX;
+    tParamBuffer[5] = aEndY;
+    tParamBuffer[6] = aColor;
+#  if !defined(DISABLE_REMOTE_DISPLAY)
+    if (USART_isBluetoothPaired()) {
+        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 14, nullptr, 0);
+    }
+#  endif
+    renderCommandOnLocalDisplay(tParamBuffer);
+}
+
+/*
+ * @param aNumberOfArgs not more than MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS
+ */
+void sendAndRenderUSARTArgs(uint8_t aFunctionTag, uint_fast8_t aNumberOfArgs, ...) {
+    if (aNumberOfArgs > MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS) {
+        return;
+    }
+    uint16_t tParamBuffer[MAX_NUMBER_OF_ARGS_FOR_BD_FUNCTIONS + 2];
+    va_list argp;
+    tParamBuffer[0] = aFunctionTag << 8 | SYNC_TOKEN;
+    tParamBuffer[1] = aNumberOfArgs * 2;
+    va_start(argp, aNumberOfArgs);
+    for (uint_fast8_t i = 0; i < aNumberOfArgs; ++i) {
+        tParamBuffer[i + 2] = va_arg(argp, int);
+    }
+    va_end(argp);
+#  if !defined(DISABLE_REMOTE_DISPLAY)
+    if (USART_isBluetoothPaired()) {
+        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], aNumberOfArgs * 2 + 4, nullptr, 0);
+    }
+#  endif
+    renderCommandOnLocalDisplay(tParamBuffer);
+}
+#endif // defined(BD_USE_UNIFIED_RENDERING)
+
 void BlueDisplay::clearDisplayArea(color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.clearDisplay(aColor);
 #endif
     // saves 8 bytes for DSO, requires 8 bytes for RobotCar
@@ -453,7 +580,7 @@ void BlueDisplay::clearDisplayArea(color16_t aColor) {
 //        tParamBuffer[1] = 1;
 //        tParamBuffer[2] = aColor;
 //        sendUSARTBufferNoSizeCheck((uint8_t*) &tParamBuffer[0], 1 * 2 + 4, nullptr, 0);
-    sendUSARTArgs(FUNCTION_CLEAR_DISPLAY_AREA, 1, aColor);
+    sendAndRenderUSARTArgs(FUNCTION_CLEAR_DISPLAY_AREA, 1, aColor);
 }
 
 void BlueDisplay::clearDisplay(color16_t aColor) {
@@ -492,10 +619,10 @@ void BlueDisplay::drawDisplayDirect() {
 }
 
 void BlueDisplay::drawPixel(uint16_t aXPos, uint16_t aYPos, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawPixel(aXPos, aYPos, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_PIXEL, 3, aXPos, aYPos, aColor);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_PIXEL, 3, aXPos, aYPos, aColor);
 }
 
 /*
@@ -504,10 +631,10 @@ void BlueDisplay::drawPixel(uint16_t aXPos, uint16_t aYPos, color16_t aColor) {
  * Other lines drawn with this functions can NOT be overwritten/removed without residual -> use drawLineWithAliasing()
  */
 void BlueDisplay::drawLine(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawLine(aStartX, aStartY, aEndX, aEndY, aColor);
 #endif
-    sendUSART5Args(FUNCTION_DRAW_LINE, aStartX, aStartY, aEndX, aEndY, aColor);
+    sendAndRenderUSART5Args(FUNCTION_DRAW_LINE, aStartX, aStartY, aEndX, aEndY, aColor);
 }
 
 /*
@@ -515,10 +642,10 @@ void BlueDisplay::drawLine(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, u
  * I.e. if both are 0, then line is a pixel of width 1 and length 1!
  */
 void BlueDisplay::drawLineRel(uint16_t aStartX, uint16_t aStartY, int16_t aXDelta, int16_t aYDelta, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawLine(aStartX, aStartY, aStartX + aXDelta, aStartY + aYDelta, aColor);
 #endif
-    sendUSART5Args(FUNCTION_DRAW_LINE_REL, aStartX, aStartY, aXDelta, aYDelta, aColor);
+    sendAndRenderUSART5Args(FUNCTION_DRAW_LINE_REL, aStartX, aStartY, aXDelta, aYDelta, aColor);
 }
 
 /*
@@ -526,16 +653,16 @@ void BlueDisplay::drawLineRel(uint16_t aStartX, uint16_t aStartY, int16_t aXDelt
  * Horizontal or vertical lines are always drawn using aliasing Paint and thus can always be overwritten/removed without residual
  */
 void BlueDisplay::drawLineWithAliasing(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawLine(aStartX, aStartY, aEndX, aEndY, aColor);
 #endif
-    sendUSART5Args(FUNCTION_DRAW_LINE, aStartX, aStartY | 0x8000, aEndX, aEndY, aColor); // highest bit in aStartY signals use of aliasing paint
+    sendAndRenderUSART5Args(FUNCTION_DRAW_LINE, aStartX, aStartY | 0x8000, aEndX, aEndY, aColor); // highest bit in aStartY signals use of aliasing paint
 }
 void BlueDisplay::drawLineRelWithAliasing(uint16_t aStartX, uint16_t aStartY, int16_t aXDelta, int16_t aYDelta, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawLine(aStartX, aStartY, aStartX + aXDelta, aStartY + aYDelta, aColor);
 #endif
-    sendUSART5Args(FUNCTION_DRAW_LINE_REL, aStartX, aStartY | 0x8000, aXDelta, aYDelta, aColor); // highest bit in aStartY signals use of aliasing paint
+    sendAndRenderUSART5Args(FUNCTION_DRAW_LINE_REL, aStartX, aStartY | 0x8000, aXDelta, aYDelta, aColor); // highest bit in aStartY signals use of aliasing paint
 }
 void BlueDisplay::drawVectorDegreeWithAliasing(uint16_t aStartX, uint16_t aStartY, uint16_t aLength, int aDegree, color16_t aColor,
         int16_t aThickness) {
@@ -583,42 +710,42 @@ void BlueDisplay::drawVectorRadian(uint16_t aStartX, uint16_t aStartY, uint16_t
 
 void BlueDisplay::drawLineWithThickness(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor,
         int16_t aThickness) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     drawThickLine(aStartX, aStartY, aEndX, aEndY, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_LINE, 6, aStartX, aStartY, aEndX, aEndY, aColor, aThickness);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_LINE, 6, aStartX, aStartY, aEndX, aEndY, aColor, aThickness);
 }
 
 void BlueDisplay::drawLineRelWithThickness(uint16_t aStartX, uint16_t aStartY, int16_t aXOffset, int16_t aYOffset, color16_t aColor,
         int16_t aThickness) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     drawThickLine(aStartX, aStartY, aStartX + aXOffset, aStartY + aYOffset, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_LINE_REL, 6, aStartX, aStartY, aXOffset, aYOffset, aColor, aThickness);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_LINE_REL, 6, aStartX, aStartY, aXOffset, aYOffset, aColor, aThickness);
 }
 
 void BlueDisplay::drawLineWithThicknessWithAliasing(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY,
         color16_t aColor, int16_t aThickness) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     drawThickLine(aStartX, aStartY, aEndX, aEndY, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_LINE, 6, aStartX, aStartY | 0x8000, aEndX, aEndY, aColor, aThickness);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_LINE, 6, aStartX, aStartY | 0x8000, aEndX, aEndY, aColor, aThickness);
 }
 
 void BlueDisplay::drawLineRelWithThicknessWithAliasing(uint16_t aStartX, uint16_t aStartY, int16_t aXOffset, int16_t aYOffset,
         color16_t aColor, int16_t aThickness) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     drawThickLine(aStartX, aStartY, aStartX + aXOffset, aStartY + aYOffset, aThickness, LINE_THICKNESS_MIDDLE, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_LINE_REL, 6, aStartX, aStartY | 0x8000, aXOffset, aYOffset, aColor, aThickness);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_LINE_REL, 6, aStartX, aStartY | 0x8000, aXOffset, aYOffset, aColor, aThickness);
 }
 
 void BlueDisplay::drawRect(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor,
         uint16_t aStrokeWidth) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawRect(aStartX, aStartY, aEndX - 1, aEndY - 1, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_RECT, 6, aStartX, aStartY, aEndX, aEndY, aColor, aStrokeWidth);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_RECT, 6, aStartX, aStartY, aEndX, aEndY, aColor, aStrokeWidth);
 }
 
 /*
@@ -626,46 +753,46 @@ void BlueDisplay::drawRect(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, u
  */
 void BlueDisplay::drawRectRel(uint16_t aStartX, uint16_t aStartY, int16_t aXWidth, int16_t aHeight, color16_t aColor,
         uint16_t aStrokeWidth) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawRect(aStartX, aStartY, aStartX + aXWidth - 1, aStartY + aHeight - 1, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_DRAW_RECT_REL, 6, aStartX, aStartY, aXWidth, aHeight, aColor, aStrokeWidth);
+    sendAndRenderUSARTArgs(FUNCTION_DRAW_RECT_REL, 6, aStartX, aStartY, aXWidth, aHeight, aColor, aStrokeWidth);
 }
 
 void BlueDisplay::fillRect(uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.fillRect(aStartX, aStartY, aEndX, aEndY, aColor);
 #endif
-    sendUSART5Args(FUNCTION_FILL_RECT, aStartX, aStartY, aEndX, aEndY, aColor);
+    sendAndRenderUSART5Args(FUNCTION_FILL_RECT, aStartX, aStartY, aEndX, aEndY, aColor);
 }
 
 /*
  * If width or height is 0 rect will no be rendered :-)
  */
 void BlueDisplay::fillRectRel(uint16_t aStartX, uint16_t aStartY, int16_t aXWidth, int16_t aHeight, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.fillRect(aStartX, aStartY, aStartX + aXWidth - 1, aStartY + aHeight - 1, aColor);
 #endif
-    sendUSART5Args(FUNCTION_FILL_RECT_REL, aStartX, aStartY, aXWidth, aHeight, aColor);
+    sendAndRenderUSART5Args(FUNCTION_FILL_RECT_REL, aStartX, aStartY, aXWidth, aHeight, aColor);
 }
 
 void BlueDisplay::drawCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor, uint16_t aStrokeWidth) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.drawCircle(aXCenter, aYCenter, aRadius, aColor);
 #endif
-    sendUSART5Args(FUNCTION_DRAW_CIRCLE, aXCenter, aYCenter, aRadius, aColor, aStrokeWidth);
+    sendAndRenderUSART5Args(FUNCTION_DRAW_CIRCLE, aXCenter, aYCenter, aRadius, aColor, aStrokeWidth);
 }
 
 void BlueDisplay::fillCircle(uint16_t aXCenter, uint16_t aYCenter, uint16_t aRadius, color16_t aColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.fillCircle(aXCenter, aYCenter, aRadius, aColor);
 #endif
-    sendUSARTArgs(FUNCTION_FILL_CIRCLE, 4, aXCenter, aYCenter, aRadius, aColor);
+    sendAndRenderUSARTArgs(FUNCTION_FILL_CIRCLE, 4, aXCenter, aYCenter, aRadius, aColor);
 }
 
 void BlueDisplay::clearTextArea(uint16_t aPositionX, uint16_t aPositionY, uint8_t aStringLength, uint16_t aFontSize,
         color16_t aClearColor) {
-#if defined(SUPPORT_LOCAL_DISPLAY)
+#if defined(SUPPORT_LOCAL_DISPLAY) && !defined(BD_USE_UNIFIED_RENDERING)
     LocalDisplay.fillRect(aPositionX, aPositionY, aStringLength * getTextWidth(aFontSize), getTextHeight(aFontSize), aClearColor);
 #endif
     fillRectRel(aPositionX, aPositionY, aStringLength * getTextWidth(aFontSize), getTextHeight(aFontSize), aClearColor);
@@ -1320,6 +1447,37 @@ void BlueDisplay::drawChartByteBuffer(uint16_t aXOffset, uint16_t aYOffset, colo
     }
 }
 
+/**
+ * Like drawChartByteBuffer() above, but on STM32 the byte buffer is sent by DMA without copying it to the send buffer.
+ * The byte buffer must not be changed until aCompletionCallback is called, which may be called by the UART ISR.
+ * On other platforms, the callback is called before return.
+ */
+void BlueDisplay::drawChartByteBufferZeroCopy(uint16_t aXOffset, uint16_t aYOffset, color16_t aColor, color16_t aClearBeforeColor,
+        uint8_t aChartIndex, bool aDoDrawDirect, uint8_t *aByteBuffer, size_t aByteBufferLength,
+        void (*aCompletionCallback)(uint8_t *aByteBuffer)) {
+    if (USART_isBluetoothPaired()) {
+        uint16_t tParamBuffer[8];
+        uint16_t *tBufferPointer = &tParamBuffer[0];
+        if (aDoDrawDirect) {
+            *tBufferPointer++ = FUNCTION_DRAW_CHART << 8 | SYNC_TOKEN;
+        } else {
+            *tBufferPointer++ = FUNCTION_DRAW_CHART_WITHOUT_DIRECT_RENDERING << 8 | SYNC_TOKEN;
+        }
+        *tBufferPointer++ = 4 * 2; // parameter length
+        *tBufferPointer++ = aXOffset;
+        *tBufferPointer++ = aYOffset | ((aChartIndex & 0x0F) << 12);
+        *tBufferPointer++ = aColor;
+        *tBufferPointer++ = aClearBeforeColor;
+        // add data field header
+        *tBufferPointer++ = DATAFIELD_TAG_BYTE << 8 | SYNC_TOKEN;
+        *tBufferPointer = aByteBufferLength;
+        sendUSARTBufferZeroCopy((uint8_t*) &tParamBuffer[0], sizeof(tParamBuffer), aByteBuffer, aByteBufferLength,
+                aCompletionCallback);
+    } else if (aCompletionCallback != nullptr) {
+        aCompletionCallback(aByteBuffer);
+    }
+}
+
 /**
  * if aClearBeforeColor != 0x01 (COLOR16_NO_DELETE) then previous line is cleared before
  * chart index is coded in the upper 4 bits of aYOffset
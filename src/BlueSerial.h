@@ -42,6 +42,15 @@
  * Simple serial on the MEGA2560 uses USART1
  */
 //#define BD_USE_SIMPLE_SERIAL // Do not use the Serial object. Saves up to 1250 bytes program memory and 185 bytes RAM, if Serial is not used otherwise
+/*
+ * Simple serial sends blocking by default, i.e. the main loop waits around 1 ms per 100 bytes at 115200 baud.
+ * With BD_USE_SIMPLE_SERIAL_TX_BUFFER, bytes are put into a ring buffer and sent by the USART data register empty interrupt.
+ * If the buffer is full, we wait blocking until enough bytes are sent.
+ */
+//#define BD_USE_SIMPLE_SERIAL_TX_BUFFER // Only for AVR and BD_USE_SIMPLE_SERIAL. Costs around 120 bytes program memory and BD_SIMPLE_SERIAL_TX_BUFFER_SIZE + 3 bytes RAM.
+#if defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER) && !defined(BD_SIMPLE_SERIAL_TX_BUFFER_SIZE)
+#define BD_SIMPLE_SERIAL_TX_BUFFER_SIZE 64 // Must be a power of 2 and not greater than 256. Effective capacity is one byte less.
+#endif
 #if defined(SERIAL_PORT_HARDWARE1) // is defined for Arduino Due
 #define BOARD_HAVE_USART2 // they start counting with 0
 #endif
@@ -103,12 +112,39 @@ bool USART_isBluetoothPaired(void);
 #endif
 void setUsePairedPin(bool aUsePairedPin);
 
+#if defined(BD_USE_FRAME_GOVERNOR)
+extern uint32_t sBDBytesSent; // Total number of bytes sent. Used by the frame governor to estimate the link load.
+#define ADD_TO_BD_BYTES_SENT(aNumberOfBytes)    sBDBytesSent += (aNumberOfBytes)
+#else
+#define ADD_TO_BD_BYTES_SENT(aNumberOfBytes)
+#endif
+
+#if defined(BD_USE_RETAINED_DISPLAY_LIST)
+#define RECORD_TO_RETAINED_DISPLAY_LIST(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength) \
+    recordToRetainedDisplayList(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength)
+#else
+#define RECORD_TO_RETAINED_DISPLAY_LIST(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength)
+#endif
+
 void sendUSARTArgs(uint8_t aFunctionTag, uint_fast8_t aNumberOfArgs, ...);
 void sendUSARTArgsAndByteBuffer(uint8_t aFunctionTag, uint_fast8_t aNumberOfArgs, ...);
 void sendUSART5Args(uint8_t aFunctionTag, uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY, color16_t aColor);
+#if defined(BD_USE_UNIFIED_RENDERING)
+// Like the functions above, but additionally render the command on the local display. Implemented in BlueDisplay.hpp.
+void sendAndRenderUSARTArgs(uint8_t aFunctionTag, uint_fast8_t aNumberOfArgs, ...);
+void sendAndRenderUSART5Args(uint8_t aFunctionTag, uint16_t aStartX, uint16_t aStartY, uint16_t aEndX, uint16_t aEndY,
+        color16_t aColor);
+void renderCommandOnLocalDisplay(uint16_t *aParameterBuffer);
+#else
+#define sendAndRenderUSARTArgs  sendUSARTArgs
+#define sendAndRenderUSART5Args sendUSART5Args
+#endif
 // used internal by the above functions
 void sendUSARTBufferNoSizeCheck(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
         size_t aDataBufferLength);
+// Data buffer must not be changed until aCompletionCallback is called. Only STM32 sends it by DMA without copying it.
+void sendUSARTBufferZeroCopy(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
+        size_t aDataBufferLength, void (*aCompletionCallback)(uint8_t *aDataBufferPointer));
 
 /*
  * Functions only valid for standard serial
@@ -145,6 +181,12 @@ void sendUSART(const char *aString);
 #if defined(BD_USE_SIMPLE_SERIAL)
 void initSimpleSerial(uint32_t aBaudRate);
 void initSimpleSerial(uint32_t aBaudRate, bool aUsePairedPin);
+#  if defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER) && defined(__AVR__)
+void flushSimpleSerialTXBuffer();
+uint8_t getSimpleSerialTXBufferFreeSpace();
+uint8_t getSimpleSerialTXBufferHighWatermark();
+void resetSimpleSerialTXBufferHighWatermark();
+#  endif
 #endif
 
 #if defined(STM32F303xC) || defined(STM32F103xB)
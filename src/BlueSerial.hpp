@@ -88,6 +88,10 @@ bool sReceiveBufferOutOfSync = false;
 static uint8_t sReceivedEventType = EVENT_NO_EVENT; // Buffer for EventType until event data is complete
 static uint8_t sReceivedDataSize;
 
+#if defined(BD_USE_FRAME_GOVERNOR)
+uint32_t sBDBytesSent = 0;
+#endif
+
 bool usePairedPin = false; // Use pin of BT module to decide if BT is paired, this cannot be done by using software managed mBlueDisplayConnectionEstablished value
 void setUsePairedPin(bool aUsePairedPin) {
 #if defined(SUPPORT_REMOTE_AND_LOCAL_DISPLAY) && defined(ARDUINO)
@@ -365,14 +369,135 @@ void clearSerialInputBuffer() {
 #endif
 }
 
+#if defined(BD_USE_SIMPLE_SERIAL) && defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER) && defined(__AVR__)
+/*
+ * Interrupt driven transmit for simple serial.
+ * Bytes are written to a ring buffer by the main thread and sent by the USART data register empty (UDRE) ISR.
+ * Only the thread writes sSimpleSerialTXBufferIn, only the ISR writes sSimpleSerialTXBufferOut.
+ */
+#  if ((BD_SIMPLE_SERIAL_TX_BUFFER_SIZE & (BD_SIMPLE_SERIAL_TX_BUFFER_SIZE - 1)) != 0) || (BD_SIMPLE_SERIAL_TX_BUFFER_SIZE > 256)
+#error BD_SIMPLE_SERIAL_TX_BUFFER_SIZE must be a power of 2 and not greater than 256
+#  endif
+#define SIMPLE_SERIAL_TX_BUFFER_MASK    (BD_SIMPLE_SERIAL_TX_BUFFER_SIZE - 1)
+
+#  if (defined(UCSR1A) && ! defined(USE_USB_SERIAL)) || ! defined(UCSR0A) // Use TX1 on MEGA and on Leonardo, which has no TX0
+#define SIMPLE_SERIAL_UCSRA     UCSR1A
+#define SIMPLE_SERIAL_UCSRB     UCSR1B
+#define SIMPLE_SERIAL_UDR       UDR1
+#define SIMPLE_SERIAL_UDRE      UDRE1
+#define SIMPLE_SERIAL_UDRIE     UDRIE1
+#define SIMPLE_SERIAL_UDRE_vect USART1_UDRE_vect
+#  else
+#define SIMPLE_SERIAL_UCSRA     UCSR0A
+#define SIMPLE_SERIAL_UCSRB     UCSR0B
+#define SIMPLE_SERIAL_UDR       UDR0
+#define SIMPLE_SERIAL_UDRE      UDRE0
+#define SIMPLE_SERIAL_UDRIE     UDRIE0
+#    if defined(USART0_UDRE_vect)
+#define SIMPLE_SERIAL_UDRE_vect USART0_UDRE_vect
+#    else
+#define SIMPLE_SERIAL_UDRE_vect USART_UDRE_vect
+#    endif
+#  endif
+
+uint8_t sSimpleSerialTXBuffer[BD_SIMPLE_SERIAL_TX_BUFFER_SIZE];
+volatile uint8_t sSimpleSerialTXBufferIn;  // Index of first free position in buffer, only set by thread
+volatile uint8_t sSimpleSerialTXBufferOut; // Index of next byte to send, only set by ISR
+uint8_t sSimpleSerialTXBufferHighWatermark; // Maximum number of bytes in buffer since last reset
+
+/*
+ * Sends the next byte of the buffer or disables the UDRE interrupt if buffer is empty.
+ * Called by ISR and by the blocking fallback, if interrupts are disabled.
+ */
+static inline void sendNextSimpleSerialTXBufferByte() {
+    uint8_t tOut = sSimpleSerialTXBufferOut;
+    if (tOut == sSimpleSerialTXBufferIn) {
+        SIMPLE_SERIAL_UCSRB &= ~(1 << SIMPLE_SERIAL_UDRIE); // buffer empty
+    } else {
+        SIMPLE_SERIAL_UDR = sSimpleSerialTXBuffer[tOut];
+        sSimpleSerialTXBufferOut = (tOut + 1) & SIMPLE_SERIAL_TX_BUFFER_MASK;
+    }
+}
+
+ISR(SIMPLE_SERIAL_UDRE_vect) {
+    sendNextSimpleSerialTXBufferByte();
+}
+
+/*
+ * Put byte into ring buffer and enable UDRE interrupt.
+ * If buffer is full, do a blocking wait for the ISR to send the next byte.
+ * If interrupts are disabled (e.g. if called from another ISR), we send the byte(s) manually.
+ */
+void putSimpleSerialTXBuffer(uint8_t aByte) {
+    uint8_t tIn = sSimpleSerialTXBufferIn;
+    uint8_t tNextIn = (tIn + 1) & SIMPLE_SERIAL_TX_BUFFER_MASK;
+    while (tNextIn == sSimpleSerialTXBufferOut) {
+        // buffer full -> blocking fallback
+        if (!(SREG & (1 << SREG_I)) && (SIMPLE_SERIAL_UCSRA & (1 << SIMPLE_SERIAL_UDRE))) {
+            sendNextSimpleSerialTXBufferByte();
+        }
+    }
+    sSimpleSerialTXBuffer[tIn] = aByte;
+    sSimpleSerialTXBufferIn = tNextIn;
+
+    uint8_t tBytesInBuffer = (tNextIn - sSimpleSerialTXBufferOut) & SIMPLE_SERIAL_TX_BUFFER_MASK;
+    if (sSimpleSerialTXBufferHighWatermark < tBytesInBuffer) {
+        sSimpleSerialTXBufferHighWatermark = tBytesInBuffer;
+    }
+    // If ISR has disabled the interrupt during this read-modify-write, it will be enabled again, which does no harm
+    SIMPLE_SERIAL_UCSRB |= (1 << SIMPLE_SERIAL_UDRIE);
+}
+
+/*
+ * Blocking wait until all bytes of the buffer are sent, e.g. before changing baud rate or going to sleep
+ */
+void flushSimpleSerialTXBuffer() {
+    while (sSimpleSerialTXBufferOut != sSimpleSerialTXBufferIn) {
+        if (!(SREG & (1 << SREG_I)) && (SIMPLE_SERIAL_UCSRA & (1 << SIMPLE_SERIAL_UDRE))) {
+            sendNextSimpleSerialTXBufferByte();
+        }
+    }
+}
+
+uint8_t getSimpleSerialTXBufferFreeSpace() {
+    return (sSimpleSerialTXBufferOut - sSimpleSerialTXBufferIn - 1) & SIMPLE_SERIAL_TX_BUFFER_MASK;
+}
+
+/*
+ * Use it to check if buffer size is sufficient for your application.
+ * A value of BD_SIMPLE_SERIAL_TX_BUFFER_SIZE - 1 indicates, that the blocking fallback was (most likely) used.
+ */
+uint8_t getSimpleSerialTXBufferHighWatermark() {
+    return sSimpleSerialTXBufferHighWatermark;
+}
+
+void resetSimpleSerialTXBufferHighWatermark() {
+    sSimpleSerialTXBufferHighWatermark = 0;
+}
+#endif // defined(BD_USE_SIMPLE_SERIAL) && defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER) && defined(__AVR__)
+
 /**
  * The central point for sending bytes
  */
 void sendUSARTBufferNoSizeCheck(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
         size_t aDataBufferLength) {
+    ADD_TO_BD_BYTES_SENT(aParameterBufferLength + aDataBufferLength);
+    RECORD_TO_RETAINED_DISPLAY_LIST(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
 #if !defined(BD_USE_SIMPLE_SERIAL) || (!defined(UCSR1A) && !defined(UCSR0A))
     BDSerial.write(aParameterBufferPointer, aParameterBufferLength);
     BDSerial.write(aDataBufferPointer, aDataBufferLength);
+#elif defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER) && defined(__AVR__)
+    /*
+     * Interrupt driven version, returns immediately if buffer has enough space
+     */
+    while (aParameterBufferLength > 0) {
+        putSimpleSerialTXBuffer(*aParameterBufferPointer++);
+        aParameterBufferLength--;
+    }
+    while (aDataBufferLength > 0) {
+        putSimpleSerialTXBuffer(*aDataBufferPointer++);
+        aDataBufferLength--;
+    }
 #else
     /*
      * Simple and reliable blocking version for Atmega328
@@ -414,6 +539,18 @@ void sendUSARTBufferNoSizeCheck(uint8_t *aParameterBufferPointer, uint8_t aParam
 #endif // BD_USE_SIMPLE_SERIAL
 }
 
+/**
+ * Zero-copy sending is only implemented for the STM32 DMA transmit.
+ * Here the data buffer is already sent or copied to the serial buffer when the callback is called.
+ */
+void sendUSARTBufferZeroCopy(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
+        size_t aDataBufferLength, void (*aCompletionCallback)(uint8_t *aDataBufferPointer)) {
+    sendUSARTBufferNoSizeCheck(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
+    if (aCompletionCallback != nullptr) {
+        aCompletionCallback(aDataBufferPointer);
+    }
+}
+
 #endif // defined(ARDUINO)
 
 #if defined(__AVR__)
@@ -428,7 +565,9 @@ void sendUSARTBufferNoSizeCheck(uint8_t *aParameterBufferPointer, uint8_t aParam
  * Only defined for BD_USE_SIMPLE_SERIAL
  */
 void sendUSART(char aChar) {
-#if defined(BD_USE_SIMPLE_SERIAL)
+#if defined(BD_USE_SIMPLE_SERIAL) && defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER)
+    putSimpleSerialTXBuffer(aChar); // keep the order of bytes already in buffer
+#elif defined(BD_USE_SIMPLE_SERIAL)
     // wait for buffer to become empty
 #  if defined(UCSR1A)
     // Use TX1 on MEGA and on Leonardo, which has no TX0
@@ -471,6 +610,9 @@ void initSimpleSerial(uint32_t aBaudRate, bool aUsePairedPin) {
 
 void initSimpleSerial(uint32_t aBaudRate) {
     uint16_t baud_setting;
+#  if defined(BD_USE_SIMPLE_SERIAL_TX_BUFFER)
+    flushSimpleSerialTXBuffer(); // Do not send remaining bytes with the new baud rate
+#  endif
 #  if defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1284__) || defined(__AVR_ATmega1284P__) || defined(__AVR_ATmega644__) || defined(__AVR_ATmega644A__) || defined(__AVR_ATmega644P__) || defined(__AVR_ATmega644PA__) || defined(ARDUINO_AVR_LEONARDO) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__)
     // Use TX1 on MEGA and on Leonardo, which has no TX0
     UCSR1A = 1 << U2X1;// Double Speed Mode
@@ -596,11 +738,15 @@ UART_HandleTypeDef UART_BD_Handle;
  * Buffer overrun is detected by using a Buffer size of (n*6)-1 so the sync token
  * in case of overrun is on another position than the one expected.
  *
- * UART sending is done by writing data to a circular send buffer and then starting the DMA for this data.
- * During transmission further data can be written into the buffer until it is full.
+ * UART sending is done by a queue of send descriptors. Each descriptor describes one DMA transfer.
+ * Parameters and small data are copied to a circular send buffer and a descriptor for this chunk is appended to the queue.
+ * If the last descriptor is not yet started and the new chunk directly follows it in the send buffer, the descriptor is just extended.
+ * Large data buffers can be sent by sendUSARTBufferZeroCopy(), which appends a descriptor referencing the data buffer itself.
+ * During transmission further data can be written into the buffer until it or the descriptor queue is full.
  * The next write then waits for the ongoing transmission(s) to end (blocking wait) until enough free space is available.
- * If an transmission ends, the buffer space used for this transmission gets available for next send data.
- * If there is more data in the buffer to send, then the next DMA transfer for the remaining data is started immediately.
+ * If an transmission ends, the buffer space used for this transmission gets available for next send data
+ * or the completion callback of a zero-copy data buffer is called.
+ * If there are more descriptors in the queue, then the DMA transfer for the next one is started immediately.
  */
 
 /*
@@ -609,11 +755,25 @@ UART_HandleTypeDef UART_BD_Handle;
 // send buffer
 #define UART_SEND_BUFFER_SIZE 1024
 uint8_t *sUSARTSendBufferPointerIn; // only set by thread - point to first byte of free buffer space
-volatile uint8_t *sUSARTSendBufferPointerOut; // only set by ISR - point to first byte not yet transfered
+volatile uint16_t sUSARTSendBufferBytesUsed; // Bytes in send buffer not yet transferred - incremented by thread, decremented by ISR
 uint8_t USARTSendBuffer[UART_SEND_BUFFER_SIZE] __attribute__ ((aligned(4)));
-uint8_t *sUSARTSendBufferPointerOutTmp; // value of sUSARTSendBufferPointerOut after transfer complete
 volatile bool sDMATransferOngoing = false;  // synchronizing flag for ISR <-> thread
 
+// send descriptor queue
+#define UART_SEND_DESCRIPTOR_QUEUE_SIZE     16 // Must be a power of 2
+#define UART_SEND_DESCRIPTOR_QUEUE_MASK     (UART_SEND_DESCRIPTOR_QUEUE_SIZE - 1)
+#define UART_SEND_DESCRIPTORS_PER_SEND      3 // 2 for a chunk with buffer wrap around and 1 for a zero-copy data buffer
+#define UART_DMA_MAX_TRANSFER_SIZE          0xFFFF // CNDTR has 16 bit
+struct USARTSendDescriptor {
+    uint8_t *BufferPointer;
+    uint16_t Length;
+    bool IsInSendBuffer; // true -> chunk of USARTSendBuffer, false -> zero-copy data buffer
+    void (*CompletionCallback)(uint8_t *aDataBufferPointer); // Only for zero-copy data buffer, called by ISR
+};
+USARTSendDescriptor sUSARTSendDescriptorQueue[UART_SEND_DESCRIPTOR_QUEUE_SIZE];
+uint8_t sUSARTSendDescriptorIn; // only set by thread - index of first free descriptor
+volatile uint8_t sUSARTSendDescriptorOut; // only set by ISR - index of descriptor currently transferred
+
 // Circular receive buffer
 #define USART_RECEIVE_BUFFER_SIZE (TOUCH_COMMAND_MAX_DATA_SIZE * 10 -1) // not a multiple of TOUCH_COMMAND_SIZE_BYTE in order to discover overruns
 uint8_t USARTReceiveBuffer[USART_RECEIVE_BUFFER_SIZE] __attribute__ ((aligned(4)));
@@ -666,7 +826,9 @@ void HAL_UART_MspInit(UART_HandleTypeDef *aUARTHandle) {
          * init TX channel and buffer pointer
          */
         sUSARTSendBufferPointerIn = &USARTSendBuffer[0];
-        sUSARTSendBufferPointerOut = &USARTSendBuffer[0];
+        sUSARTSendBufferBytesUsed = 0;
+        sUSARTSendDescriptorIn = 0;
+        sUSARTSendDescriptorOut = 0;
         DMA_UART_BD_TXHandle.Init.Direction = DMA_MEMORY_TO_PERIPH;
         DMA_UART_BD_TXHandle.Init.PeriphInc = DMA_PINC_DISABLE;
         DMA_UART_BD_TXHandle.Init.MemInc = DMA_MINC_ENABLE;
@@ -787,14 +949,6 @@ void UART_BD_DMA_TX_start(uint32_t aMemoryBaseAddr, uint32_t aBufferSize) {
 
     sDMATransferOngoing = true;
 
-    // Compute next buffer out pointer
-    uint8_t *tUSARTSendBufferPointerOutTmp = (uint8_t*) (aMemoryBaseAddr + aBufferSize);
-    // check for buffer wrap around
-    if (tUSARTSendBufferPointerOutTmp >= &USARTSendBuffer[UART_SEND_BUFFER_SIZE]) {
-        tUSARTSendBufferPointerOutTmp = &USARTSendBuffer[0];
-    }
-    sUSARTSendBufferPointerOutTmp = tUSARTSendBufferPointerOutTmp;
-
     if (aBufferSize == 1) {
         // no DMA needed just put data to TDR register
 #ifdef STM32F30X
@@ -833,10 +987,21 @@ extern "C" void UART_BD_IRQHANDLER(void) {
     //if (USART_GetITStatus(UART_BD_Handle.Instance, USART_IT_TC) != RESET) {
     if (__HAL_UART_GET_FLAG(&UART_BD_Handle, UART_FLAG_TC) != RESET) {
 
-        sUSARTSendBufferPointerOut = sUSARTSendBufferPointerOutTmp;
-        sDMATransferOngoing = false;
-        if (sUSARTSendBufferPointerOut == sUSARTSendBufferPointerIn) {
-            // transfer complete and no new data arrived in buffer
+        uint8_t tDescriptorOut = sUSARTSendDescriptorOut;
+        if (sDMATransferOngoing) {
+            // release the descriptor of the completed transfer
+            USARTSendDescriptor *tDescriptor = &sUSARTSendDescriptorQueue[tDescriptorOut];
+            if (tDescriptor->IsInSendBuffer) {
+                sUSARTSendBufferBytesUsed -= tDescriptor->Length;
+            } else if (tDescriptor->CompletionCallback != nullptr) {
+                tDescriptor->CompletionCallback(tDescriptor->BufferPointer);
+            }
+            tDescriptorOut = (tDescriptorOut + 1) & UART_SEND_DESCRIPTOR_QUEUE_MASK;
+            sUSARTSendDescriptorOut = tDescriptorOut;
+            sDMATransferOngoing = false;
+        }
+        if (tDescriptorOut == sUSARTSendDescriptorIn) {
+            // transfer complete and no new descriptor arrived in queue
             /*
              * !! USART_ClearFlag(UART_BD_Handle.Instance, USART_FLAG_TC) has no effect on the TC Flag !!!! => next interrupt will happen after return from ISR
              * Must disable interrupt here otherwise it will interrupt forever (STM bug???)
@@ -845,16 +1010,9 @@ extern "C" void UART_BD_IRQHANDLER(void) {
             //USART_ITConfig(UART_BD_Handle.Instance, USART_IT_TC, DISABLE);
             //USART_ClearFlag(UART_BD_Handle.Instance, USART_FLAG_TC );
         } else {
-            uint8_t *tUSARTSendBufferPointerIn = sUSARTSendBufferPointerIn;
-            if (sUSARTSendBufferPointerOut < tUSARTSendBufferPointerIn) {
-                // new data in buffer -> start new transfer
-                UART_BD_DMA_TX_start((uint32_t) sUSARTSendBufferPointerOut,
-                        (uint32_t) (tUSARTSendBufferPointerIn - sUSARTSendBufferPointerOut));
-            } else {
-                // new data, but buffer wrap around occurred - send tail of buffer
-                UART_BD_DMA_TX_start((uint32_t) sUSARTSendBufferPointerOut,
-                        &USARTSendBuffer[UART_SEND_BUFFER_SIZE] - sUSARTSendBufferPointerOut);
-            }
+            // new descriptor in queue -> start new transfer
+            UART_BD_DMA_TX_start((uint32_t) sUSARTSendDescriptorQueue[tDescriptorOut].BufferPointer,
+                    sUSARTSendDescriptorQueue[tDescriptorOut].Length);
         }
     }
 }
@@ -862,145 +1020,219 @@ extern "C" void UART_BD_IRQHANDLER(void) {
 /*
  * Buffer handling
  */
+int getSendBufferFreeSpace(void) {
+    return UART_SEND_BUFFER_SIZE - sUSARTSendBufferBytesUsed;
+}
+
+static uint8_t getSendDescriptorFreeCount(void) {
+    return (sUSARTSendDescriptorOut - sUSARTSendDescriptorIn - 1) & UART_SEND_DESCRIPTOR_QUEUE_MASK;
+}
+
+/**
+ * Append a descriptor to the queue and start DMA if not already running.
+ * A chunk of the send buffer, which directly follows the last not yet started descriptor, is merged with this descriptor.
+ * Assert that at least one descriptor is free.
+ */
+static void enqueueSendDescriptor(uint8_t *aBufferPointer, uint16_t aLength, bool aIsInSendBuffer,
+        void (*aCompletionCallback)(uint8_t *aDataBufferPointer)) {
+    uint32_t tPRIMASK = __get_PRIMASK();
+    __disable_irq();
+    uint8_t tDescriptorIn = sUSARTSendDescriptorIn;
+    if (aIsInSendBuffer) {
+        sUSARTSendBufferBytesUsed += aLength;
+        uint8_t tLastDescriptorIndex = (tDescriptorIn - 1) & UART_SEND_DESCRIPTOR_QUEUE_MASK;
+        USARTSendDescriptor *tLastDescriptor = &sUSARTSendDescriptorQueue[tLastDescriptorIndex];
+        if (tDescriptorIn != sUSARTSendDescriptorOut && tLastDescriptorIndex != sUSARTSendDescriptorOut
+                && tLastDescriptor->IsInSendBuffer && tLastDescriptor->BufferPointer + tLastDescriptor->Length == aBufferPointer) {
+            // last descriptor is not yet started, just extend it
+            tLastDescriptor->Length += aLength;
+            __set_PRIMASK(tPRIMASK);
+            return;
+        }
+    }
+    USARTSendDescriptor *tDescriptor = &sUSARTSendDescriptorQueue[tDescriptorIn];
+    tDescriptor->BufferPointer = aBufferPointer;
+    tDescriptor->Length = aLength;
+    tDescriptor->IsInSendBuffer = aIsInSendBuffer;
+    tDescriptor->CompletionCallback = aCompletionCallback;
+    sUSARTSendDescriptorIn = (tDescriptorIn + 1) & UART_SEND_DESCRIPTOR_QUEUE_MASK;
+
+// start DMA if not already running
+    if (!sDMATransferOngoing) {
+        UART_BD_DMA_TX_start((uint32_t) aBufferPointer, aLength);
+    }
+    __set_PRIMASK(tPRIMASK);
+}
+
 /**
- * put data byte and check for wrap around
+ * Copy data to send buffer, check for buffer wrap around and enqueue descriptor(s) for the data.
+ * Assert that enough space is available in buffer.
  */
-uint8_t* putSendBuffer(uint8_t *aUSARTSendBufferPointerIn, uint8_t aData) {
-    *aUSARTSendBufferPointerIn++ = aData;
-    // check for buffer wrap around
-    if (aUSARTSendBufferPointerIn >= &USARTSendBuffer[UART_SEND_BUFFER_SIZE]) {
-        aUSARTSendBufferPointerIn = &USARTSendBuffer[0];
+static void putSendBufferAndEnqueue(uint8_t *aBufferPointer, size_t aLength) {
+    uint8_t *tUSARTSendBufferPointerIn = sUSARTSendBufferPointerIn;
+    size_t tBufferSizeToEndOfBuffer = &USARTSendBuffer[UART_SEND_BUFFER_SIZE] - tUSARTSendBufferPointerIn;
+    if (aLength >= tBufferSizeToEndOfBuffer) {
+        // transfer must be done in 2 chunks since DMA cannot handle buffer wrap around during a transfer
+        memcpy(tUSARTSendBufferPointerIn, aBufferPointer, tBufferSizeToEndOfBuffer);
+        enqueueSendDescriptor(tUSARTSendBufferPointerIn, tBufferSizeToEndOfBuffer, true, nullptr);
+        aBufferPointer += tBufferSizeToEndOfBuffer;
+        aLength -= tBufferSizeToEndOfBuffer;
+        tUSARTSendBufferPointerIn = &USARTSendBuffer[0];
+    }
+    if (aLength > 0) {
+        memcpy(tUSARTSendBufferPointerIn, aBufferPointer, aLength);
+        enqueueSendDescriptor(tUSARTSendBufferPointerIn, aLength, true, nullptr);
+        tUSARTSendBufferPointerIn += aLength;
     }
-    return aUSARTSendBufferPointerIn;
+// the only statement which writes the variable sUSARTSendBufferPointerIn
+    sUSARTSendBufferPointerIn = tUSARTSendBufferPointerIn;
 }
 
-int getSendBufferFreeSpace(void) {
-    if (sUSARTSendBufferPointerOut == sUSARTSendBufferPointerIn && !sDMATransferOngoing) {
-        // buffer empty
-        return UART_SEND_BUFFER_SIZE;
+/**
+ * Check (and wait) for aSize free bytes in send buffer and UART_SEND_DESCRIPTORS_PER_SEND free descriptors
+ * @return false if timeout happened
+ */
+static bool waitForSendBufferSpace(int aSize) {
+    if (!sDMATransferOngoing) {
+        // safe to reset buffer pointer since no transmit pending
+        sUSARTSendBufferPointerIn = &USARTSendBuffer[0];
+        return true;
     }
-    if (sUSARTSendBufferPointerOut < sUSARTSendBufferPointerIn) {
-        return (UART_SEND_BUFFER_SIZE - (sUSARTSendBufferPointerIn - sUSARTSendBufferPointerOut));
+    if (getSendBufferFreeSpace() >= aSize && getSendDescriptorFreeCount() >= UART_SEND_DESCRIPTORS_PER_SEND) {
+        return true;
     }
-    // buffer is completely filled up with data or buffer wrap around
-    return (sUSARTSendBufferPointerOut - sUSARTSendBufferPointerIn);
+    // not enough space left - wait for transfer (chain) to complete or for size
+    // get interrupt level
+    uint32_t tISPR = (__get_IPSR() & 0xFF);
+    setTimeoutMillis(300); // enough for 256 bytes at 9600
+    while (sDMATransferOngoing) {
+        // is needed here, because early watchdog ISR sends also data
+#ifdef HAL_WWDG_MODULE_ENABLED
+        Watchdog_reload();
+#endif
+        if (tISPR > 0) {
+            // here in ISR, check manually for TransferComplete interrupt flag
+            if (__HAL_UART_GET_FLAG(&UART_BD_Handle, UART_FLAG_TC) != RESET) {
+                // call ISR Handler manually
+                UART_BD_IRQHANDLER();
+            }
+        }
+
+        if (getSendBufferFreeSpace() >= aSize && getSendDescriptorFreeCount() >= UART_SEND_DESCRIPTORS_PER_SEND) {
+            return true;
+        }
+        if (isTimeoutSimple()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
- * Copy content of both buffers to send buffer, check for buffer wrap around and call USART_BD_DMA_TX_start() with right parameters.
+ * Copy content of both buffers to send buffer and start DMA for it.
  * Do blocking wait if not enough space left in buffer
  */
 void sendUSARTBufferNoSizeCheck(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
         size_t aDataBufferLength) {
+    ADD_TO_BD_BYTES_SENT(aParameterBufferLength + aDataBufferLength);
+    RECORD_TO_RETAINED_DISPLAY_LIST(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
 #if defined(BD_USE_SIMPLE_SERIAL)
     sendUSARTBufferSimple(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
     return;
 #else
-
-    if (!sDMATransferOngoing) {
-        // safe to reset buffer pointers since no transmit pending
-        sUSARTSendBufferPointerOut = &USARTSendBuffer[0];
-        sUSARTSendBufferPointerIn = &USARTSendBuffer[0];
+    if (!waitForSendBufferSpace(aParameterBufferLength + aDataBufferLength)) {
+        // skip transfer, don't overwrite
+        return;
     }
-    uint8_t *tUSARTSendBufferPointerIn = sUSARTSendBufferPointerIn;
-    int tSize = aParameterBufferLength + aDataBufferLength;
     /*
-     * check (and wait) for enough free space
+     * enough space here
      */
-    if (getSendBufferFreeSpace() < tSize) {
-        // not enough space left - wait for transfer (chain) to complete or for size
-        // get interrupt level
-        uint32_t tISPR = (__get_IPSR() & 0xFF);
-        setTimeoutMillis(300); // enough for 256 bytes at 9600
-        while (sDMATransferOngoing) {
-            // is needed here, because early watchdog ISR sends also data
-#ifdef HAL_WWDG_MODULE_ENABLED
-            Watchdog_reload();
+    putSendBufferAndEnqueue(aParameterBufferPointer, aParameterBufferLength);
+    if (aDataBufferLength > 0) {
+        putSendBufferAndEnqueue(aDataBufferPointer, aDataBufferLength);
+    }
 #endif
-            if (tISPR > 0) {
-                // here in ISR, check manually for TransferComplete interrupt flag
-                if (__HAL_UART_GET_FLAG(&UART_BD_Handle, UART_FLAG_TC) != RESET) {
-                    // call ISR Handler manually
-                    UART_BD_IRQHANDLER();
-                    // Assertion
-                    assert_param(__HAL_UART_GET_FLAG(&UART_BD_Handle, UART_FLAG_TC) == RESET);
-                }
-            }
+}
 
-            if (getSendBufferFreeSpace() >= tSize) {
-                break;
+/**
+ * Copy only parameter buffer to send buffer and send data buffer directly by DMA without copying it.
+ * The data buffer must not be changed until aCompletionCallback is called, and must be DMA accessible (e.g. not in CCM RAM).
+ * @param aCompletionCallback - Called (mostly by ISR) after the last byte of the data buffer is sent or transfer was skipped.
+ *                              Can be nullptr.
+ */
+void sendUSARTBufferZeroCopy(uint8_t *aParameterBufferPointer, uint8_t aParameterBufferLength, uint8_t *aDataBufferPointer,
+        size_t aDataBufferLength, void (*aCompletionCallback)(uint8_t *aDataBufferPointer)) {
+    ADD_TO_BD_BYTES_SENT(aParameterBufferLength + aDataBufferLength);
+    RECORD_TO_RETAINED_DISPLAY_LIST(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
+#if defined(BD_USE_SIMPLE_SERIAL)
+    sendUSARTBufferSimple(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
+#else
+    if (waitForSendBufferSpace(aParameterBufferLength)) {
+        putSendBufferAndEnqueue(aParameterBufferPointer, aParameterBufferLength);
+        uint8_t *tDataBufferPointer = aDataBufferPointer;
+        while (aDataBufferLength > 0) {
+            uint16_t tChunkLength = UART_DMA_MAX_TRANSFER_SIZE;
+            if (aDataBufferLength <= UART_DMA_MAX_TRANSFER_SIZE) {
+                tChunkLength = aDataBufferLength;
             }
-            if (isTimeoutSimple()) {
-                // skip transfer, don't overwrite
-                return;
+            aDataBufferLength -= tChunkLength;
+            /*
+             * A descriptor for this chunk is always free here. Wait for descriptors for the next chunk before enqueuing this one,
+             * so that on timeout this chunk becomes the last one and gets the callback.
+             */
+            if (aDataBufferLength > 0 && !waitForSendBufferSpace(0)) {
+                aDataBufferLength = 0; // skip the rest
             }
+            // callback only for last enqueued chunk
+            enqueueSendDescriptor(tDataBufferPointer, tChunkLength, false, (aDataBufferLength == 0) ? aCompletionCallback : nullptr);
+            tDataBufferPointer += tChunkLength;
         }
-    }
-
-    /*
-     * enough space here
-     */
-    uint8_t *tStartBufferPointer = tUSARTSendBufferPointerIn;
-
-    int tBufferSizeToEndOfBuffer = (&USARTSendBuffer[UART_SEND_BUFFER_SIZE] - tUSARTSendBufferPointerIn);
-    if (tBufferSizeToEndOfBuffer < tSize) {
-        //transfer possible, but must be done in 2 chunks since DMA cannot handle buffer wrap around during a transfer
-        tSize = tBufferSizeToEndOfBuffer; // set size for 1. chunk
-        // copy parameter the hard way
-        while (aParameterBufferLength > 0) {
-            tUSARTSendBufferPointerIn = putSendBuffer(tUSARTSendBufferPointerIn, *aParameterBufferPointer++);
-            aParameterBufferLength--;
-        }
-        //copy data
-        while (aDataBufferLength > 0) {
-            tUSARTSendBufferPointerIn = putSendBuffer(tUSARTSendBufferPointerIn, *aDataBufferPointer++);
-            aDataBufferLength--;
-        }
-    } else {
-        // copy parameter and data with memcpy
-        memcpy((uint8_t*) tUSARTSendBufferPointerIn, aParameterBufferPointer, aParameterBufferLength);
-        tUSARTSendBufferPointerIn += aParameterBufferLength;
-
-        if (aDataBufferLength > 0) {
-            memcpy((uint8_t*) tUSARTSendBufferPointerIn, aDataBufferPointer, aDataBufferLength);
-            tUSARTSendBufferPointerIn += aDataBufferLength;
-        }
-        // check for buffer wrap around - happens if tBufferSizeToEndOfBuffer == tSize
-        if (tUSARTSendBufferPointerIn >= &USARTSendBuffer[UART_SEND_BUFFER_SIZE]) {
-            tUSARTSendBufferPointerIn = &USARTSendBuffer[0];
+        if (tDataBufferPointer != aDataBufferPointer) {
+            return; // callback is called by ISR
         }
     }
-// the only statement which writes the variable sUSARTSendBufferPointerIn
-    sUSARTSendBufferPointerIn = tUSARTSendBufferPointerIn;
-
-// start DMA if not already running
-    UART_BD_DMA_TX_start((uint32_t) tStartBufferPointer, tSize);
 #endif
+    // Buffer is not referenced by any descriptor
+    if (aCompletionCallback != nullptr) {
+        aCompletionCallback(aDataBufferPointer);
+    }
 }
 
 #include <stdlib.h> // for abs()
+
+static volatile bool sBlockingZeroCopyTransferComplete;
+static void setBlockingZeroCopyTransferComplete(uint8_t *aDataBufferPointer) {
+    (void) aDataBufferPointer;
+    sBlockingZeroCopyTransferComplete = true;
+}
+
 /**
  * used if databuffer can be greater than USART_SEND_BUFFER_SIZE
  */
 void sendUSARTBuffer(uint8_t *aParameterBufferPointer, size_t aParameterBufferLength, uint8_t *aDataBufferPointer,
         size_t aDataBufferLength) {
 #if defined(BD_USE_SIMPLE_SERIAL)
+    ADD_TO_BD_BYTES_SENT(aParameterBufferLength + aDataBufferLength);
     sendUSARTBufferSimple(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
     return;
 #else
     if ((aParameterBufferLength + aDataBufferLength) > UART_SEND_BUFFER_SIZE) {
-        // first send command
-        sendUSARTBufferNoSizeCheck(aParameterBufferPointer, aParameterBufferLength, nullptr, 0);
-        // then send data in USART_SEND_BUFFER_SIZE chunks
-        int tSize = aDataBufferLength;
-        while (tSize > 0) {
-            int tSendSize = UART_SEND_BUFFER_SIZE;
-            if (tSize < UART_SEND_BUFFER_SIZE) {
-                tSendSize = tSize;
+        /*
+         * Send data by DMA directly from the data buffer instead of copying it in chunks to the send buffer.
+         * Wait for the end of the transfer, since the caller may change the data after return.
+         */
+        sBlockingZeroCopyTransferComplete = false;
+        sendUSARTBufferZeroCopy(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength,
+                &setBlockingZeroCopyTransferComplete);
+        uint32_t tISPR = (__get_IPSR() & 0xFF);
+        while (!sBlockingZeroCopyTransferComplete) {
+#ifdef HAL_WWDG_MODULE_ENABLED
+            Watchdog_reload();
+#endif
+            // here in ISR, check manually for TransferComplete interrupt flag and call ISR Handler manually
+            if (tISPR > 0 && __HAL_UART_GET_FLAG(&UART_BD_Handle, UART_FLAG_TC) != RESET) {
+                UART_BD_IRQHANDLER();
             }
-            sendUSARTBufferNoSizeCheck(aDataBufferPointer, tSendSize, nullptr, 0);
-            aDataBufferPointer += UART_SEND_BUFFER_SIZE;
-            tSize -= UART_SEND_BUFFER_SIZE;
         }
     } else {
         sendUSARTBufferNoSizeCheck(aParameterBufferPointer, aParameterBufferLength, aDataBufferPointer, aDataBufferLength);
@@ -263,6 +263,7 @@ public:
 #define CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_2    -2 // compression by factor 2
 #define CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_3    -3 // compression by factor 3
 #define CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_4    -4 // compression by factor 4
+#define CHART_X_AXIS_SCALE_FACTOR_COMPRESSION_8    -8 // compression by factor 8
     /**
      * Factor > 1 : expansion by factor Factor. E.g. one value is rendered twice, label increment value is halve
      * Factor == 1 : expansion by 1.5
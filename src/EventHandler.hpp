@@ -371,6 +371,12 @@ void checkAndHandleEvents() {
     }
 #  endif
 #endif
+#if defined(BD_USE_ASYNC_REQUESTS)
+    checkBDAsyncRequestTimeouts();
+#endif
+#if defined(BD_USE_TASK_SCHEDULER)
+    runNextDueTask(); // after event handling, to give events priority
+#endif
 }
 
 /**
@@ -583,6 +589,9 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
         if (sSpeakingDoneCallback != nullptr) {
             sSpeakingDoneCallback(tEvent.EventData.UnsignedShortArray[0]);
         }
+#  if defined(BD_USE_ASYNC_REQUESTS)
+        handleBDAsyncSpeakingDone(tEvent.EventData.UnsignedShortArray[0]);
+#  endif
         break;
 #endif
 
@@ -593,6 +602,11 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
          * Got max display size for new orientation and local timestamp
          */
         copyDisplaySizeAndTimestampAndSetOrientation(&tEvent); // must be done before call of callback functions
+#if defined(BD_USE_ASYNC_REQUESTS)
+        if (tEventType == EVENT_REQUESTED_DATA_CANVAS_SIZE) {
+            handleBDAsyncCanvasSizeResponse();
+        }
+#endif
 
         if (!BlueDisplay1.mBlueDisplayConnectionEstablished) {
             // if this is the first event, which sets mBlueDisplayConnectionEstablished to true, call connection callback too
@@ -608,6 +622,10 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
 
 #if !defined(ONLY_CONNECT_EVENT_REQUIRED)
         if (tEventType == EVENT_REORIENTATION) {
+#  if defined(BD_USE_RETAINED_DISPLAY_LIST)
+            // The static content was drawn for the old layout, so the reorientation or redraw callback must record it again
+            clearRetainedDisplayList(BD_RETAINED_LAYER_ALL);
+#  endif
             if (sReorientationCallback != nullptr) {
                 sReorientationCallback();
             }
@@ -668,6 +686,9 @@ extern "C" void handleEvent(struct BluetoothEvent *aEvent) {
          * sets mCurrentDisplaySize and mHostUnixTimestamp
          */
         copyDisplaySizeAndTimestampAndSetOrientation(&tEvent);
+#  if defined(BD_USE_RETAINED_DISPLAY_LIST)
+        replayRetainedDisplayList(); // Static content, the redraw callback then draws only the dynamic content
+#  endif
         if (sRedrawCallback != nullptr) {
             sRedrawCallback();
         }